@@ -285,6 +285,7 @@ main() {
     () => ParseBigIntBenchmark('BigInt.parse.0256.bits', 256),
     () => ParseBigIntBenchmark('BigInt.parse.1024.bits', 1024),
     () => ParseBigIntBenchmark('BigInt.parse.4096.bits', 4096),
+    () => ParseBigIntBenchmark('BigInt.parse.16384.bits', 16384),
     selectParseNativeBigIntBenchmark('JsBigInt.parse.0009.bits', 9),
     selectParseNativeBigIntBenchmark('JsBigInt.parse.0032.bits', 32),
     selectParseNativeBigIntBenchmark('JsBigInt.parse.0064.bits', 64),
@@ -300,6 +301,7 @@ main() {
     () => FormatBigIntBenchmark('BigInt.toString.0256.bits', 256),
     () => FormatBigIntBenchmark('BigInt.toString.1024.bits', 1024),
     () => FormatBigIntBenchmark('BigInt.toString.4096.bits', 4096),
+    () => FormatBigIntBenchmark('BigInt.toString.16384.bits', 16384),
     selectFormatNativeBigIntBenchmark('JsBigInt.toString.0009.bits', 9),
     selectFormatNativeBigIntBenchmark('JsBigInt.toString.0032.bits', 32),
     selectFormatNativeBigIntBenchmark('JsBigInt.toString.0064.bits', 64),
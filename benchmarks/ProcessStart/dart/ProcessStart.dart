@@ -0,0 +1,68 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Measures the latency of Process.start with different amounts of memory
+// in use by the parent process. The latency should not depend on the size of
+// the parent heap.
+
+import 'dart:io';
+import 'dart:typed_data';
+
+// Sizes of the extra memory touched by the parent before measuring.
+const List<int> heapSizesInMB = [0, 256, 1024];
+
+class ProcessStartLatency {
+  ProcessStartLatency(this.name, this.heapSizeInMB);
+
+  Future<int> run() async {
+    final watch = Stopwatch()..start();
+    final process = await Process.start(executable, arguments);
+    final int startUs = watch.elapsedMicroseconds;
+    await process.stdout.drain();
+    await process.stderr.drain();
+    await process.exitCode;
+    return startUs;
+  }
+
+  Future<double> measureFor(int minimumMillis) async {
+    final minimumMicros = minimumMillis * 1000;
+    final watch = Stopwatch()..start();
+    int totalUs = 0;
+    int count = 0;
+    while (watch.elapsedMicroseconds < minimumMicros) {
+      totalUs += await run();
+      count++;
+    }
+    return totalUs / count;
+  }
+
+  Future<void> report() async {
+    // Keep the memory alive and resident while measuring.
+    final List<Uint8List> heap = allocate(heapSizeInMB);
+    await measureFor(500); // warm-up
+    final double latencyUs = await measureFor(4000);
+    print("$name.${heapSizeInMB}MB(RunTime): $latencyUs us.");
+    if (heap.length != heapSizeInMB) throw "Unexpected heap size";
+  }
+
+  static List<Uint8List> allocate(int sizeInMB) {
+    final heap = <Uint8List>[];
+    for (int i = 0; i < sizeInMB; i++) {
+      heap.add(Uint8List(1024 * 1024)..fillRange(0, 1024 * 1024, i & 0xff));
+    }
+    return heap;
+  }
+
+  String get executable => Platform.isWindows ? 'cmd.exe' : 'true';
+  List<String> get arguments => Platform.isWindows ? ['/c', 'exit'] : [];
+
+  final String name;
+  final int heapSizeInMB;
+}
+
+Future<void> main() async {
+  for (final int size in heapSizesInMB) {
+    await ProcessStartLatency("ProcessStart", size).report();
+  }
+}
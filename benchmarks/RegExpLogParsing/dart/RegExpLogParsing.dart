@@ -0,0 +1,130 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+// Micro-benchmarks for regular expressions that parse lines of a log.
+
+// A global sink that is used in the [check] method ensures that the results are
+// not optimized.
+dynamic sink;
+
+void check(Object expected) {
+  if (sink != expected) {
+    throw StateError('Expected $expected, not $sink');
+  }
+}
+
+const lineCount = 200;
+const levels = ['INFO', 'WARNING', 'ERROR'];
+
+String makeLine(int i) {
+  final minute = (i ~/ 60).toString().padLeft(2, '0');
+  final second = (i % 60).toString().padLeft(2, '0');
+  final level = levels[i % levels.length];
+  return '2019-11-05 12:$minute:$second.${i % 1000} $level [worker-${i % 7}] '
+      'Request ${i * 7919} from 10.0.${i % 256}.${(i * 13) % 256} took '
+      '${i % 97}ms for user user$i@example.com';
+}
+
+class RegExpBenchmark extends BenchmarkBase {
+  final RegExp pattern;
+  final int expected;
+  final List<String> lines = [];
+
+  RegExpBenchmark(String name, String source, this.expected)
+      : pattern = RegExp(source),
+        super(name);
+
+  void setup() {
+    for (int i = 0; i < lineCount; i++) {
+      lines.add(makeLine(i));
+    }
+  }
+
+  void run() {
+    int found = 0;
+    for (final line in lines) {
+      if (pattern.firstMatch(line) != null) found++;
+    }
+    sink = found;
+    check(expected);
+  }
+}
+
+// Lines made of words that almost, but not quite, match a pattern that
+// backtracks a lot.
+class BacktrackingBenchmark extends BenchmarkBase {
+  final RegExp pattern = RegExp(r'^(\w+\s?)+$');
+  final List<String> lines = [];
+
+  BacktrackingBenchmark() : super('RegExp.backtracking');
+
+  void setup() {
+    for (int i = 0; i < 10; i++) {
+      lines.add('word ' * (2 + i % 3) + 'end!');
+    }
+  }
+
+  void run() {
+    int found = 0;
+    for (final line in lines) {
+      if (pattern.firstMatch(line) != null) found++;
+    }
+    sink = found;
+    check(0);
+  }
+}
+
+// Finds the few matches of a pattern in a long log, which is mostly spent
+// looking for where a match could start.
+class SparseMatchBenchmark extends BenchmarkBase {
+  final RegExp pattern;
+  final int expected;
+  String log;
+
+  SparseMatchBenchmark(String name, String source, this.expected,
+      {bool caseSensitive: true})
+      : pattern = RegExp(source, caseSensitive: caseSensitive),
+        super(name);
+
+  void setup() {
+    log = List.generate(lineCount * 10, makeLine).join('\n');
+  }
+
+  void run() {
+    sink = pattern.allMatches(log).length;
+    check(expected);
+  }
+}
+
+main() {
+  final benchmarks = [
+    () => RegExpBenchmark(
+        'RegExp.logLine',
+        r'^(\d{4})-(\d\d)-(\d\d) ([\d:.]+) (INFO|WARNING|ERROR) '
+            r'\[([\w-]+)\] (.*)$',
+        lineCount),
+    () => RegExpBenchmark(
+        'RegExp.ipAddress', r'\b(\d{1,3})\.(\d{1,3})\.(\d{1,3})\.(\d{1,3})\b',
+        lineCount),
+    () => RegExpBenchmark(
+        'RegExp.email', r'[\w.+-]+@[\w-]+\.[\w.]+', lineCount),
+    () => RegExpBenchmark(
+        'RegExp.errorDuration', r'ERROR .* took (\d+)ms', lineCount ~/ 3),
+    () => BacktrackingBenchmark(),
+    () => SparseMatchBenchmark('RegExp.sparseLiteral', r'user1999@', 1),
+    () => SparseMatchBenchmark('RegExp.sparseIgnoreCase', r'USER1999@', 1,
+        caseSensitive: false),
+    () => SparseMatchBenchmark('RegExp.sparseClass', r'[xz]\d', 0),
+  ];
+
+  // Warm up all benchmarks to ensure consistent behaviour of shared code.
+  benchmarks.forEach((bm) => bm()
+    ..setup()
+    ..run()
+    ..run());
+
+  benchmarks.forEach((bm) => bm().report());
+}
@@ -0,0 +1,149 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+// Micro-benchmarks for searching, comparing and splitting long strings.
+
+// A global sink that is used in the [check] method ensures that the results are
+// not optimized.
+dynamic sink;
+
+void check(Object expected) {
+  if (sink != expected) {
+    throw StateError('Expected $expected, not $sink');
+  }
+}
+
+// Lines of a log, which are searched for a word near their end.
+const lineCount = 100;
+const lineLength = 1000;
+
+String makeLine(int i, String filler) {
+  final line = StringBuffer();
+  while (line.length < lineLength - 20) {
+    line.write(filler);
+    line.write(' ');
+  }
+  line.write(i.isEven ? 'ERROR ' : 'WARNING ');
+  line.write(i);
+  return line.toString();
+}
+
+class IndexOfBenchmark extends BenchmarkBase {
+  final String filler;
+  final String pattern;
+  final List<String> lines = [];
+
+  IndexOfBenchmark(String name, this.filler, this.pattern) : super(name);
+
+  void setup() {
+    for (int i = 0; i < lineCount; i++) {
+      lines.add(makeLine(i, filler));
+    }
+  }
+
+  void run() {
+    int found = 0;
+    for (final line in lines) {
+      if (line.indexOf(pattern) >= 0) found++;
+    }
+    sink = found;
+    check(lineCount ~/ 2);
+  }
+}
+
+class ContainsCharBenchmark extends BenchmarkBase {
+  final List<String> lines = [];
+
+  ContainsCharBenchmark() : super('String.contains.char');
+
+  void setup() {
+    for (int i = 0; i < lineCount; i++) {
+      final line = makeLine(i, 'lorem ipsum dolor sit amet');
+      lines.add(i.isEven ? '$line!' : line);
+    }
+  }
+
+  void run() {
+    int found = 0;
+    for (final line in lines) {
+      if (line.contains('!')) found++;
+    }
+    sink = found;
+    check(lineCount ~/ 2);
+  }
+}
+
+class EqualityBenchmark extends BenchmarkBase {
+  final String filler;
+  final List<String> lines = [];
+  final List<String> copies = [];
+
+  EqualityBenchmark(String name, this.filler) : super(name);
+
+  void setup() {
+    for (int i = 0; i < lineCount; i++) {
+      lines.add(makeLine(i, filler));
+      // Equal, but not identical.
+      copies.add(String.fromCharCodes(lines.last.codeUnits));
+    }
+  }
+
+  void run() {
+    int equal = 0;
+    for (int i = 0; i < lineCount; i++) {
+      if (lines[i] == copies[i]) equal++;
+    }
+    sink = equal;
+    check(lineCount);
+  }
+}
+
+class SplitBenchmark extends BenchmarkBase {
+  final List<String> lines = [];
+  int expectedFields = 0;
+
+  SplitBenchmark() : super('String.split.char');
+
+  void setup() {
+    for (int i = 0; i < lineCount; i++) {
+      // Long fields, as in CSV files with free-form text.
+      lines.add(makeLine(i, 'lorem ipsum dolor sit amet consectetur,'));
+      expectedFields += ','.allMatches(lines.last).length + 1;
+    }
+  }
+
+  void run() {
+    int fields = 0;
+    for (final line in lines) {
+      fields += line.split(',').length;
+    }
+    sink = fields;
+    check(expectedFields);
+  }
+}
+
+main() {
+  final benchmarks = [
+    () => IndexOfBenchmark(
+        'String.indexOf.oneByte', 'lorem ipsum dolor sit amet', 'ERROR'),
+    () => IndexOfBenchmark(
+        'String.indexOf.twoByte', 'lörem ipsüm dolor sit ämet €', 'ERROR'),
+    () => ContainsCharBenchmark(),
+    () => EqualityBenchmark(
+        'String.equals.oneByte', 'lorem ipsum dolor sit amet'),
+    () => EqualityBenchmark(
+        'String.equals.twoByte', 'lörem ipsüm dolor sit ämet €'),
+    () => SplitBenchmark(),
+  ];
+
+  // Warm up all benchmarks to ensure consistent behaviour of shared code.
+  benchmarks.forEach((bm) => bm()
+    ..setup()
+    ..run()
+    ..run());
+
+  benchmarks.forEach((bm) => bm().report());
+}
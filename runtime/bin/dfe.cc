@@ -6,6 +6,11 @@
 
 #include <memory>
 
+#if !defined(HOST_OS_WINDOWS)
+#include <sys/stat.h>  // NOLINT
+#include <unistd.h>    // NOLINT
+#endif
+
 #include "bin/abi_version.h"
 #include "bin/dartutils.h"
 #include "bin/directory.h"
@@ -79,7 +84,8 @@ DFE::DFE()
       use_incremental_compiler_(false),
       frontend_filename_(nullptr),
       application_kernel_buffer_(nullptr),
-      application_kernel_buffer_size_(0) {
+      application_kernel_buffer_size_(0),
+      application_kernel_mapping_(nullptr) {
   // The run_vm_tests binary has the DART_PRECOMPILER set in order to allow unit
   // tests to exercise JIT and AOT pipeline.
   //
@@ -113,9 +119,14 @@ DFE::~DFE() {
   }
   frontend_filename_ = nullptr;
 
-  free(application_kernel_buffer_);
+  if (application_kernel_mapping_ != nullptr) {
+    delete application_kernel_mapping_;
+  } else {
+    free(application_kernel_buffer_);
+  }
   application_kernel_buffer_ = nullptr;
   application_kernel_buffer_size_ = 0;
+  application_kernel_mapping_ = nullptr;
 }
 
 void DFE::Init() {
@@ -312,13 +323,20 @@ void DFE::CompileAndReadScript(const char* script_uri,
 
 void DFE::ReadScript(const char* script_uri,
                      uint8_t** kernel_buffer,
-                     intptr_t* kernel_buffer_size) const {
+                     intptr_t* kernel_buffer_size,
+                     MappedMemory** mapping) const {
   int64_t start = Dart_TimelineGetMicros();
-  if (!TryReadKernelFile(script_uri, kernel_buffer, kernel_buffer_size)) {
+  if (!TryReadKernelFile(script_uri, kernel_buffer, kernel_buffer_size,
+                         mapping)) {
     return;
   }
   if (!Dart_IsKernel(*kernel_buffer, *kernel_buffer_size)) {
-    free(*kernel_buffer);
+    if ((mapping != nullptr) && (*mapping != nullptr)) {
+      delete *mapping;
+      *mapping = nullptr;
+    } else {
+      free(*kernel_buffer);
+    }
     *kernel_buffer = nullptr;
     *kernel_buffer_size = -1;
   }
@@ -369,6 +387,71 @@ static bool TryReadFile(const char* script_uri, uint8_t** buffer,
   return true;
 }
 
+/// Returns [true] if the current user may be able to rewrite [file] in place.
+/// Truncating a file that is mapped makes accesses to the lost pages crash
+/// with SIGBUS, where a copy read into memory is unaffected.
+static bool MayBeRewritten(File* file) {
+#if defined(HOST_OS_WINDOWS)
+  // File::Map reads a copy of the file on Windows.
+  return false;
+#else
+  struct stat st;
+  if (fstat(file->GetFD(), &st) != 0) {
+    return true;
+  }
+  const uid_t uid = geteuid();
+  if (uid == 0) {
+    return true;
+  }
+  if (st.st_uid == uid) {
+    return (st.st_mode & S_IWUSR) != 0;
+  }
+  // The user may be in the file's group through a supplementary group.
+  return (st.st_mode & (S_IWGRP | S_IWOTH)) != 0;
+#endif
+}
+
+/// Maps [script_uri] into memory if it is a single kernel file that the
+/// current user can not rewrite, returns [true] if successful, [false]
+/// otherwise.
+///
+/// Kernel files are only read through, so the pages are shared with the page
+/// cache and only the parts the VM touches are ever loaded from disk. Files
+/// the user can write, such as the output of a build that may be redone while
+/// the program runs, are read into memory instead.
+static bool TryMapKernelFile(const char* script_uri,
+                             uint8_t** buffer,
+                             intptr_t* size,
+                             MappedMemory** mapping) {
+  File* file = File::OpenUri(nullptr, script_uri, File::kRead);
+  if (file == nullptr) {
+    return false;
+  }
+  RefCntReleaseScope<File> rs(file);
+  if (MayBeRewritten(file)) {
+    return false;
+  }
+  int64_t length = file->Length();
+  if ((length <= 0) || (length > kIntptrMax)) {
+    return false;
+  }
+  MappedMemory* mapped = file->Map(File::kReadOnly, 0, length);
+  if (mapped == nullptr) {
+    return false;
+  }
+  uint8_t* address = reinterpret_cast<uint8_t*>(mapped->address());
+  if (DartUtils::SniffForMagicNumber(address, length) !=
+      DartUtils::kKernelMagicNumber) {
+    // Kernel lists and other files are read as before.
+    delete mapped;
+    return false;
+  }
+  *buffer = address;
+  *size = static_cast<intptr_t>(length);
+  *mapping = mapped;
+  return true;
+}
+
 class KernelIRNode {
  public:
   KernelIRNode(uint8_t* kernel_ir, intptr_t kernel_size)
@@ -504,9 +587,18 @@ static bool TryReadKernelListBuffer(const char* script_uri,
 
 bool DFE::TryReadKernelFile(const char* script_uri,
                             uint8_t** kernel_ir,
-                            intptr_t* kernel_ir_size) {
+                            intptr_t* kernel_ir_size,
+                            MappedMemory** mapping) {
   *kernel_ir = nullptr;
   *kernel_ir_size = -1;
+  if (mapping != nullptr) {
+    *mapping = nullptr;
+    if (TryMapKernelFile(script_uri, kernel_ir, kernel_ir_size, mapping)) {
+      return true;
+    }
+    *kernel_ir = nullptr;
+    *kernel_ir_size = -1;
+  }
 
   uint8_t* buffer;
   if (!TryReadFile(script_uri, &buffer, kernel_ir_size)) {
@@ -13,6 +13,8 @@
 namespace dart {
 namespace bin {
 
+class MappedMemory;
+
 class DFE {
  public:
   DFE();
@@ -45,10 +47,13 @@ class DFE {
   const char* GetPlatformBinaryFilename();
 
   // Set the kernel program for the main application if it was specified
-  // as a dill file.
-  void set_application_kernel_buffer(uint8_t* buffer, intptr_t size) {
+  // as a dill file. If [mapping] is not null, it owns [buffer].
+  void set_application_kernel_buffer(uint8_t* buffer,
+                                     intptr_t size,
+                                     MappedMemory* mapping = nullptr) {
     application_kernel_buffer_ = buffer;
     application_kernel_buffer_size_ = size;
+    application_kernel_mapping_ = mapping;
   }
   void application_kernel_buffer(const uint8_t** buffer, intptr_t* size) const {
     *buffer = application_kernel_buffer_;
@@ -75,9 +80,13 @@ class DFE {
   // Reads the script kernel file if specified 'script_uri' is a kernel file.
   // Returns an in memory kernel representation of the specified script is a
   // valid kernel file, false otherwise.
+  // If 'mapping' is not null, a single kernel file is memory mapped rather
+  // than read, and the returned mapping owns 'kernel_buffer'. It is null if
+  // the buffer was read, in which case the caller must free() it.
   void ReadScript(const char* script_uri,
                   uint8_t** kernel_buffer,
-                  intptr_t* kernel_buffer_size) const;
+                  intptr_t* kernel_buffer_size,
+                  MappedMemory** mapping = nullptr) const;
 
   bool KernelServiceDillAvailable() const;
 
@@ -85,10 +94,11 @@ class DFE {
   // Returns `true` if successful and sets [kernel_file] and [kernel_length]
   // to be the kernel IR contents.
   // The caller is responsible for free()ing [kernel_file] if `true`
-  // was returned.
+  // was returned, unless it was mapped into [mapping] (see [ReadScript]).
   static bool TryReadKernelFile(const char* script_uri,
                                 uint8_t** kernel_buffer,
-                                intptr_t* kernel_buffer_size);
+                                intptr_t* kernel_buffer_size,
+                                MappedMemory** mapping = nullptr);
 
   // We distinguish between "intent to use Dart frontend" vs "can actually
   // use Dart frontend". The method UseDartFrontend tells us about the
@@ -115,6 +125,7 @@ class DFE {
   // Kernel binary specified on the cmd line.
   uint8_t* application_kernel_buffer_;
   intptr_t application_kernel_buffer_size_;
+  MappedMemory* application_kernel_mapping_;
 
   bool InitKernelServiceAndPlatformDills(int target_abi_version);
 
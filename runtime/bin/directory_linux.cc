@@ -88,8 +88,8 @@ ListType DirectoryListingEntry::Next(DirectoryListing* listing) {
   if (fd_ == -1) {
     ASSERT(lister_ == 0);
     NamespaceScope ns(listing->namespc(), listing->path_buffer().AsString());
-    const int listingfd =
-        TEMP_FAILURE_RETRY(openat64(ns.fd(), ns.path(), O_DIRECTORY));
+    const int listingfd = TEMP_FAILURE_RETRY(
+        openat64(ns.fd(), ns.path(), O_DIRECTORY | O_CLOEXEC));
     if (listingfd < 0) {
       done_ = true;
       return kListError;
@@ -16,6 +16,7 @@
 #include "include/dart_api.h"
 #include "include/dart_tools_api.h"
 #include "platform/globals.h"
+#include "platform/utils.h"
 
 namespace dart {
 namespace bin {
@@ -500,6 +501,65 @@ void FUNCTION_NAME(File_Lock)(Dart_NativeArguments args) {
   Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
 }
 
+static void UnmapFinalizer(void* isolate_callback_data,
+                           Dart_WeakPersistentHandle handle,
+                           void* peer) {
+  delete reinterpret_cast<MappedMemory*>(peer);
+}
+
+// Mappings are made at offsets aligned to this, which is a multiple of the
+// page size and of the Windows allocation granularity.
+static const int64_t kFileMapAlignment = 64 * KB;
+
+void FUNCTION_NAME(File_Map)(Dart_NativeArguments args) {
+  File* file = GetFile(args);
+  ASSERT(file != NULL);
+  int64_t offset;
+  int64_t length;
+  int64_t advice;
+  // Offset and length are checked in Dart code to be within the file, and
+  // length to be positive.
+  if (DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 1), &offset) &&
+      DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 2), &length) &&
+      DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 3), &advice)) {
+    const int64_t map_offset = Utils::RoundDown(offset, kFileMapAlignment);
+    const int64_t delta = offset - map_offset;
+    if ((offset >= 0) && (length > 0) && (advice >= 0) &&
+        (advice <= MappedMemory::kAdviceMax) &&
+        (length <= kIntptrMax - delta)) {
+      // The mapping is private and writable, so writes through the typed
+      // data are copy-on-write and never reach the file.
+      MappedMemory* mapping =
+          file->Map(File::kReadWrite, map_offset, length + delta);
+      if (mapping == NULL) {
+        Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+        return;
+      }
+      mapping->Advise(static_cast<MappedMemory::Advice>(advice));
+      uint8_t* data = reinterpret_cast<uint8_t*>(mapping->address()) + delta;
+#if defined(HOST_OS_WINDOWS)
+      // The file contents are copied into memory.
+      const intptr_t external_size = mapping->size();
+#else
+      // The pages belong to the page cache, which the OS can reclaim, so
+      // they do not count towards the Dart heap's memory pressure.
+      const intptr_t external_size = sizeof(*mapping);
+#endif
+      Dart_Handle result = Dart_NewExternalTypedDataWithFinalizer(
+          Dart_TypedData_kUint8, data, length, mapping, external_size,
+          UnmapFinalizer);
+      if (Dart_IsError(result)) {
+        delete mapping;
+        Dart_PropagateError(result);
+      }
+      Dart_SetReturnValue(args, result);
+      return;
+    }
+  }
+  OSError os_error(-1, "Invalid argument", OSError::kUnknown);
+  Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+}
+
 void FUNCTION_NAME(File_Create)(Dart_NativeArguments args) {
   Namespace* namespc = Namespace::GetNamespace(args, 0);
   Dart_Handle path_handle = Dart_GetNativeArgument(args, 1);
@@ -34,6 +34,20 @@ class MappedMemory {
   intptr_t size() const { return size_; }
   uword start() const { return reinterpret_cast<uword>(address()); }
 
+  // These values must agree with those in sdk/lib/io/file.dart.
+  enum Advice {
+    kAdviceNormal = 0,
+    kAdviceSequential = 1,
+    kAdviceRandom = 2,
+    kAdviceWillNeed = 3,
+    kAdviceMax = 3
+  };
+
+  // Hints the expected access pattern of the mapping to the OS. This is a
+  // no-op on Fuchsia, which has no madvise, and on Windows, where the
+  // mapping is a copy of the file contents.
+  void Advise(Advice advice);
+
  private:
   void Unmap();
 
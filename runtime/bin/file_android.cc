@@ -109,6 +109,26 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+void MappedMemory::Advise(Advice advice) {
+  int posix_advice = MADV_NORMAL;
+  switch (advice) {
+    case kAdviceNormal:
+      posix_advice = MADV_NORMAL;
+      break;
+    case kAdviceSequential:
+      posix_advice = MADV_SEQUENTIAL;
+      break;
+    case kAdviceRandom:
+      posix_advice = MADV_RANDOM;
+      break;
+    case kAdviceWillNeed:
+      posix_advice = MADV_WILLNEED;
+      break;
+  }
+  // The advice is only a hint, so failures are ignored.
+  madvise(address_, size_, posix_advice);
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return TEMP_FAILURE_RETRY(read(handle_->fd(), buffer, num_bytes));
@@ -108,6 +108,12 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+void MappedMemory::Advise(Advice advice) {
+  // The mapping is made through fdio, which keeps no handle to the VMO
+  // backing it, and Fuchsia has no madvise. The advice is only a hint, so it
+  // is ignored.
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return NO_RETRY_EXPECTED(read(handle_->fd(), buffer, num_bytes));
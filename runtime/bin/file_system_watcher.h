@@ -26,7 +26,8 @@ class FileSystemWatcher {
     kMove = 1 << 3,
     kModefyAttribute = 1 << 4,
     kDeleteSelf = 1 << 5,
-    kIsDir = 1 << 6
+    kIsDir = 1 << 6,
+    kOverflow = 1 << 7
   };
 
   struct Event {
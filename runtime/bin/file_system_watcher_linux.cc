@@ -7,17 +7,530 @@
 
 #include "bin/file_system_watcher.h"
 
+#include <dirent.h>       // NOLINT
 #include <errno.h>        // NOLINT
 #include <sys/inotify.h>  // NOLINT
+#include <sys/stat.h>     // NOLINT
 
 #include "bin/fdutils.h"
 #include "bin/file.h"
+#include "bin/lockers.h"
 #include "bin/socket.h"
+#include "bin/thread.h"
+#include "platform/growable_array.h"
+#include "platform/hashmap.h"
 #include "platform/signal_blocker.h"
+#include "platform/utils.h"
 
 namespace dart {
 namespace bin {
 
+// Directories below a recursive watch are watched for every event, as they
+// must report new subdirectories regardless of the events asked for. Events
+// the user did not ask for are filtered out in Dart.
+static const uint32_t kRecursiveMask = IN_CREATE | IN_CLOSE_WRITE | IN_ATTRIB |
+                                       IN_DELETE | IN_MOVE | IN_DELETE_SELF |
+                                       IN_MOVE_SELF;
+
+// Reading stops after this many bytes so that a flood of events does not
+// stall the isolate. The rest is read when Dart asks again.
+static const intptr_t kReadBufferSize = 64 * KB;
+static const intptr_t kMaxReadBytes = 16 * kReadBufferSize;
+
+// Returns a malloc'ed |prefix|/|name|, or a copy of |name| if |prefix| is
+// NULL.
+static char* JoinPath(const char* prefix, const char* name) {
+  if (prefix == NULL) {
+    return strdup(name);
+  }
+  return Utils::SCreate("%s/%s", prefix, name);
+}
+
+// A recursive watch that a watched directory reports its events to.
+struct WatchOwner {
+  intptr_t root;
+  // Path of the directory relative to the root, or NULL for the root itself.
+  char* relative;
+  WatchOwner* next;
+};
+
+// A directory (or file) with an inotify watch descriptor. It is either
+// watched directly from Dart (a root), or found below one or more recursive
+// roots, or both.
+class WatchedPath {
+ public:
+  WatchedPath(int wd, const char* path)
+      : wd_(wd),
+        path_(strdup(path)),
+        is_root_(false),
+        recursive_(false),
+        owners_(NULL) {}
+
+  ~WatchedPath() {
+    while (owners_ != NULL) {
+      WatchOwner* owner = owners_;
+      owners_ = owner->next;
+      free(owner->relative);
+      delete owner;
+    }
+    free(path_);
+  }
+
+  int wd() const { return wd_; }
+  const char* path() const { return path_; }
+  WatchOwner* owners() const { return owners_; }
+  bool is_root() const { return is_root_; }
+  void set_is_root(bool is_root) { is_root_ = is_root; }
+  bool recursive() const { return recursive_; }
+  void set_recursive(bool recursive) { recursive_ = recursive; }
+
+  // Whether events below this directory are reported to a recursive watch.
+  bool IsInRecursiveWatch() const { return recursive_ || (owners_ != NULL); }
+  bool IsUnused() const { return !is_root_ && (owners_ == NULL); }
+
+  // Returns false if the directory is already reported to |root|.
+  bool AddOwner(intptr_t root, const char* relative) {
+    for (WatchOwner* owner = owners_; owner != NULL; owner = owner->next) {
+      if (owner->root == root) {
+        return false;
+      }
+    }
+    WatchOwner* owner = new WatchOwner();
+    owner->root = root;
+    owner->relative = strdup(relative);
+    owner->next = owners_;
+    owners_ = owner;
+    return true;
+  }
+
+  // Stops reporting to |root| if the directory is |prefix| or below it, or
+  // unconditionally if |prefix| is NULL.
+  void RemoveOwner(intptr_t root, const char* prefix) {
+    WatchOwner** link = &owners_;
+    while (*link != NULL) {
+      WatchOwner* owner = *link;
+      if ((owner->root == root) &&
+          ((prefix == NULL) || IsBelow(owner->relative, prefix))) {
+        *link = owner->next;
+        free(owner->relative);
+        delete owner;
+      } else {
+        link = &owner->next;
+      }
+    }
+  }
+
+ private:
+  static bool IsBelow(const char* path, const char* prefix) {
+    size_t length = strlen(prefix);
+    return (strncmp(path, prefix, length) == 0) &&
+           ((path[length] == '\0') || (path[length] == '/'));
+  }
+
+  int wd_;
+  char* path_;
+  bool is_root_;
+  bool recursive_;
+  WatchOwner* owners_;
+
+  DISALLOW_COPY_AND_ASSIGN(WatchedPath);
+};
+
+// A new directory to watch below the recursive watch |root|. The walk is
+// done after the events are read, without holding the watchers' lock.
+struct TreeWalk {
+  char* path;
+  intptr_t root;
+  char* relative;
+  // Whether a create event is synthesized for every entry found.
+  bool report_entries;
+};
+
+// An event as it will be reported to Dart. Events are scope allocated, as
+// they only live for the duration of a ReadEvents call.
+struct PendingEvent {
+  intptr_t path_id;
+  int mask;
+  uint32_t cookie;
+  const char* name;
+  // The new name of a rename whose both halves were seen.
+  const char* destination;
+  bool is_moved_to;
+};
+
+// Collects the events read in one batch. Renames are paired, and repeated
+// modifications of the same path are reported once.
+class EventBatch {
+ public:
+  EventBatch() : latest_(&SameTarget, 64), previous_start_(0), start_(0) {}
+
+  intptr_t length() const { return events_.length(); }
+  PendingEvent* At(intptr_t i) const { return events_[i]; }
+
+  // Marks the start of the events produced by one inotify_event.
+  void StartRawEvent() {
+    previous_start_ = start_;
+    start_ = events_.length();
+  }
+
+  void Add(intptr_t path_id,
+           int mask,
+           uint32_t cookie,
+           const char* prefix,
+           const char* name,
+           bool is_moved_to) {
+    if (((mask & FileSystemWatcher::kMove) != 0) && is_moved_to &&
+        (cookie != 0) && Pair(path_id, cookie, prefix, name)) {
+      return;
+    }
+    PendingEvent* event =
+        reinterpret_cast<PendingEvent*>(Dart_ScopeAllocate(sizeof(*event)));
+    event->path_id = path_id;
+    event->mask = mask;
+    event->cookie = cookie;
+    event->name = ScopedJoin(prefix, name);
+    event->destination = NULL;
+    event->is_moved_to = is_moved_to;
+    if (IsRepeated(event)) {
+      return;
+    }
+    events_.Add(event);
+  }
+
+ private:
+  static const int kChangeMask = FileSystemWatcher::kModifyContent |
+                                 FileSystemWatcher::kModefyAttribute |
+                                 FileSystemWatcher::kIsDir;
+
+  static bool SameTarget(void* a, void* b) {
+    PendingEvent* event_a = reinterpret_cast<PendingEvent*>(a);
+    PendingEvent* event_b = reinterpret_cast<PendingEvent*>(b);
+    if (event_a->path_id != event_b->path_id) {
+      return false;
+    }
+    if ((event_a->name == NULL) || (event_b->name == NULL)) {
+      return event_a->name == event_b->name;
+    }
+    return strcmp(event_a->name, event_b->name) == 0;
+  }
+
+  static uint32_t TargetHash(PendingEvent* event) {
+    uint32_t hash = SimpleHashMap::StringHash(const_cast<char*>(event->name));
+    return hash ^ Utils::WordHash(event->path_id);
+  }
+
+  // The parts may not outlive the batch, so the result is always a copy.
+  static const char* ScopedJoin(const char* prefix, const char* name) {
+    if (name == NULL) {
+      return (prefix == NULL) ? NULL : DartUtils::ScopedCopyCString(prefix);
+    }
+    if (prefix == NULL) {
+      return DartUtils::ScopedCopyCString(name);
+    }
+    intptr_t prefix_length = strlen(prefix);
+    intptr_t name_length = strlen(name);
+    char* result = DartUtils::ScopedCString(prefix_length + name_length + 2);
+    memmove(result, prefix, prefix_length);
+    result[prefix_length] = '/';
+    memmove(result + prefix_length + 1, name, name_length + 1);
+    return result;
+  }
+
+  // The kernel queues the halves of a rename next to each other, so the
+  // IN_MOVED_FROM is among the events of the previous inotify_event.
+  bool Pair(intptr_t path_id,
+            uint32_t cookie,
+            const char* prefix,
+            const char* name) {
+    for (intptr_t i = previous_start_; i < start_; i++) {
+      PendingEvent* from = events_[i];
+      if ((from->path_id == path_id) && (from->cookie == cookie) &&
+          !from->is_moved_to && (from->destination == NULL)) {
+        from->destination = ScopedJoin(prefix, name);
+        from->cookie = 0;
+        Forget(from);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Returns true if |event| only repeats the latest event for its path.
+  bool IsRepeated(PendingEvent* event) {
+    SimpleHashMap::Entry* entry =
+        latest_.Lookup(event, TargetHash(event), true);
+    PendingEvent* latest = reinterpret_cast<PendingEvent*>(entry->value);
+    if ((latest != NULL) && (latest->mask == event->mask) &&
+        ((event->mask & ~kChangeMask) == 0)) {
+      return true;
+    }
+    entry->key = event;
+    entry->value = event;
+    return false;
+  }
+
+  // A paired rename changes two paths, so it must not absorb later events.
+  void Forget(PendingEvent* event) {
+    SimpleHashMap::Entry* entry =
+        latest_.Lookup(event, TargetHash(event), false);
+    if ((entry != NULL) && (entry->value == event)) {
+      entry->value = NULL;
+    }
+  }
+
+  MallocGrowableArray<PendingEvent*> events_;
+  SimpleHashMap latest_;
+  intptr_t previous_start_;
+  intptr_t start_;
+
+  DISALLOW_COPY_AND_ASSIGN(EventBatch);
+};
+
+// The watch descriptors of one inotify instance.
+class InotifyWatcher {
+ public:
+  explicit InotifyWatcher(intptr_t fd)
+      : fd_(fd),
+        paths_(&SimpleHashMap::SamePointerValue, 16),
+        buffer_(reinterpret_cast<uint8_t*>(malloc(kReadBufferSize))) {}
+
+  ~InotifyWatcher() {
+    for (SimpleHashMap::Entry* entry = paths_.Start(); entry != NULL;
+         entry = paths_.Next(entry)) {
+      delete reinterpret_cast<WatchedPath*>(entry->value);
+    }
+    free(buffer_);
+  }
+
+  intptr_t fd() const { return fd_; }
+  uint8_t* buffer() const { return buffer_; }
+
+  WatchedPath* Lookup(int wd) {
+    SimpleHashMap::Entry* entry = paths_.Lookup(Key(wd), Hash(wd), false);
+    if (entry == NULL) {
+      return NULL;
+    }
+    return reinterpret_cast<WatchedPath*>(entry->value);
+  }
+
+  WatchedPath* LookupOrAdd(int wd, const char* path) {
+    SimpleHashMap::Entry* entry = paths_.Lookup(Key(wd), Hash(wd), true);
+    if (entry->value == NULL) {
+      entry->value = new WatchedPath(wd, path);
+    }
+    return reinterpret_cast<WatchedPath*>(entry->value);
+  }
+
+  // Forgets a watch descriptor the kernel has already dropped.
+  void Remove(WatchedPath* watched) {
+    paths_.Remove(Key(watched->wd()), Hash(watched->wd()));
+    delete watched;
+  }
+
+  // Tells every path watched from Dart that events were dropped, as the
+  // kernel's queue overflowed.
+  void AddOverflow(EventBatch* batch) {
+    for (SimpleHashMap::Entry* entry = paths_.Start(); entry != NULL;
+         entry = paths_.Next(entry)) {
+      WatchedPath* watched = reinterpret_cast<WatchedPath*>(entry->value);
+      if (watched->is_root()) {
+        batch->Add(watched->wd(), FileSystemWatcher::kOverflow, 0, NULL, NULL,
+                   false);
+      }
+    }
+  }
+
+  // Removes the inotify watch of |watched| if nothing reports through it.
+  void RemoveIfUnused(WatchedPath* watched) {
+    if (watched->IsUnused()) {
+      VOID_NO_RETRY_EXPECTED(inotify_rm_watch(fd_, watched->wd()));
+      Remove(watched);
+    }
+  }
+
+  // Stops reporting to |root| from |prefix| and the directories below it, or
+  // from all its directories if |prefix| is NULL.
+  void RemoveOwner(intptr_t root, const char* prefix) {
+    MallocGrowableArray<WatchedPath*> unused;
+    for (SimpleHashMap::Entry* entry = paths_.Start(); entry != NULL;
+         entry = paths_.Next(entry)) {
+      WatchedPath* watched = reinterpret_cast<WatchedPath*>(entry->value);
+      watched->RemoveOwner(root, prefix);
+      if (watched->IsUnused()) {
+        unused.Add(watched);
+      }
+    }
+    for (intptr_t i = 0; i < unused.length(); i++) {
+      RemoveIfUnused(unused[i]);
+    }
+  }
+
+  // Watches the directories below |path| on behalf of |root| of the inotify
+  // instance |fd|, where |path| is |relative| from the root (NULL for the
+  // root itself). If |batch| is not NULL a create event is added for every
+  // entry found, as entries created before the watch was in place are
+  // otherwise never reported. Must be called without holding mutex(), which
+  // is only taken to record each directory, so walking a large tree does not
+  // block the other watchers.
+  static void WatchChildren(intptr_t fd,
+                            const char* path,
+                            intptr_t root,
+                            const char* relative,
+                            EventBatch* batch) {
+    DIR* dir = opendir(path);
+    if (dir == NULL) {
+      return;
+    }
+    // The directory is closed before descending, so deep trees do not run
+    // out of file descriptors.
+    MallocGrowableArray<char*> subdirectories;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+      if ((strcmp(entry->d_name, ".") == 0) ||
+          (strcmp(entry->d_name, "..") == 0)) {
+        continue;
+      }
+      bool is_dir = entry->d_type == DT_DIR;
+      if (entry->d_type == DT_UNKNOWN) {
+        char* child = JoinPath(path, entry->d_name);
+        struct stat64 st;
+        is_dir = (TEMP_FAILURE_RETRY(lstat64(child, &st)) == 0) &&
+                 S_ISDIR(st.st_mode);
+        free(child);
+      }
+      if (batch != NULL) {
+        int mask = FileSystemWatcher::kCreate;
+        if (is_dir) {
+          mask |= FileSystemWatcher::kIsDir;
+        }
+        batch->Add(root, mask, 0, relative, entry->d_name, false);
+      }
+      if (is_dir) {
+        subdirectories.Add(strdup(entry->d_name));
+      }
+    }
+    closedir(dir);
+    for (intptr_t i = 0; i < subdirectories.length(); i++) {
+      char* child = JoinPath(path, subdirectories[i]);
+      char* child_relative = JoinPath(relative, subdirectories[i]);
+      WatchTree(fd, child, root, child_relative, batch);
+      free(child_relative);
+      free(child);
+      free(subdirectories[i]);
+    }
+  }
+
+  // Watches the directory |path| and everything below it on behalf of
+  // |root|. Must be called without holding mutex(), as WatchChildren.
+  static void WatchTree(intptr_t fd,
+                        const char* path,
+                        intptr_t root,
+                        const char* relative,
+                        EventBatch* batch) {
+    int wd = NO_RETRY_EXPECTED(inotify_add_watch(
+        fd, path, kRecursiveMask | IN_MASK_ADD | IN_ONLYDIR | IN_DONT_FOLLOW));
+    if (wd < 0) {
+      // The directory is already gone again.
+      return;
+    }
+    {
+      MutexLocker ml(mutex_);
+      SimpleHashMap::Entry* entry = watchers_->Lookup(Key(fd), Hash(fd), false);
+      if (entry == NULL) {
+        // Closed in the meantime.
+        return;
+      }
+      InotifyWatcher* watcher = reinterpret_cast<InotifyWatcher*>(entry->value);
+      WatchedPath* watched = watcher->LookupOrAdd(wd, path);
+      if (!watched->AddOwner(root, relative)) {
+        return;
+      }
+    }
+    WatchChildren(fd, path, root, relative, batch);
+  }
+
+  // Updates the recursive watches for a change of the subdirectory |name| of
+  // |parent|. Directories that are now below a recursive watch are added to
+  // |walks|.
+  void SubdirectoryChanged(WatchedPath* parent,
+                           const char* name,
+                           uint32_t inotify_mask,
+                           MallocGrowableArray<TreeWalk>* walks) {
+    // Copy the owners, as watching may add |parent| as its own descendant
+    // through a bind mount.
+    MallocGrowableArray<intptr_t> roots;
+    MallocGrowableArray<char*> prefixes;
+    if (parent->recursive()) {
+      roots.Add(parent->wd());
+      prefixes.Add(strdup(name));
+    }
+    for (WatchOwner* owner = parent->owners(); owner != NULL;
+         owner = owner->next) {
+      roots.Add(owner->root);
+      prefixes.Add(JoinPath(owner->relative, name));
+    }
+    for (intptr_t i = 0; i < roots.length(); i++) {
+      if ((inotify_mask & IN_MOVED_FROM) != 0) {
+        RemoveOwner(roots[i], prefixes[i]);
+        free(prefixes[i]);
+      } else {
+        // A directory moved in keeps its entries, which the move reports, so
+        // creations are only synthesized for new directories.
+        TreeWalk walk;
+        walk.path = JoinPath(parent->path(), name);
+        walk.root = roots[i];
+        walk.relative = prefixes[i];
+        walk.report_entries = (inotify_mask & IN_CREATE) != 0;
+        walks->Add(walk);
+      }
+    }
+  }
+
+  static void Add(intptr_t fd);
+  static void Delete(intptr_t fd);
+  static InotifyWatcher* Get(intptr_t fd);
+
+  static Mutex* mutex() { return mutex_; }
+
+ private:
+  // The hashmap does not support keys with value 0.
+  static void* Key(intptr_t key) { return reinterpret_cast<void*>(key + 1); }
+  static uint32_t Hash(intptr_t key) { return Utils::WordHash(key + 1); }
+
+  static SimpleHashMap* watchers_;
+  static Mutex* mutex_;
+
+  intptr_t fd_;
+  SimpleHashMap paths_;
+  uint8_t* buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(InotifyWatcher);
+};
+
+SimpleHashMap* InotifyWatcher::watchers_ =
+    new SimpleHashMap(&SimpleHashMap::SamePointerValue, 4);
+Mutex* InotifyWatcher::mutex_ = new Mutex();
+
+void InotifyWatcher::Add(intptr_t fd) {
+  Delete(fd);
+  SimpleHashMap::Entry* entry = watchers_->Lookup(Key(fd), Hash(fd), true);
+  entry->value = new InotifyWatcher(fd);
+}
+
+void InotifyWatcher::Delete(intptr_t fd) {
+  SimpleHashMap::Entry* entry = watchers_->Lookup(Key(fd), Hash(fd), false);
+  if (entry != NULL) {
+    delete reinterpret_cast<InotifyWatcher*>(entry->value);
+    watchers_->Remove(Key(fd), Hash(fd));
+  }
+}
+
+InotifyWatcher* InotifyWatcher::Get(intptr_t fd) {
+  SimpleHashMap::Entry* entry = watchers_->Lookup(Key(fd), Hash(fd), false);
+  ASSERT(entry != NULL);
+  return reinterpret_cast<InotifyWatcher*>(entry->value);
+}
+
 bool FileSystemWatcher::IsSupported() {
   return true;
 }
@@ -31,11 +544,14 @@ intptr_t FileSystemWatcher::Init() {
   // internals are kept away from the user, we know it's possible to continue,
   // even if setting non-blocking fails.
   FDUtils::SetNonBlocking(id);
+  MutexLocker ml(InotifyWatcher::mutex());
+  InotifyWatcher::Add(id);
   return id;
 }
 
 void FileSystemWatcher::Close(intptr_t id) {
-  USE(id);
+  MutexLocker ml(InotifyWatcher::mutex());
+  InotifyWatcher::Delete(id);
 }
 
 intptr_t FileSystemWatcher::WatchPath(intptr_t id,
@@ -56,17 +572,48 @@ intptr_t FileSystemWatcher::WatchPath(intptr_t id,
   if ((events & kMove) != 0) {
     list_events |= IN_MOVE;
   }
+  if (recursive) {
+    list_events = kRecursiveMask;
+  }
   const char* resolved_path = File::GetCanonicalPath(namespc, path);
   path = resolved_path != NULL ? resolved_path : path;
-  int path_id = NO_RETRY_EXPECTED(inotify_add_watch(id, path, list_events));
+  // The path may already be watched as part of a recursive watch, whose
+  // events must be kept.
+  int path_id =
+      NO_RETRY_EXPECTED(inotify_add_watch(id, path, list_events | IN_MASK_ADD));
   if (path_id < 0) {
     return -1;
   }
+  bool watch_children = false;
+  {
+    MutexLocker ml(InotifyWatcher::mutex());
+    InotifyWatcher* watcher = InotifyWatcher::Get(id);
+    WatchedPath* watched = watcher->LookupOrAdd(path_id, path);
+    watched->set_is_root(true);
+    if (recursive && !watched->recursive()) {
+      watched->set_recursive(true);
+      watch_children = true;
+    }
+  }
+  if (watch_children) {
+    InotifyWatcher::WatchChildren(id, path, path_id, NULL, NULL);
+  }
   return path_id;
 }
 
 void FileSystemWatcher::UnwatchPath(intptr_t id, intptr_t path_id) {
-  VOID_NO_RETRY_EXPECTED(inotify_rm_watch(id, path_id));
+  MutexLocker ml(InotifyWatcher::mutex());
+  InotifyWatcher* watcher = InotifyWatcher::Get(id);
+  WatchedPath* watched = watcher->Lookup(path_id);
+  if (watched == NULL) {
+    return;
+  }
+  if (watched->recursive()) {
+    watched->set_recursive(false);
+    watcher->RemoveOwner(path_id, NULL);
+  }
+  watched->set_is_root(false);
+  watcher->RemoveIfUnused(watched);
 }
 
 intptr_t FileSystemWatcher::GetSocketId(intptr_t id, intptr_t path_id) {
@@ -100,46 +647,126 @@ static int InotifyEventToMask(struct inotify_event* e) {
   return mask;
 }
 
+// Adds the events for |e| to |batch|: once for the path it was reported on if
+// that is watched from Dart, and once for every recursive watch containing it.
+static void AddInotifyEvent(InotifyWatcher* watcher,
+                            struct inotify_event* e,
+                            EventBatch* batch,
+                            MallocGrowableArray<TreeWalk>* walks) {
+  if ((e->wd == -1) || ((e->mask & IN_Q_OVERFLOW) != 0)) {
+    // Not tied to a watch descriptor.
+    batch->StartRawEvent();
+    watcher->AddOverflow(batch);
+    return;
+  }
+  WatchedPath* watched = watcher->Lookup(e->wd);
+  if (watched == NULL) {
+    // The path is no longer being watched.
+    return;
+  }
+  if ((e->mask & IN_IGNORED) != 0) {
+    watcher->Remove(watched);
+    return;
+  }
+  batch->StartRawEvent();
+  int mask = InotifyEventToMask(e);
+  const char* name = (e->len > 0) ? e->name : NULL;
+  bool is_moved_to = (e->mask & IN_MOVED_TO) != 0u;
+  if (watched->is_root()) {
+    batch->Add(e->wd, mask, e->cookie, NULL, name, is_moved_to);
+  }
+  if ((e->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) == 0) {
+    // A directory removed from below a recursive watch is reported by its
+    // parent.
+    for (WatchOwner* owner = watched->owners(); owner != NULL;
+         owner = owner->next) {
+      batch->Add(owner->root, mask, e->cookie, owner->relative, name,
+                 is_moved_to);
+    }
+  }
+  if (((e->mask & IN_ISDIR) != 0) && (name != NULL) &&
+      ((e->mask & (IN_CREATE | IN_MOVE)) != 0) &&
+      watched->IsInRecursiveWatch()) {
+    watcher->SubdirectoryChanged(watched, name, e->mask, walks);
+  }
+}
+
+static Dart_Handle NewStringOrNull(const char* string) {
+  if (string == NULL) {
+    return Dart_Null();
+  }
+  return Dart_NewStringFromUTF8(reinterpret_cast<const uint8_t*>(string),
+                                strlen(string));
+}
+
+// Reads everything the kernel has queued (up to kMaxReadBytes) in one go, so
+// a burst of changes is delivered as one batch instead of one message per
+// event. Each event is a list of [mask, cookie, name, isMovedTo, pathId,
+// destination], where destination is only set for a rename whose two halves
+// were both read.
 Dart_Handle FileSystemWatcher::ReadEvents(intptr_t id, intptr_t path_id) {
   USE(path_id);
   const intptr_t kEventSize = sizeof(struct inotify_event);
-  const intptr_t kBufferSize = kEventSize + NAME_MAX + 1;
-  uint8_t buffer[kBufferSize];
-  intptr_t bytes =
-      SocketBase::Read(id, buffer, kBufferSize, SocketBase::kAsync);
-  if (bytes < 0) {
-    return DartUtils::NewDartOSError();
-  }
-  const intptr_t kMaxCount = bytes / kEventSize;
-  Dart_Handle events = Dart_NewList(kMaxCount);
-  intptr_t offset = 0;
-  intptr_t i = 0;
-  while (offset < bytes) {
-    struct inotify_event* e =
-        reinterpret_cast<struct inotify_event*>(buffer + offset);
-    if ((e->mask & IN_IGNORED) == 0) {
-      Dart_Handle event = Dart_NewList(5);
-      int mask = InotifyEventToMask(e);
-      Dart_ListSetAt(event, 0, Dart_NewInteger(mask));
-      Dart_ListSetAt(event, 1, Dart_NewInteger(e->cookie));
-      if (e->len > 0) {
-        Dart_Handle name = Dart_NewStringFromUTF8(
-            reinterpret_cast<uint8_t*>(e->name), strlen(e->name));
-        if (Dart_IsError(name)) {
-          return name;
+  EventBatch batch;
+  MallocGrowableArray<TreeWalk> walks;
+  {
+    MutexLocker ml(InotifyWatcher::mutex());
+    InotifyWatcher* watcher = InotifyWatcher::Get(id);
+    uint8_t* buffer = watcher->buffer();
+    intptr_t total = 0;
+    while (total < kMaxReadBytes) {
+      intptr_t bytes =
+          SocketBase::Read(id, buffer, kReadBufferSize, SocketBase::kAsync);
+      if (bytes < 0) {
+        if (total > 0) {
+          // Deliver what was read. The error is reported by the next read.
+          break;
         }
-        Dart_ListSetAt(event, 2, name);
-      } else {
-        Dart_ListSetAt(event, 2, Dart_Null());
+        OSError os_error;
+        return DartUtils::NewDartOSError(&os_error);
+      }
+      if (bytes == 0) {
+        break;
+      }
+      total += bytes;
+      intptr_t offset = 0;
+      while (offset < bytes) {
+        struct inotify_event* e =
+            reinterpret_cast<struct inotify_event*>(buffer + offset);
+        AddInotifyEvent(watcher, e, &batch, &walks);
+        offset += kEventSize + e->len;
       }
-      Dart_ListSetAt(event, 3, Dart_NewBoolean((e->mask & IN_MOVED_TO) != 0u));
-      Dart_ListSetAt(event, 4, Dart_NewInteger(e->wd));
-      Dart_ListSetAt(events, i, event);
-      i++;
+      ASSERT(offset == bytes);
+    }
+  }
+  // New directories are walked after the lock is released.
+  for (intptr_t i = 0; i < walks.length(); i++) {
+    const TreeWalk& walk = walks[i];
+    InotifyWatcher::WatchTree(id, walk.path, walk.root, walk.relative,
+                              walk.report_entries ? &batch : NULL);
+    free(walk.path);
+    free(walk.relative);
+  }
+  Dart_Handle events = Dart_NewList(batch.length());
+  for (intptr_t i = 0; i < batch.length(); i++) {
+    PendingEvent* pending = batch.At(i);
+    Dart_Handle name = NewStringOrNull(pending->name);
+    if (Dart_IsError(name)) {
+      return name;
+    }
+    Dart_Handle destination = NewStringOrNull(pending->destination);
+    if (Dart_IsError(destination)) {
+      return destination;
     }
-    offset += kEventSize + e->len;
+    Dart_Handle event = Dart_NewList(6);
+    Dart_ListSetAt(event, 0, Dart_NewInteger(pending->mask));
+    Dart_ListSetAt(event, 1, Dart_NewInteger(pending->cookie));
+    Dart_ListSetAt(event, 2, name);
+    Dart_ListSetAt(event, 3, Dart_NewBoolean(pending->is_moved_to));
+    Dart_ListSetAt(event, 4, Dart_NewInteger(pending->path_id));
+    Dart_ListSetAt(event, 5, destination);
+    Dart_ListSetAt(events, i, event);
   }
-  ASSERT(offset == bytes);
   return events;
 }
 
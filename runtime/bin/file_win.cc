@@ -103,9 +103,14 @@ MappedMemory* File::Map(File::MapType type,
     }
   }
 
+  // The contents are copied, so the mapping does not follow later changes of
+  // the file. Reading them must not move the file position.
   const int64_t remaining_length = Length() - position;
+  const int64_t original_position = Position();
   SetPosition(position);
-  if (!ReadFully(addr, Utils::Minimum(length, remaining_length))) {
+  const bool read = ReadFully(addr, Utils::Minimum(length, remaining_length));
+  SetPosition(original_position);
+  if (!read) {
     Syslog::PrintErr("ReadFully failed %d\n", GetLastError());
     if (start == nullptr) {
       VirtualFree(addr, 0, MEM_RELEASE);
@@ -139,6 +144,11 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+void MappedMemory::Advise(Advice advice) {
+  // The mapping is a copy of the file contents, so there is nothing to
+  // advise.
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return read(handle_->fd(), buffer, num_bytes);
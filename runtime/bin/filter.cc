@@ -4,10 +4,16 @@
 
 #include "bin/filter.h"
 
+#include <atomic>
+
 #include "bin/dartutils.h"
 #include "bin/io_buffer.h"
+#include "bin/lockers.h"
+#include "bin/platform.h"
+#include "bin/thread.h"
 
 #include "include/dart_api.h"
+#include "platform/utils.h"
 
 namespace dart {
 namespace bin {
@@ -127,6 +133,12 @@ void FUNCTION_NAME(Filter_CreateZLibDeflate)(Dart_NativeArguments args) {
   Dart_Handle dict_obj = Dart_GetNativeArgument(args, 6);
   Dart_Handle raw_obj = Dart_GetNativeArgument(args, 7);
   bool raw = DartUtils::GetBooleanValue(raw_obj);
+  Dart_Handle threads_obj = Dart_GetNativeArgument(args, 8);
+  int64_t threads =
+      DartUtils::GetInt64ValueCheckRange(threads_obj, 1, kMaxInt32);
+  // More threads than processors would only queue more input, which is held
+  // in memory until a worker gets to it.
+  threads = Utils::Minimum<int64_t>(threads, Platform::NumberOfProcessors());
 
   Dart_Handle err;
   uint8_t* dictionary = NULL;
@@ -145,10 +157,18 @@ void FUNCTION_NAME(Filter_CreateZLibDeflate)(Dart_NativeArguments args) {
     }
   }
 
-  ZLibDeflateFilter* filter = new ZLibDeflateFilter(
-      gzip, static_cast<int32_t>(level), static_cast<int32_t>(window_bits),
-      static_cast<int32_t>(mem_level), static_cast<int32_t>(strategy),
-      dictionary, dictionary_length, raw);
+  Filter* filter;
+  if (threads > 1) {
+    filter = new ParallelZLibDeflateFilter(
+        gzip, static_cast<int32_t>(level), static_cast<int32_t>(window_bits),
+        static_cast<int32_t>(mem_level), static_cast<int32_t>(strategy),
+        dictionary, dictionary_length, raw, threads);
+  } else {
+    filter = new ZLibDeflateFilter(
+        gzip, static_cast<int32_t>(level), static_cast<int32_t>(window_bits),
+        static_cast<int32_t>(mem_level), static_cast<int32_t>(strategy),
+        dictionary, dictionary_length, raw);
+  }
   if (filter == NULL) {
     delete[] dictionary;
     Dart_PropagateError(
@@ -159,8 +179,14 @@ void FUNCTION_NAME(Filter_CreateZLibDeflate)(Dart_NativeArguments args) {
     Dart_ThrowException(
         DartUtils::NewInternalError("Failed to create ZLibDeflateFilter"));
   }
+  intptr_t filter_size = sizeof(ZLibDeflateFilter);
+  if (threads > 1) {
+    // Account for the blocks that can be queued for the workers.
+    filter_size = sizeof(ParallelZLibDeflateFilter) +
+                  2 * threads * ParallelZLibDeflateFilter::kBlockSize;
+  }
   Dart_Handle result = Filter::SetFilterAndCreateFinalizer(
-      filter_obj, filter, sizeof(*filter) + dictionary_length);
+      filter_obj, filter, filter_size + dictionary_length);
   if (Dart_IsError(result)) {
     delete filter;
     Dart_PropagateError(result);
@@ -368,6 +394,499 @@ intptr_t ZLibDeflateFilter::Processed(uint8_t* buffer,
   return error ? -1 : 0;
 }
 
+// A block of input deflated by one of the DeflateWorkers, and its output.
+class DeflateBlock {
+ public:
+  DeflateBlock(uint8_t* input,
+               intptr_t input_length,
+               const uint8_t* window,
+               intptr_t window_length,
+               bool last,
+               bool gzip,
+               bool raw,
+               int32_t level,
+               int32_t window_bits,
+               int32_t mem_level,
+               int32_t strategy)
+      : input_(input),
+        input_length_(input_length),
+        window_(NULL),
+        window_length_(window_length),
+        last_(last),
+        gzip_(gzip),
+        raw_(raw),
+        level_(level),
+        window_bits_(window_bits),
+        mem_level_(mem_level),
+        strategy_(strategy),
+        output_(NULL),
+        output_length_(0),
+        output_offset_(0),
+        check_(0),
+        done_(false),
+        error_(false),
+        next_(NULL),
+        next_queued_(NULL) {
+    if (window_length > 0) {
+      window_ = reinterpret_cast<uint8_t*>(malloc(window_length));
+      memmove(window_, window, window_length);
+    }
+  }
+
+  ~DeflateBlock() {
+    free(input_);
+    free(window_);
+    free(output_);
+  }
+
+  // Runs on a worker thread.
+  void Deflate() {
+    if (!raw_) {
+      check_ = gzip_ ? crc32(0, input_, input_length_)
+                     : adler32(1, input_, input_length_);
+    }
+    z_stream stream;
+    stream.next_in = Z_NULL;
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    if (deflateInit2(&stream, level_, Z_DEFLATED, -window_bits_, mem_level_,
+                     strategy_) != Z_OK) {
+      error_ = true;
+      return;
+    }
+    if ((window_ != NULL) &&
+        (deflateSetDictionary(&stream, window_, window_length_) != Z_OK)) {
+      deflateEnd(&stream);
+      error_ = true;
+      return;
+    }
+    // Blocks other than the last end with a sync flush rather than the final
+    // block marker, so their output can be concatenated.
+    const int flush = last_ ? Z_FINISH : Z_SYNC_FLUSH;
+    intptr_t capacity = deflateBound(&stream, input_length_) + kFlushSize;
+    output_ = reinterpret_cast<uint8_t*>(malloc(capacity));
+    stream.next_in = input_;
+    stream.avail_in = input_length_;
+    int result;
+    do {
+      if (output_length_ == capacity) {
+        capacity *= 2;
+        output_ = reinterpret_cast<uint8_t*>(realloc(output_, capacity));
+      }
+      stream.next_out = output_ + output_length_;
+      stream.avail_out = capacity - output_length_;
+      result = deflate(&stream, flush);
+      output_length_ = capacity - stream.avail_out;
+    } while ((result == Z_OK) && (stream.avail_out == 0));
+    error_ = last_ ? (result != Z_STREAM_END) : (result != Z_OK);
+    deflateEnd(&stream);
+    free(input_);
+    input_ = NULL;
+  }
+
+  intptr_t input_length() const { return input_length_; }
+  uint32_t check() const { return check_; }
+  // Pairs with set_done, so the output of a block seen to be done can be read
+  // without holding the workers' monitor.
+  bool done() const { return done_.load(std::memory_order_acquire); }
+  void set_done() { done_.store(true, std::memory_order_release); }
+  bool error() const { return error_; }
+  DeflateBlock* next() const { return next_; }
+  void set_next(DeflateBlock* next) { next_ = next; }
+  DeflateBlock* next_queued() const { return next_queued_; }
+  void set_next_queued(DeflateBlock* next) { next_queued_ = next; }
+
+  // Copies up to length bytes of output not yet read to buffer.
+  intptr_t Read(uint8_t* buffer, intptr_t length) {
+    intptr_t count = Utils::Minimum(length, output_length_ - output_offset_);
+    memmove(buffer, output_ + output_offset_, count);
+    output_offset_ += count;
+    return count;
+  }
+  bool IsRead() const { return output_offset_ == output_length_; }
+
+ private:
+  // Room for the sync flush marker on top of deflateBound.
+  static const intptr_t kFlushSize = 16;
+
+  uint8_t* input_;
+  const intptr_t input_length_;
+  uint8_t* window_;
+  const intptr_t window_length_;
+  const bool last_;
+  const bool gzip_;
+  const bool raw_;
+  const int32_t level_;
+  const int32_t window_bits_;
+  const int32_t mem_level_;
+  const int32_t strategy_;
+  uint8_t* output_;
+  intptr_t output_length_;
+  intptr_t output_offset_;
+  uint32_t check_;
+  std::atomic<bool> done_;
+  bool error_;
+  DeflateBlock* next_;         // Next block of the same filter.
+  DeflateBlock* next_queued_;  // Next block waiting for a worker.
+
+  DISALLOW_COPY_AND_ASSIGN(DeflateBlock);
+};
+
+// Threads deflating blocks for all ParallelZLibDeflateFilters. Threads are
+// started on demand, up to the number of processors, and kept for reuse.
+class DeflateWorkers {
+ public:
+  static void Queue(DeflateBlock* block, intptr_t threads) {
+    MonitorLocker locker(monitor_);
+    if (queue_tail_ == NULL) {
+      queue_head_ = block;
+    } else {
+      queue_tail_->set_next_queued(block);
+    }
+    queue_tail_ = block;
+    const intptr_t max_threads =
+        Utils::Minimum<intptr_t>(threads, Platform::NumberOfProcessors());
+    if ((idle_threads_ == 0) && (thread_count_ < max_threads)) {
+      int result = Thread::Start("dart:io Deflate", WorkerEntry, 0);
+      if (result == 0) {
+        thread_count_++;
+      } else if (thread_count_ == 0) {
+        FATAL1("Failed to start deflate worker thread %d", result);
+      }
+    }
+    locker.NotifyAll();
+  }
+
+  static void WaitFor(DeflateBlock* block) {
+    MonitorLocker locker(monitor_);
+    while (!block->done()) {
+      locker.Wait();
+    }
+  }
+
+ private:
+  static void WorkerEntry(uword param) {
+    while (true) {
+      DeflateBlock* block;
+      {
+        MonitorLocker locker(monitor_);
+        while (queue_head_ == NULL) {
+          idle_threads_++;
+          locker.Wait();
+          idle_threads_--;
+        }
+        block = queue_head_;
+        queue_head_ = block->next_queued();
+        if (queue_head_ == NULL) {
+          queue_tail_ = NULL;
+        }
+      }
+      block->Deflate();
+      {
+        MonitorLocker locker(monitor_);
+        block->set_done();
+        locker.NotifyAll();
+      }
+    }
+  }
+
+  static Monitor* monitor_;
+  static DeflateBlock* queue_head_;
+  static DeflateBlock* queue_tail_;
+  static intptr_t thread_count_;
+  static intptr_t idle_threads_;
+
+  DISALLOW_ALLOCATION();
+  DISALLOW_IMPLICIT_CONSTRUCTORS(DeflateWorkers);
+};
+
+Monitor* DeflateWorkers::monitor_ = new Monitor();
+DeflateBlock* DeflateWorkers::queue_head_ = NULL;
+DeflateBlock* DeflateWorkers::queue_tail_ = NULL;
+intptr_t DeflateWorkers::thread_count_ = 0;
+intptr_t DeflateWorkers::idle_threads_ = 0;
+
+ParallelZLibDeflateFilter::ParallelZLibDeflateFilter(bool gzip,
+                                                     int32_t level,
+                                                     int32_t window_bits,
+                                                     int32_t mem_level,
+                                                     int32_t strategy,
+                                                     uint8_t* dictionary,
+                                                     intptr_t dictionary_length,
+                                                     bool raw,
+                                                     intptr_t threads)
+    : gzip_(gzip),
+      level_(level),
+      window_bits_(window_bits),
+      mem_level_(mem_level),
+      strategy_(strategy),
+      dictionary_(dictionary),
+      dictionary_length_(dictionary_length),
+      raw_(raw),
+      max_queued_(2 * threads),
+      current_buffer_(NULL),
+      current_length_(0),
+      current_offset_(0),
+      block_(NULL),
+      block_length_(0),
+      window_(NULL),
+      window_length_(0),
+      head_(NULL),
+      tail_(NULL),
+      queued_(0),
+      check_(0),
+      total_length_(0),
+      finished_(false),
+      trailer_written_(false),
+      extra_length_(0),
+      extra_offset_(0) {}
+
+ParallelZLibDeflateFilter::~ParallelZLibDeflateFilter() {
+  while (head_ != NULL) {
+    DeflateBlock* block = head_;
+    // The worker may still be writing to the block.
+    DeflateWorkers::WaitFor(block);
+    head_ = block->next();
+    delete block;
+  }
+  delete[] dictionary_;
+  delete[] current_buffer_;
+  free(block_);
+  free(window_);
+}
+
+bool ParallelZLibDeflateFilter::Init() {
+  if (level_ == Z_DEFAULT_COMPRESSION) {
+    level_ = 6;
+  }
+  if (window_bits_ == 8) {
+    // See ZLibDeflateFilter::Init.
+    window_bits_ = 9;
+  }
+  // Check the parameters the same way the blocks will use them.
+  z_stream stream;
+  stream.next_in = Z_NULL;
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+  if (deflateInit2(&stream, level_, Z_DEFLATED, -window_bits_, mem_level_,
+                   strategy_) != Z_OK) {
+    return false;
+  }
+  deflateEnd(&stream);
+
+  window_ = reinterpret_cast<uint8_t*>(malloc(1 << window_bits_));
+  if (!raw_) {
+    check_ = gzip_ ? crc32(0, Z_NULL, 0) : adler32(0, Z_NULL, 0);
+  }
+  if ((dictionary_ != NULL) && !gzip_ && !raw_) {
+    // The first block is primed with the dictionary.
+    UpdateWindow(dictionary_, dictionary_length_);
+  } else {
+    delete[] dictionary_;
+    dictionary_ = NULL;
+  }
+  WriteHeader();
+  set_initialized(true);
+  return true;
+}
+
+bool ParallelZLibDeflateFilter::Process(uint8_t* data, intptr_t length) {
+  if (current_buffer_ != NULL) {
+    return false;
+  }
+  current_buffer_ = data;
+  current_length_ = length;
+  current_offset_ = 0;
+  return true;
+}
+
+intptr_t ParallelZLibDeflateFilter::Processed(uint8_t* buffer,
+                                              intptr_t length,
+                                              bool flush,
+                                              bool end) {
+  intptr_t written = 0;
+  while (true) {
+    QueueInput();
+    if ((current_buffer_ == NULL) && (flush || end) && !finished_ &&
+        ((block_length_ > 0) || end) && (queued_ < max_queued_)) {
+      QueueBlock(end);
+    }
+    if (written == length) {
+      break;
+    }
+    if (extra_offset_ < extra_length_) {
+      intptr_t count =
+          Utils::Minimum(length - written, extra_length_ - extra_offset_);
+      memmove(buffer + written, extra_ + extra_offset_, count);
+      extra_offset_ += count;
+      written += count;
+      continue;
+    }
+    DeflateBlock* block = head_;
+    if (block == NULL) {
+      if (finished_ && !trailer_written_) {
+        WriteTrailer();
+        continue;
+      }
+      break;
+    }
+    if (!block->done()) {
+      // Only wait for the workers if input is left that Process can not take
+      // yet, or if the caller asked for all output.
+      if ((written > 0) ||
+          ((current_buffer_ == NULL) && !flush && !end)) {
+        break;
+      }
+      DeflateWorkers::WaitFor(block);
+    }
+    if (block->error()) {
+      return -1;
+    }
+    written += block->Read(buffer + written, length - written);
+    if (block->IsRead()) {
+      if (gzip_) {
+        check_ = crc32_combine(check_, block->check(), block->input_length());
+      } else if (!raw_) {
+        check_ =
+            adler32_combine(check_, block->check(), block->input_length());
+      }
+      total_length_ += static_cast<uint32_t>(block->input_length());
+      head_ = block->next();
+      if (head_ == NULL) {
+        tail_ = NULL;
+      }
+      queued_--;
+      delete block;
+    }
+  }
+  return written;
+}
+
+void ParallelZLibDeflateFilter::QueueInput() {
+  while ((current_buffer_ != NULL) && (queued_ < max_queued_)) {
+    if (block_ == NULL) {
+      block_ = reinterpret_cast<uint8_t*>(malloc(kBlockSize));
+    }
+    intptr_t count = Utils::Minimum(kBlockSize - block_length_,
+                                    current_length_ - current_offset_);
+    memmove(block_ + block_length_, current_buffer_ + current_offset_, count);
+    block_length_ += count;
+    current_offset_ += count;
+    if (current_offset_ == current_length_) {
+      delete[] current_buffer_;
+      current_buffer_ = NULL;
+    }
+    if (block_length_ == kBlockSize) {
+      QueueBlock(false);
+    }
+  }
+}
+
+void ParallelZLibDeflateFilter::QueueBlock(bool last) {
+  DeflateBlock* block = new DeflateBlock(
+      block_, block_length_, window_, window_length_, last, gzip_, raw_,
+      level_, window_bits_, mem_level_, strategy_);
+  if (block_ != NULL) {
+    UpdateWindow(block_, block_length_);
+  }
+  block_ = NULL;
+  block_length_ = 0;
+  if (tail_ == NULL) {
+    head_ = block;
+  } else {
+    tail_->set_next(block);
+  }
+  tail_ = block;
+  queued_++;
+  finished_ = last;
+  DeflateWorkers::Queue(block, max_queued_ / 2);
+}
+
+void ParallelZLibDeflateFilter::UpdateWindow(const uint8_t* data,
+                                             intptr_t length) {
+  const intptr_t window_size = 1 << window_bits_;
+  if (length >= window_size) {
+    memmove(window_, data + length - window_size, window_size);
+    window_length_ = window_size;
+    return;
+  }
+  intptr_t keep = Utils::Minimum(window_length_, window_size - length);
+  memmove(window_, window_ + window_length_ - keep, keep);
+  memmove(window_ + keep, data, length);
+  window_length_ = keep + length;
+}
+
+void ParallelZLibDeflateFilter::WriteHeader() {
+  if (raw_) {
+    return;
+  }
+  if (gzip_) {
+    // Magic, deflate method, no flags and no modification time, as written
+    // by zlib.
+    const uint8_t header[] = {0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0};
+    memmove(extra_, header, sizeof(header));
+    extra_length_ = sizeof(header);
+    uint8_t extra_flags = 0;
+    if (level_ == Z_BEST_COMPRESSION) {
+      extra_flags = 2;
+    } else if ((strategy_ >= Z_HUFFMAN_ONLY) || (level_ < 2)) {
+      extra_flags = 4;
+    }
+    extra_[extra_length_++] = extra_flags;
+    extra_[extra_length_++] = 3;  // Unix.
+    return;
+  }
+  // zlib header, see RFC 1950.
+  uint32_t header = (Z_DEFLATED + ((window_bits_ - 8) << 4)) << 8;
+  uint32_t level_flags;
+  if ((strategy_ >= Z_HUFFMAN_ONLY) || (level_ < 2)) {
+    level_flags = 0;
+  } else if (level_ < 6) {
+    level_flags = 1;
+  } else if (level_ == 6) {
+    level_flags = 2;
+  } else {
+    level_flags = 3;
+  }
+  header |= level_flags << 6;
+  if (dictionary_ != NULL) {
+    header |= 0x20;
+  }
+  header += 31 - (header % 31);
+  WriteExtra(header, 2, true);
+  if (dictionary_ != NULL) {
+    WriteExtra(adler32(adler32(0, Z_NULL, 0), dictionary_, dictionary_length_),
+               4, true);
+    delete[] dictionary_;
+    dictionary_ = NULL;
+  }
+}
+
+void ParallelZLibDeflateFilter::WriteTrailer() {
+  ASSERT(extra_offset_ == extra_length_);
+  extra_length_ = 0;
+  extra_offset_ = 0;
+  if (gzip_) {
+    WriteExtra(check_, 4, false);
+    WriteExtra(total_length_, 4, false);
+  } else if (!raw_) {
+    WriteExtra(check_, 4, true);
+  }
+  trailer_written_ = true;
+}
+
+void ParallelZLibDeflateFilter::WriteExtra(uint32_t value,
+                                           intptr_t bytes,
+                                           bool big_endian) {
+  ASSERT(extra_length_ + bytes <= kMaxExtraSize);
+  for (intptr_t i = 0; i < bytes; i++) {
+    intptr_t shift = big_endian ? (bytes - 1 - i) * 8 : i * 8;
+    extra_[extra_length_++] = static_cast<uint8_t>(value >> shift);
+  }
+}
+
 ZLibInflateFilter::~ZLibInflateFilter() {
   delete[] dictionary_;
   delete[] current_buffer_;
@@ -95,6 +95,85 @@ class ZLibDeflateFilter : public Filter {
   DISALLOW_COPY_AND_ASSIGN(ZLibDeflateFilter);
 };
 
+class DeflateBlock;
+
+// Deflates the input in independent blocks on several threads, pigz style,
+// and joins the compressed blocks into a single zlib, gzip or raw deflate
+// stream. Each block is primed with the window of input preceding it, so the
+// output is only slightly larger than that of ZLibDeflateFilter.
+class ParallelZLibDeflateFilter : public Filter {
+ public:
+  ParallelZLibDeflateFilter(bool gzip,
+                            int32_t level,
+                            int32_t window_bits,
+                            int32_t mem_level,
+                            int32_t strategy,
+                            uint8_t* dictionary,
+                            intptr_t dictionary_length,
+                            bool raw,
+                            intptr_t threads);
+  virtual ~ParallelZLibDeflateFilter();
+
+  virtual bool Init();
+  virtual bool Process(uint8_t* data, intptr_t length);
+  virtual intptr_t Processed(uint8_t* buffer,
+                             intptr_t length,
+                             bool finish,
+                             bool end);
+
+  // Size of the blocks the input is split into.
+  static const intptr_t kBlockSize = 128 * KB;
+
+ private:
+  // Moves input from current_buffer_ into blocks for the workers until the
+  // input is used up or the maximum number of blocks is queued.
+  void QueueInput();
+  void QueueBlock(bool last);
+  void UpdateWindow(const uint8_t* data, intptr_t length);
+  void WriteHeader();
+  void WriteTrailer();
+  void WriteExtra(uint32_t value, intptr_t bytes, bool big_endian);
+
+  const bool gzip_;
+  int32_t level_;
+  int32_t window_bits_;
+  const int32_t mem_level_;
+  const int32_t strategy_;
+  uint8_t* dictionary_;
+  const intptr_t dictionary_length_;
+  const bool raw_;
+  const intptr_t max_queued_;
+
+  // Input passed to Process that is not yet split into blocks.
+  uint8_t* current_buffer_;
+  intptr_t current_length_;
+  intptr_t current_offset_;
+
+  // The block being filled, and the last window of input before it.
+  uint8_t* block_;
+  intptr_t block_length_;
+  uint8_t* window_;
+  intptr_t window_length_;
+
+  // Blocks handed to the workers, in stream order.
+  DeflateBlock* head_;
+  DeflateBlock* tail_;
+  intptr_t queued_;
+
+  uint32_t check_;
+  uint32_t total_length_;
+  bool finished_;
+  bool trailer_written_;
+
+  // Header and trailer bytes not yet returned from Processed.
+  static const intptr_t kMaxExtraSize = 16;
+  uint8_t extra_[kMaxExtraSize];
+  intptr_t extra_length_;
+  intptr_t extra_offset_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelZLibDeflateFilter);
+};
+
 class ZLibInflateFilter : public Filter {
  public:
   ZLibInflateFilter(int32_t window_bits,
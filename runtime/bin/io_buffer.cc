@@ -4,6 +4,10 @@
 
 #include "bin/io_buffer.h"
 
+#include "bin/lockers.h"
+#include "platform/assert.h"
+#include "platform/utils.h"
+
 namespace dart {
 namespace bin {
 
@@ -29,5 +33,133 @@ uint8_t* IOBuffer::Allocate(intptr_t size) {
   return reinterpret_cast<uint8_t*>(malloc(size));
 }
 
+// Every pooled buffer is preceded by a header recording its size class. The
+// header is padded so that the payload keeps malloc's alignment.
+struct IOBufferPool::Header {
+  intptr_t size_class;  // -1 for storage that bypasses the pool.
+  intptr_t capacity;
+  Header* next;
+};
+
+static const intptr_t kHeaderSize = 32;
+
+Mutex* IOBufferPool::mutex_ = new Mutex();
+IOBufferPool::Header* IOBufferPool::free_lists_[kNumSizeClasses] = {NULL};
+intptr_t IOBufferPool::free_counts_[kNumSizeClasses] = {0};
+
+intptr_t IOBufferPool::SizeClassFor(intptr_t size) {
+  if (size > (static_cast<intptr_t>(1) << kMaxSizeLog2)) {
+    return -1;
+  }
+  if (size <= (static_cast<intptr_t>(1) << kMinSizeLog2)) {
+    return 0;
+  }
+  const intptr_t size_log2 = Utils::HighestBit(size - 1) + 1;
+  return size_log2 - kMinSizeLog2;
+}
+
+IOBufferPool::Header* IOBufferPool::HeaderOf(uint8_t* buffer) {
+  COMPILE_ASSERT(sizeof(Header) <= kHeaderSize);
+  return reinterpret_cast<Header*>(buffer - kHeaderSize);
+}
+
+uint8_t* IOBufferPool::Allocate(intptr_t size, intptr_t* capacity) {
+  const intptr_t size_class = SizeClassFor(size);
+  Header* header = NULL;
+  if (size_class >= 0) {
+    MutexLocker ml(mutex_);
+    header = free_lists_[size_class];
+    if (header != NULL) {
+      free_lists_[size_class] = header->next;
+      free_counts_[size_class]--;
+    }
+  }
+  if (header == NULL) {
+    const intptr_t allocation_capacity =
+        (size_class >= 0)
+            ? (static_cast<intptr_t>(1) << (size_class + kMinSizeLog2))
+            : size;
+    void* memory = malloc(kHeaderSize + allocation_capacity);
+    if (memory == NULL) {
+      return NULL;
+    }
+    header = reinterpret_cast<Header*>(memory);
+    header->size_class = size_class;
+    header->capacity = allocation_capacity;
+  }
+  header->next = NULL;
+  if (capacity != NULL) {
+    *capacity = header->capacity;
+  }
+  return reinterpret_cast<uint8_t*>(header) + kHeaderSize;
+}
+
+void IOBufferPool::Free(uint8_t* buffer) {
+  if (buffer == NULL) {
+    return;
+  }
+  Header* header = HeaderOf(buffer);
+  const intptr_t size_class = header->size_class;
+  if (size_class >= 0) {
+    ASSERT(size_class < kNumSizeClasses);
+    MutexLocker ml(mutex_);
+    if (free_counts_[size_class] < kMaxCachedPerClass) {
+      header->next = free_lists_[size_class];
+      free_lists_[size_class] = header;
+      free_counts_[size_class]++;
+      return;
+    }
+  }
+  free(header);
+}
+
+void IOBufferPool::Finalizer(void* isolate_callback_data,
+                             Dart_WeakPersistentHandle handle,
+                             void* peer) {
+  Free(reinterpret_cast<uint8_t*>(peer));
+}
+
+Dart_Handle IOBufferPool::NewExternalTypedData(uint8_t* buffer,
+                                               intptr_t length) {
+  ASSERT(buffer != NULL);
+  Header* header = HeaderOf(buffer);
+  ASSERT(length <= header->capacity);
+  // Report the full capacity so the GC accounts for the retained storage.
+  Dart_Handle result = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kUint8, buffer, length, buffer, header->capacity,
+      IOBufferPool::Finalizer);
+  if (Dart_IsError(result)) {
+    Free(buffer);
+    Dart_PropagateError(result);
+  }
+  return result;
+}
+
+Dart_Handle IOBufferPool::Allocate(intptr_t size, uint8_t** buffer) {
+  uint8_t* data = Allocate(size);
+  if (data == NULL) {
+    return Dart_Null();
+  }
+  Dart_Handle result = NewExternalTypedData(data, size);
+  if (buffer != NULL) {
+    *buffer = data;
+  }
+  return result;
+}
+
+void IOBufferPool::Cleanup() {
+  MutexLocker ml(mutex_);
+  for (intptr_t i = 0; i < kNumSizeClasses; i++) {
+    Header* header = free_lists_[i];
+    while (header != NULL) {
+      Header* next = header->next;
+      free(header);
+      header = next;
+    }
+    free_lists_[i] = NULL;
+    free_counts_[i] = 0;
+  }
+}
+
 }  // namespace bin
 }  // namespace dart
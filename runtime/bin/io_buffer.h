@@ -5,6 +5,7 @@
 #ifndef RUNTIME_BIN_IO_BUFFER_H_
 #define RUNTIME_BIN_IO_BUFFER_H_
 
+#include "bin/thread.h"
 #include "include/dart_api.h"
 #include "platform/globals.h"
 
@@ -36,6 +37,61 @@ class IOBuffer {
   DISALLOW_IMPLICIT_CONSTRUCTORS(IOBuffer);
 };
 
+// A size-classed pool of IO buffer storage used for short-lived read
+// buffers (e.g. the result of a socket read). Storage is returned to the
+// pool when the external typed data wrapping it is finalized instead of
+// being handed back to malloc, so hot read paths stop churning the
+// allocator. Requests larger than the largest size class bypass the pool.
+//
+// The pool is shared by all isolates: typed data finalizers may run on
+// whichever thread performs the GC, so all accesses are guarded by a mutex.
+class IOBufferPool {
+ public:
+  // Allocate pooled storage for at least |size| bytes. The usable capacity
+  // of the returned storage is stored in |capacity| when it is not NULL.
+  // Returns NULL if the allocation failed.
+  static uint8_t* Allocate(intptr_t size, intptr_t* capacity = NULL);
+
+  // Return storage obtained from Allocate to the pool.
+  static void Free(uint8_t* buffer);
+
+  // Wrap the first |length| bytes of pooled |buffer| in an external
+  // Uint8List. The storage is returned to the pool when the list is
+  // collected. On error the storage is returned to the pool and the error is
+  // propagated.
+  static Dart_Handle NewExternalTypedData(uint8_t* buffer, intptr_t length);
+
+  // Allocate a pooled IO buffer dart object of |size| bytes. Same contract as
+  // IOBuffer::Allocate.
+  static Dart_Handle Allocate(intptr_t size, uint8_t** buffer);
+
+  // Release all cached storage.
+  static void Cleanup();
+
+  static const intptr_t kMinSizeLog2 = 9;    // 512 bytes.
+  static const intptr_t kMaxSizeLog2 = 16;   // 64 KB.
+  static const intptr_t kNumSizeClasses = kMaxSizeLog2 - kMinSizeLog2 + 1;
+  // Maximum number of free buffers retained per size class.
+  static const intptr_t kMaxCachedPerClass = 64;
+
+ private:
+  struct Header;
+
+  static void Finalizer(void* isolate_callback_data,
+                        Dart_WeakPersistentHandle handle,
+                        void* peer);
+
+  static intptr_t SizeClassFor(intptr_t size);
+  static Header* HeaderOf(uint8_t* buffer);
+
+  static Mutex* mutex_;
+  static Header* free_lists_[kNumSizeClasses];
+  static intptr_t free_counts_[kNumSizeClasses];
+
+  DISALLOW_ALLOCATION();
+  DISALLOW_IMPLICIT_CONSTRUCTORS(IOBufferPool);
+};
+
 }  // namespace bin
 }  // namespace dart
 
@@ -10,6 +10,7 @@
 #endif
 
 #include "bin/builtin.h"
+#include "bin/dartutils.h"
 #include "bin/utils.h"
 
 namespace dart {
@@ -59,7 +60,8 @@ namespace bin {
   V(Directory, ListNext, 39)                                                   \
   V(Directory, ListStop, 40)                                                   \
   V(Directory, Rename, 41)                                                     \
-  V(SSLFilter, ProcessFilter, 42)
+  V(SSLFilter, ProcessFilter, 42)                                              \
+  V(IOService, Batch, 43)
 
 #define DECLARE_REQUEST(type, method, id) k##type##method##Request = id,
 
@@ -69,6 +71,15 @@ class IOService {
 
   static Dart_Port GetServicePort();
 
+  // Processes a single request and returns its response.
+  static CObject* ProcessRequest(intptr_t request_id,
+                                 const CObjectArray& data);
+
+  // Processes a batch of requests in one go. The request data is a flat
+  // array of request id and request data pairs. The response is an array
+  // with the response to each request, in order.
+  static CObject* BatchRequest(const CObjectArray& request);
+
  private:
   DISALLOW_ALLOCATION();
   DISALLOW_IMPLICIT_CONSTRUCTORS(IOService);
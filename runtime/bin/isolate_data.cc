@@ -3,6 +3,7 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "bin/isolate_data.h"
+#include "bin/file.h"
 #include "bin/snapshot_utils.h"
 #include "platform/growable_array.h"
 
@@ -42,6 +43,16 @@ IsolateGroupData::~IsolateGroupData() {
   kernel_buffer_size_ = 0;
 }
 
+void IsolateGroupData::SetKernelBufferMapped(MappedMemory* mapping,
+                                             intptr_t size) {
+  ASSERT(kernel_buffer_.get() == NULL);
+  kernel_buffer_ = std::shared_ptr<uint8_t>(
+      reinterpret_cast<uint8_t*>(mapping->address()),
+      [mapping](uint8_t*) { delete mapping; });
+  kernel_buffer_size_ = size;
+  kernel_buffer_mapped_ = true;
+}
+
 IsolateData::IsolateData(IsolateGroupData* isolate_group_data)
     : isolate_group_data_(isolate_group_data),
       loader_(nullptr),
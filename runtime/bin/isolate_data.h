@@ -27,6 +27,7 @@ namespace bin {
 class AppSnapshot;
 class EventHandler;
 class Loader;
+class MappedMemory;
 
 // Data associated with every isolate group in the standalone VM
 // embedding. This is used to free external resources for each isolate
@@ -66,6 +67,15 @@ class IsolateGroupData {
     kernel_buffer_size_ = size;
   }
 
+  // Associate the given memory mapped kernel buffer with this IsolateGroupData
+  // and give it ownership of the mapping. This IsolateGroupData is the first
+  // one to own the mapping.
+  void SetKernelBufferMapped(MappedMemory* mapping, intptr_t size);
+
+  // Whether the kernel buffer is a mapping of the script file, whose pages
+  // are only read when they are used.
+  bool kernel_buffer_mapped() const { return kernel_buffer_mapped_; }
+
   // Associate the given kernel buffer with this IsolateGroupData and give it
   // ownership of the buffer. The buffer is already owned by another
   // IsolateGroupData.
@@ -104,6 +114,7 @@ class IsolateGroupData {
   char* resolved_packages_config_;
   std::shared_ptr<uint8_t> kernel_buffer_;
   intptr_t kernel_buffer_size_;
+  bool kernel_buffer_mapped_ = false;
   char* packages_file_ = nullptr;
   bool isolate_run_app_snapshot_;
 
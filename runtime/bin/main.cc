@@ -23,6 +23,7 @@
 #include "bin/extensions.h"
 #include "bin/file.h"
 #include "bin/gzip.h"
+#include "bin/io_buffer.h"
 #include "bin/isolate_data.h"
 #include "bin/loader.h"
 #include "bin/main_options.h"
@@ -160,7 +161,164 @@ static void WriteDepsFile(Dart_Isolate isolate) {
   file->Release();
 }
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+// The type feedback file of the main isolate in the --jit-cache directory, or
+// NULL if there is none. Its name contains a hash of the program's kernel, or
+// of the path, size and modification time of its kernel file, so feedback
+// recorded for another build of the program is never loaded.
+static char* jit_cache_filename = NULL;
+
+static uint64_t HashBytes(uint64_t hash, const uint8_t* buffer, intptr_t size) {
+  // FNV-1a over 64-bit words.
+  const uint64_t kPrime = 1099511628211ULL;
+  intptr_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    memmove(&word, buffer + i, sizeof(word));
+    hash = (hash ^ word) * kPrime;
+  }
+  for (; i < size; i++) {
+    hash = (hash ^ buffer[i]) * kPrime;
+  }
+  return hash ^ static_cast<uint64_t>(size);
+}
+
+static uint64_t HashKernel(const char* script_name,
+                           IsolateGroupData* isolate_group_data) {
+  const uint64_t kOffsetBasis = 14695981039346656037ULL;
+  if (isolate_group_data->kernel_buffer_mapped()) {
+    // Hashing the contents would read all of the mapped kernel file, most of
+    // which a program never uses.
+    int64_t stat[File::kStatSize];
+    File::Stat(NULL, script_name, stat);
+    const char* path = File::GetCanonicalPath(NULL, script_name);
+    if ((stat[File::kType] == File::kIsFile) && (path != NULL)) {
+      const int64_t version[] = {stat[File::kSize], stat[File::kModifiedTime]};
+      uint64_t hash = HashBytes(
+          kOffsetBasis, reinterpret_cast<const uint8_t*>(path), strlen(path));
+      return HashBytes(hash, reinterpret_cast<const uint8_t*>(version),
+                       sizeof(version));
+    }
+  }
+  // Compiled from source, or read from a list of kernel files, so the
+  // kernel is already in memory.
+  return HashBytes(kOffsetBasis, isolate_group_data->kernel_buffer().get(),
+                   isolate_group_data->kernel_buffer_size());
+}
+
+static void LoadJitCache(const char* script_name, Dart_Isolate isolate) {
+  if (Options::jit_cache_directory() == NULL) {
+    return;
+  }
+  auto isolate_group_data =
+      reinterpret_cast<IsolateGroupData*>(Dart_IsolateGroupData(isolate));
+  if (isolate_group_data->kernel_buffer().get() == NULL) {
+    // Started from an app snapshot, which already contains code.
+    return;
+  }
+  uint64_t hash = HashKernel(script_name, isolate_group_data);
+  jit_cache_filename = Utils::SCreate("%s%s%016" Px64 ".feedback",
+                                      Options::jit_cache_directory(),
+                                      File::PathSeparator(), hash);
+  File* file = File::Open(NULL, jit_cache_filename, File::kRead);
+  if (file == NULL) {
+    // The first run of this program.
+    return;
+  }
+  RefCntReleaseScope<File> rs(file);
+  intptr_t size = file->Length();
+  if (size <= 0) {
+    return;
+  }
+  uint8_t* buffer = reinterpret_cast<uint8_t*>(malloc(size));
+  if (file->ReadFully(buffer, size)) {
+    Dart_Handle result = Dart_LoadTypeFeedback(buffer, size);
+    if (Dart_IsError(result)) {
+      // E.g. written by another VM version. It is replaced on exit.
+      Syslog::PrintErr("Ignoring JIT cache %s: %s\n", jit_cache_filename,
+                       Dart_GetError(result));
+    }
+  }
+  free(buffer);
+}
+
+static void SaveJitCache() {
+  if (jit_cache_filename == NULL) {
+    return;
+  }
+  uint8_t* buffer = NULL;
+  intptr_t size = 0;
+  Dart_Handle result = Dart_SaveTypeFeedback(&buffer, &size);
+  if (Dart_IsError(result)) {
+    Syslog::PrintErr("Unable to save JIT cache %s: %s\n", jit_cache_filename,
+                     Dart_GetError(result));
+    return;
+  }
+  // Written to a temporary file that replaces the cache, so neither a crash
+  // nor another instance of the program leaves a truncated cache behind.
+  char* temp_filename = Utils::SCreate("%s.%" Pd ".tmp", jit_cache_filename,
+                                       Process::CurrentProcessId());
+  File* file = File::Open(NULL, temp_filename, File::kWriteTruncate);
+  bool success = (file != NULL) && file->WriteFully(buffer, size);
+  if (file != NULL) {
+    file->Release();
+  }
+  success = success && File::Rename(NULL, temp_filename, jit_cache_filename);
+  if (!success) {
+    Syslog::PrintErr("Unable to write JIT cache %s\n", jit_cache_filename);
+    File::Delete(NULL, temp_filename);
+  }
+  free(temp_filename);
+}
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+// Phases of embedder startup that run before the VM, and with it the
+// timeline, is initialized. They are added to the timeline once it is.
+struct StartupPhase {
+  const char* name;
+  int64_t start;
+  int64_t end;
+};
+static const intptr_t kMaxStartupPhases = 8;
+static StartupPhase startup_phases[kMaxStartupPhases];
+static intptr_t startup_phases_count = 0;
+
+static void RecordStartupPhase(const char* name, int64_t start) {
+  ASSERT(startup_phases_count < kMaxStartupPhases);
+  StartupPhase* phase = &startup_phases[startup_phases_count++];
+  phase->name = name;
+  phase->start = start;
+  phase->end = TimerUtils::GetCurrentMonotonicMicros();
+}
+
+static void AddStartupPhasesToTimeline() {
+  for (intptr_t i = 0; i < startup_phases_count; i++) {
+    Dart_TimelineEvent(startup_phases[i].name, startup_phases[i].start,
+                       startup_phases[i].end, Dart_Timeline_Event_Duration, 0,
+                       NULL, NULL);
+  }
+  startup_phases_count = 0;
+}
+
+static void WriteStartupTrace() {
+  const char* filename = Options::startup_trace_filename();
+  if (filename == NULL) {
+    return;
+  }
+  if (!Dart_TimelineWriteToFile(filename)) {
+    Syslog::PrintErr("Unable to write startup trace %s\n", filename);
+  }
+}
+
 static void OnExitHook(int64_t exit_code) {
+  // Written first, as a hard exit of a secondary isolate returns early.
+  WriteStartupTrace();
+  if ((Dart_CurrentIsolate() != main_isolate) &&
+      (Options::gen_snapshot_kind() != kAppJIT) &&
+      (Options::depfile() == NULL)) {
+    // Only the main isolate's JIT cache is saved, which is done as it exits.
+    return;
+  }
   if (Dart_CurrentIsolate() != main_isolate) {
     Syslog::PrintErr(
         "A snapshot was requested, but a secondary isolate "
@@ -173,6 +331,10 @@ static void OnExitHook(int64_t exit_code) {
       Snapshot::GenerateAppJIT(Options::snapshot_filename());
     }
     WriteDepsFile(main_isolate);
+#if !defined(DART_PRECOMPILED_RUNTIME)
+    // A failed run keeps the cache of the last successful one.
+    SaveJitCache();
+#endif
   }
 }
 
@@ -607,6 +769,7 @@ static Dart_Isolate CreateIsolateGroupAndSetupHelper(
   uint8_t* kernel_buffer = NULL;
   std::shared_ptr<uint8_t> parent_kernel_buffer;
   intptr_t kernel_buffer_size = 0;
+  MappedMemory* kernel_mapping = NULL;
   AppSnapshot* app_snapshot = NULL;
 
 #if defined(DART_PRECOMPILED_RUNTIME)
@@ -649,7 +812,10 @@ static Dart_Isolate CreateIsolateGroupAndSetupHelper(
   }
 
   if (kernel_buffer == NULL && !isolate_run_app_snapshot) {
-    dfe.ReadScript(script_uri, &kernel_buffer, &kernel_buffer_size);
+    // Each isolate group maps the script itself, which shares the pages with
+    // the startup mapping and lets the group unmap it when it shuts down.
+    dfe.ReadScript(script_uri, &kernel_buffer, &kernel_buffer_size,
+                   &kernel_mapping);
   }
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
@@ -660,6 +826,9 @@ static Dart_Isolate CreateIsolateGroupAndSetupHelper(
     if (parent_kernel_buffer) {
       isolate_group_data->SetKernelBufferAlreadyOwned(
           std::move(parent_kernel_buffer), kernel_buffer_size);
+    } else if (kernel_mapping != NULL) {
+      isolate_group_data->SetKernelBufferMapped(kernel_mapping,
+                                                kernel_buffer_size);
     } else {
       isolate_group_data->SetKernelBufferNewlyOwned(kernel_buffer,
                                                     kernel_buffer_size);
@@ -933,6 +1102,9 @@ bool RunMainIsolate(const char* script_name, CommandLineOptions* dart_options) {
       free(buffer);
       CHECK_RESULT(result);
     }
+#if !defined(DART_PRECOMPILED_RUNTIME)
+    LoadJitCache(script_name, isolate);
+#endif
 
     // Create a closure for the main entry point which is in the exported
     // namespace of the root library or invoke a getter of the same name
@@ -983,6 +1155,11 @@ bool RunMainIsolate(const char* script_name, CommandLineOptions* dart_options) {
       CHECK_RESULT(result);
       WriteFile(Options::save_type_feedback_filename(), buffer, size);
     }
+#if !defined(DART_PRECOMPILED_RUNTIME)
+    if (Process::GlobalExitCode() == 0) {
+      SaveJitCache();
+    }
+#endif
   }
 
   WriteDepsFile(isolate);
@@ -1027,6 +1204,11 @@ void main(int argc, char** argv) {
   bool print_flags_seen = false;
   bool verbose_debug_seen = false;
 
+  // Timestamps taken before the VM is initialized use the same clock as the
+  // timeline.
+  TimerUtils::InitOnce();
+  int64_t start = TimerUtils::GetCurrentMonotonicMicros();
+
   // Perform platform specific initialization.
   if (!Platform::Initialize()) {
     Syslog::PrintErr("Initialization failed\n");
@@ -1107,6 +1289,8 @@ void main(int argc, char** argv) {
     }
   }
   DartUtils::SetEnvironment(Options::environment());
+  RecordStartupPhase("ParseArguments", start);
+  start = TimerUtils::GetCurrentMonotonicMicros();
 
   if (Options::suppress_core_dump()) {
     Platform::SetCoreDumpResourceLimit(0);
@@ -1138,35 +1322,61 @@ void main(int argc, char** argv) {
       (Options::depfile() != NULL)) {
     Process::SetExitHook(OnExitHook);
   }
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  if (Options::jit_cache_directory() != NULL) {
+    // Feedback is loaded on every start, and optimizing all of it up front
+    // would only move the warm up to startup. Feedback given explicitly is
+    // still optimized up front.
+    if (Options::load_type_feedback_filename() == NULL) {
+      vm_options.AddArgument("--no-optimize_loaded_type_feedback");
+    }
+    Process::SetExitHook(OnExitHook);
+  }
+#endif
+  if (Options::startup_trace_filename() != NULL) {
+    // The startup recorder keeps the events of all streams until the trace
+    // is written, as exit() does not return here.
+    vm_options.AddArgument("--startup_timeline");
+    Process::SetExitHook(OnExitHook);
+  }
+  RecordStartupPhase("LoadAppSnapshot", start);
 
+  start = TimerUtils::GetCurrentMonotonicMicros();
   char* error = nullptr;
   if (!dart::embedder::InitOnce(&error)) {
     Syslog::PrintErr("Standalone embedder initialization failed: %s\n", error);
     free(error);
     Platform::Exit(kErrorExitCode);
   }
+  RecordStartupPhase("embedder::InitOnce", start);
 
+  start = TimerUtils::GetCurrentMonotonicMicros();
   error = Dart_SetVMFlags(vm_options.count(), vm_options.arguments());
   if (error != NULL) {
     Syslog::PrintErr("Setting VM flags failed: %s\n", error);
     free(error);
     Platform::Exit(kErrorExitCode);
   }
+  RecordStartupPhase("Dart_SetVMFlags", start);
 
 // Note: must read platform only *after* VM flags are parsed because
 // they might affect how the platform is loaded.
 #if !defined(DART_PRECOMPILED_RUNTIME)
+  start = TimerUtils::GetCurrentMonotonicMicros();
   dfe.Init(Options::target_abi_version());
   uint8_t* application_kernel_buffer = NULL;
   intptr_t application_kernel_buffer_size = 0;
+  MappedMemory* application_kernel_mapping = NULL;
   dfe.ReadScript(script_name, &application_kernel_buffer,
-                 &application_kernel_buffer_size);
+                 &application_kernel_buffer_size, &application_kernel_mapping);
   if (application_kernel_buffer != NULL) {
     // Since we loaded the script anyway, save it.
     dfe.set_application_kernel_buffer(application_kernel_buffer,
-                                      application_kernel_buffer_size);
+                                      application_kernel_buffer_size,
+                                      application_kernel_mapping);
     Options::dfe()->set_use_dfe();
   }
+  RecordStartupPhase("ReadScript", start);
 #endif
 
   // Initialize the Dart VM.
@@ -1193,6 +1403,7 @@ void main(int argc, char** argv) {
   init_params.start_kernel_isolate = false;
 #endif
 
+  start = TimerUtils::GetCurrentMonotonicMicros();
   error = Dart_Initialize(&init_params);
   if (error != NULL) {
     EventHandler::Stop();
@@ -1200,6 +1411,8 @@ void main(int argc, char** argv) {
     free(error);
     Platform::Exit(kErrorExitCode);
   }
+  RecordStartupPhase("Dart_Initialize", start);
+  AddStartupPhasesToTimeline();
 
   Dart_SetServiceStreamCallbacks(&ServiceStreamListenCallback,
                                  &ServiceStreamCancelCallback);
@@ -1214,6 +1427,7 @@ void main(int argc, char** argv) {
   // Terminate process exit-code handler.
   Process::TerminateExitCodeHandler();
 
+  WriteStartupTrace();
   error = Dart_Cleanup();
   if (error != NULL) {
     Syslog::PrintErr("VM cleanup failed: %s\n", error);
@@ -1221,6 +1435,7 @@ void main(int argc, char** argv) {
   }
   Process::ClearAllSignalHandlers();
   EventHandler::Stop();
+  IOBufferPool::Cleanup();
 
   delete app_snapshot;
   free(app_script_uri);
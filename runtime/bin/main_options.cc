@@ -215,6 +215,14 @@ void Options::PrintUsage() {
 "--root-certs-cache=<path>\n"
 "  The path to a cache directory containing the trusted root certificates to\n"
 "  use for secure socket connections.\n"
+"--jit-cache=<path>\n"
+"  The path to a directory where type feedback is kept between runs of a\n"
+"  program started from kernel, so hot functions are optimized on their first\n"
+"  call instead of after warming up again.\n"
+"--startup-trace=<file>\n"
+"  Records how long each phase of starting the VM and the program takes, up\n"
+"  to the first call of main, and writes it to <file> in the Chrome trace\n"
+"  event format when the program exits.\n"
 #if defined(HOST_OS_LINUX) || \
     defined(HOST_OS_ANDROID) || \
     defined(HOST_OS_FUCHSIA)
@@ -28,6 +28,8 @@ namespace bin {
   V(load_compilation_trace, load_compilation_trace_filename)                   \
   V(save_type_feedback, save_type_feedback_filename)                           \
   V(load_type_feedback, load_type_feedback_filename)                           \
+  V(jit_cache, jit_cache_directory)                                            \
+  V(startup_trace, startup_trace_filename)                                     \
   V(root_certs_file, root_certs_file)                                          \
   V(root_certs_cache, root_certs_cache)                                        \
   V(namespace, namespc)                                                        \
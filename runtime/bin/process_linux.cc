@@ -10,9 +10,12 @@
 #include <errno.h>         // NOLINT
 #include <fcntl.h>         // NOLINT
 #include <poll.h>          // NOLINT
+#include <sched.h>         // NOLINT
+#include <signal.h>        // NOLINT
 #include <stdio.h>         // NOLINT
 #include <stdlib.h>        // NOLINT
 #include <string.h>        // NOLINT
+#include <sys/mman.h>      // NOLINT
 #include <sys/resource.h>  // NOLINT
 #include <sys/wait.h>      // NOLINT
 #include <unistd.h>        // NOLINT
@@ -27,6 +30,7 @@
 #include "platform/syslog.h"
 
 #include "platform/signal_blocker.h"
+#include "platform/thread_sanitizer.h"
 #include "platform/utils.h"
 
 extern char** environ;
@@ -70,6 +74,11 @@ class ProcessInfoList {
  public:
   static void AddProcess(pid_t pid, intptr_t fd) {
     MutexLocker locker(mutex_);
+    AddProcessLocked(pid, fd);
+  }
+
+  // Same as AddProcess, for callers already holding mutex().
+  static void AddProcessLocked(pid_t pid, intptr_t fd) {
     ProcessInfo* info = new ProcessInfo(pid, fd);
     info->set_next(active_processes_);
     active_processes_ = info;
@@ -106,6 +115,10 @@ class ProcessInfoList {
     }
   }
 
+  // Holding this mutex while starting a process and adding it keeps the exit
+  // code handler from looking up the pid before it is in the list.
+  static Mutex* mutex() { return mutex_; }
+
  private:
   // Linked list of ProcessInfo objects for all active processes
   // started from Dart code.
@@ -243,6 +256,10 @@ int ExitCodeHandler::process_count_ = 0;
 bool ExitCodeHandler::terminate_done_ = false;
 Monitor* ExitCodeHandler::monitor_ = new Monitor();
 
+// Used when searching for and running a program the way execvp does.
+static const char* const kShellPath = "/bin/sh";
+static const char* const kDefaultSearchPath = "/bin:/usr/bin";
+
 class ProcessStarter {
  public:
   ProcessStarter(Namespace* namespc,
@@ -268,7 +285,12 @@ class ProcessStarter {
         err_(err),
         id_(id),
         exit_event_(exit_event),
-        os_error_message_(os_error_message) {
+        os_error_message_(os_error_message),
+        working_directory_fd_(-1),
+        exec_path_(NULL),
+        exec_environment_(NULL),
+        search_path_(NULL),
+        shell_arguments_(NULL) {
     read_in_[0] = -1;
     read_in_[1] = -1;
     read_err_[0] = -1;
@@ -304,37 +326,14 @@ class ProcessStarter {
       return err;
     }
 
-    // Fork to create the new process.
-    pid_t pid = TEMP_FAILURE_RETRY(fork());
-    if (pid < 0) {
-      // Failed to fork.
-      return CleanupAndReturnError();
-    } else if (pid == 0) {
-      // This runs in the new process.
-      NewProcess();
-    }
-
-    // This runs in the original process.
-
-    // If the child process is not started in detached mode, be sure to
-    // listen for exit-codes, now that we have a non detached child process
-    // and also Register this child process.
-    if (Process::ModeIsAttached(mode_)) {
-      ExitCodeHandler::ProcessStarted();
-      err = RegisterProcess(pid);
-      if (err != 0) {
-        return err;
-      }
+    pid_t pid;
+    if (CanSpawn()) {
+      err = SpawnProcess(&pid);
+    } else {
+      err = ForkProcess(&pid);
     }
-
-    // Notify child process to start. This is done to delay the call to exec
-    // until the process is registered above, and we are ready to receive the
-    // exit code.
-    char msg = '1';
-    int bytes_written =
-        FDUtils::WriteToBlocking(read_in_[1], &msg, sizeof(msg));
-    if (bytes_written != sizeof(msg)) {
-      return CleanupAndReturnError();
+    if (err != 0) {
+      return err;
     }
 
     // Read the result of executing the child process.
@@ -391,6 +390,263 @@ class ProcessStarter {
   }
 
  private:
+  // Starts the process with fork(). This copies the page tables of this
+  // process, so it is only used where SpawnProcess cannot be.
+  int ForkProcess(pid_t* pid_result) {
+    // Fork to create the new process.
+    pid_t pid = TEMP_FAILURE_RETRY(fork());
+    if (pid < 0) {
+      // Failed to fork.
+      return CleanupAndReturnError();
+    } else if (pid == 0) {
+      // This runs in the new process.
+      NewProcess();
+    }
+
+    // This runs in the original process.
+
+    // If the child process is not started in detached mode, be sure to
+    // listen for exit-codes, now that we have a non detached child process
+    // and also Register this child process.
+    if (Process::ModeIsAttached(mode_)) {
+      ExitCodeHandler::ProcessStarted();
+      int err = RegisterProcess(pid);
+      if (err != 0) {
+        return err;
+      }
+    }
+
+    // Notify child process to start. This is done to delay the call to exec
+    // until the process is registered above, and we are ready to receive the
+    // exit code.
+    char msg = '1';
+    int bytes_written =
+        FDUtils::WriteToBlocking(read_in_[1], &msg, sizeof(msg));
+    if (bytes_written != sizeof(msg)) {
+      return CleanupAndReturnError();
+    }
+
+    *pid_result = pid;
+    return 0;
+  }
+
+  // Attached processes are started with clone(CLONE_VM | CLONE_VFORK) so
+  // that starting a process does not get slower, or fail on hosts without
+  // overcommit, as the heap of this process grows. Detached processes need
+  // the intermediate processes set up by ExecDetachedProcess.
+  bool CanSpawn() const {
+#if defined(USING_THREAD_SANITIZER)
+    // TSAN does not understand a child sharing the memory of its parent.
+    return false;
+#else
+    return Process::ModeIsAttached(mode_);
+#endif
+  }
+
+  // Starts the process without copying the address space of this process.
+  // The child runs on a stack of its own in the memory of this process, and
+  // this thread is suspended until the child has called exec or exited.
+  // Everything that could allocate or take locks, like resolving paths
+  // through the namespace, is therefore done here before the child starts,
+  // and the child only uses async-signal-safe calls.
+  int SpawnProcess(pid_t* pid_result) {
+    if (working_directory_ != NULL) {
+      NamespaceScope ns(namespc_, working_directory_);
+      working_directory_fd_ = TEMP_FAILURE_RETRY(
+          openat64(ns.fd(), ns.path(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+      if (working_directory_fd_ == -1) {
+        return CleanupAndReturnError();
+      }
+    }
+
+    char realpath[PATH_MAX];
+    if (!FindPathInNamespace(realpath, PATH_MAX, working_directory_fd_)) {
+      return CleanupAndReturnError();
+    }
+    exec_path_ = realpath;
+    exec_environment_ =
+        (program_environment_ != NULL) ? program_environment_ : environ;
+    if (strchr(exec_path_, '/') == NULL) {
+      search_path_ = FindSearchPath(exec_environment_);
+    }
+
+    // Arguments for running the program as a shell script if exec fails with
+    // ENOEXEC, like execvp does. The child fills in the script path.
+    intptr_t arguments_length = 0;
+    while (program_arguments_[arguments_length] != NULL) {
+      arguments_length++;
+    }
+    shell_arguments_ = reinterpret_cast<char**>(Dart_ScopeAllocate(
+        (arguments_length + 2) * sizeof(*shell_arguments_)));
+    shell_arguments_[0] = const_cast<char*>(kShellPath);
+    shell_arguments_[1] = NULL;
+    for (intptr_t i = 1; i <= arguments_length; i++) {
+      shell_arguments_[i + 1] = program_arguments_[i];
+    }
+
+    int event_fds[2];
+    if (TEMP_FAILURE_RETRY(pipe2(event_fds, O_CLOEXEC)) < 0) {
+      return CleanupAndReturnError();
+    }
+
+    void* stack = mmap(NULL, kChildStackSize, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (stack == MAP_FAILED) {
+      int saved_errno = errno;
+      close(event_fds[0]);
+      close(event_fds[1]);
+      errno = saved_errno;
+      return CleanupAndReturnError();
+    }
+
+    // Block all signals while the child shares our memory. The child resets
+    // the handlers before restoring the signal mask.
+    sigset_t all_signals;
+    sigfillset(&all_signals);
+    pthread_sigmask(SIG_BLOCK, &all_signals, &parent_signal_mask_);
+    pid_t pid;
+    {
+      MutexLocker locker(ProcessInfoList::mutex());
+      pid = clone(SpawnedProcessEntry,
+                  reinterpret_cast<uint8_t*>(stack) + kChildStackSize,
+                  CLONE_VM | CLONE_VFORK | SIGCHLD, this);
+      if (pid > 0) {
+        ProcessInfoList::AddProcessLocked(pid, event_fds[1]);
+        ExitCodeHandler::ProcessStarted();
+      }
+    }
+    int saved_errno = errno;
+    pthread_sigmask(SIG_SETMASK, &parent_signal_mask_, NULL);
+    munmap(stack, kChildStackSize);
+    exec_path_ = NULL;
+
+    if (pid < 0) {
+      close(event_fds[0]);
+      close(event_fds[1]);
+      errno = saved_errno;
+      return CleanupAndReturnError();
+    }
+    *exit_event_ = event_fds[0];
+    FDUtils::SetNonBlocking(event_fds[0]);
+    CloseWorkingDirectory();
+    *pid_result = pid;
+    return 0;
+  }
+
+  static int SpawnedProcessEntry(void* starter) {
+    reinterpret_cast<ProcessStarter*>(starter)->ExecSpawnedProcess();
+    return 1;  // Not reached.
+  }
+
+  // Runs in the child started by SpawnProcess.
+  void ExecSpawnedProcess() {
+    // The handlers of this process must not run in the child, as they would
+    // modify the memory of the parent.
+    for (int signal = 1; signal < NSIG; signal++) {
+      struct sigaction action;
+      if ((sigaction(signal, NULL, &action) == 0) &&
+          (action.sa_handler != SIG_IGN) && (action.sa_handler != SIG_DFL)) {
+        action.sa_handler = SIG_DFL;
+        action.sa_flags = 0;
+        sigemptyset(&action.sa_mask);
+        sigaction(signal, &action, NULL);
+      }
+    }
+    sigprocmask(SIG_SETMASK, &parent_signal_mask_, NULL);
+
+    if (mode_ == kNormal) {
+      if (TEMP_FAILURE_RETRY(dup2(write_out_[0], STDIN_FILENO)) == -1) {
+        ReportChildError();
+      }
+
+      if (TEMP_FAILURE_RETRY(dup2(read_in_[1], STDOUT_FILENO)) == -1) {
+        ReportChildError();
+      }
+
+      if (TEMP_FAILURE_RETRY(dup2(read_err_[1], STDERR_FILENO)) == -1) {
+        ReportChildError();
+      }
+    } else {
+      ASSERT(mode_ == kInheritStdio);
+    }
+
+    if ((working_directory_fd_ != -1) &&
+        (NO_RETRY_EXPECTED(fchdir(working_directory_fd_)) == -1)) {
+      ReportChildError();
+    }
+
+    if (search_path_ == NULL) {
+      ExecWithShellFallback(exec_path_);
+      ReportChildError();
+    }
+
+    // Search the PATH of the new environment the same way execvp does.
+    if (exec_path_[0] == '\0') {
+      errno = ENOENT;
+      ReportChildError();
+    }
+    const intptr_t file_length = strlen(exec_path_);
+    char candidate[PATH_MAX];
+    bool access_denied = false;
+    const char* directory = search_path_;
+    while (true) {
+      const char* end = strchr(directory, ':');
+      if (end == NULL) {
+        end = directory + strlen(directory);
+      }
+      intptr_t length = end - directory;
+      if (length + file_length + 2 <= PATH_MAX) {
+        if (length > 0) {
+          memmove(candidate, directory, length);
+          candidate[length++] = '/';
+        }
+        memmove(candidate + length, exec_path_, file_length + 1);
+        ExecWithShellFallback(candidate);
+        if (errno == EACCES) {
+          access_denied = true;
+        } else if ((errno != ENOENT) && (errno != ENOTDIR)) {
+          ReportChildError();
+        }
+      }
+      if (*end == '\0') {
+        break;
+      }
+      directory = end + 1;
+    }
+    if (access_denied) {
+      errno = EACCES;
+    }
+    ReportChildError();
+  }
+
+  // Only returns if exec failed.
+  void ExecWithShellFallback(char* path) {
+    VOID_TEMP_FAILURE_RETRY(execve(
+        path, const_cast<char* const*>(program_arguments_), exec_environment_));
+    if (errno == ENOEXEC) {
+      shell_arguments_[1] = path;
+      VOID_TEMP_FAILURE_RETRY(
+          execve(kShellPath, const_cast<char* const*>(shell_arguments_),
+                 exec_environment_));
+    }
+  }
+
+  static const char* FindSearchPath(char** environment) {
+    for (char** entry = environment; *entry != NULL; entry++) {
+      if (strncmp(*entry, "PATH=", 5) == 0) {
+        return *entry + 5;
+      }
+    }
+    return kDefaultSearchPath;
+  }
+
+  void CloseWorkingDirectory() {
+    if (working_directory_fd_ != -1) {
+      close(working_directory_fd_);
+      working_directory_fd_ = -1;
+    }
+  }
+
   int CreatePipes() {
     int result;
     result = TEMP_FAILURE_RETRY(pipe2(exec_control_, O_CLOEXEC));
@@ -437,11 +693,14 @@ class ProcessStarter {
   }
 
   // Tries to find path_ relative to the current namespace unless it should be
-  // searched in the PATH.
+  // searched in the PATH. If cwd_fd is not -1 a relative path_ is resolved
+  // against it instead of the current directory of the namespace.
   // The path that should be passed to exec is returned in realpath.
   // Returns true on success, and false if there was an error that should
   // be reported to the parent.
-  bool FindPathInNamespace(char* realpath, intptr_t realpath_size) {
+  bool FindPathInNamespace(char* realpath,
+                           intptr_t realpath_size,
+                           intptr_t cwd_fd = -1) {
     // Perform a PATH search if there's no slash in the path.
     if (strchr(path_, '/') == NULL) {
       // TODO(zra): If there is a non-default namespace, the entries in PATH
@@ -451,8 +710,14 @@ class ProcessStarter {
       return true;
     }
     NamespaceScope ns(namespc_, path_);
+    intptr_t dirfd = ns.fd();
+    const char* path = ns.path();
+    if ((cwd_fd != -1) && !File::IsAbsolutePath(path_)) {
+      dirfd = cwd_fd;
+      path = path_;
+    }
     const int fd =
-        TEMP_FAILURE_RETRY(openat64(ns.fd(), ns.path(), O_RDONLY | O_CLOEXEC));
+        TEMP_FAILURE_RETRY(openat64(dirfd, path, O_RDONLY | O_CLOEXEC));
     if (fd == -1) {
       return false;
     }
@@ -696,6 +961,7 @@ class ProcessStarter {
     }
     SetChildOsErrorMessage();
     CloseAllPipes();
+    CloseWorkingDirectory();
     return actual_errno;
   }
 
@@ -783,6 +1049,15 @@ class ProcessStarter {
   intptr_t* exit_event_;
   char** os_error_message_;
 
+  // State prepared by SpawnProcess for the child.
+  static const intptr_t kChildStackSize = 64 * KB;
+  intptr_t working_directory_fd_;
+  char* exec_path_;
+  char** exec_environment_;
+  const char* search_path_;
+  char** shell_arguments_;
+  sigset_t parent_signal_mask_;
+
   DISALLOW_ALLOCATION();
   DISALLOW_IMPLICIT_CONSTRUCTORS(ProcessStarter);
 };
@@ -188,6 +188,50 @@ void FUNCTION_NAME(SecureSocket_FilterPointer)(Dart_NativeArguments args) {
   Dart_SetReturnValue(args, Dart_NewInteger(filter_pointer));
 }
 
+/**
+ * Pushes data through the SSL filter synchronously on the calling isolate's
+ * thread. This is the same operation as ProcessFilterRequest below, used by
+ * Dart code for small amounts of pending data where the round trip through
+ * the IO Service costs more than the filtering itself.
+ *
+ * The start and end positions of the four circular buffers are passed in a
+ * Dart list, which is updated in place and returned on success. On failure a
+ * list of the error code and error message is returned instead.
+ */
+void FUNCTION_NAME(SecureSocket_ProcessAllBuffers)(Dart_NativeArguments args) {
+  SSLFilter* filter = GetFilter(args);
+  bool in_handshake =
+      DartUtils::GetBooleanValue(Dart_GetNativeArgument(args, 1));
+  Dart_Handle positions = ThrowIfError(Dart_GetNativeArgument(args, 2));
+  int starts[SSLFilter::kNumBuffers];
+  int ends[SSLFilter::kNumBuffers];
+  for (int i = 0; i < SSLFilter::kNumBuffers; ++i) {
+    starts[i] = static_cast<int>(DartUtils::GetIntegerValue(
+        ThrowIfError(Dart_ListGetAt(positions, 2 * i))));
+    ends[i] = static_cast<int>(DartUtils::GetIntegerValue(
+        ThrowIfError(Dart_ListGetAt(positions, 2 * i + 1))));
+  }
+
+  if (filter->ProcessAllBuffers(starts, ends, in_handshake)) {
+    for (int i = 0; i < SSLFilter::kNumBuffers; ++i) {
+      ThrowIfError(
+          Dart_ListSetAt(positions, 2 * i, Dart_NewInteger(starts[i])));
+      ThrowIfError(
+          Dart_ListSetAt(positions, 2 * i + 1, Dart_NewInteger(ends[i])));
+    }
+    Dart_SetReturnValue(args, positions);
+  } else {
+    int32_t error_code = static_cast<int32_t>(ERR_peek_error());
+    TextBuffer error_string(SecureSocketUtils::SSL_ERROR_MESSAGE_BUFFER_SIZE);
+    SecureSocketUtils::FetchErrorString(filter->ssl(), &error_string);
+    Dart_Handle result = ThrowIfError(Dart_NewList(2));
+    ThrowIfError(Dart_ListSetAt(result, 0, Dart_NewInteger(error_code)));
+    ThrowIfError(Dart_ListSetAt(result, 1,
+                                DartUtils::NewString(error_string.buf())));
+    Dart_SetReturnValue(args, result);
+  }
+}
+
 /**
  * Pushes data through the SSL filter, reading and writing from circular
  * buffers shared with Dart.
@@ -6,6 +6,7 @@
 
 #include "bin/dartutils.h"
 #include "bin/eventhandler.h"
+#include "bin/file.h"
 #include "bin/io_buffer.h"
 #include "bin/isolate_data.h"
 #include "bin/lockers.h"
@@ -344,45 +345,126 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
     if (Socket::short_socket_read()) {
       length = (length + 1) / 2;
     }
-    uint8_t* buffer = NULL;
-    Dart_Handle result = IOBuffer::Allocate(length, &buffer);
-    if (Dart_IsNull(result)) {
+    // Read into pooled storage and hand it out as is, even on a short read.
+    // The storage goes back to the pool when the resulting list is collected.
+    uint8_t* buffer = IOBufferPool::Allocate(length);
+    if (buffer == NULL) {
       Dart_SetReturnValue(args, DartUtils::NewDartOSError());
       return;
     }
+    intptr_t bytes_read =
+        SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
+    if (bytes_read > 0) {
+      Dart_SetReturnValue(
+          args, IOBufferPool::NewExternalTypedData(buffer, bytes_read));
+      return;
+    }
+    // Capture errno before releasing the storage.
+    Dart_Handle result = (bytes_read == 0)
+                             ? Dart_Null()
+                             : DartUtils::NewDartOSError();
+    IOBufferPool::Free(buffer);
+    // On MacOS when reading from a tty Ctrl-D will result in reading one
+    // less byte then reported as available.
+    ASSERT((bytes_read == 0) || (bytes_read == -1));
+    Dart_SetReturnValue(args, result);
+  } else {
+    OSError os_error(-1, "Invalid argument", OSError::kUnknown);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+  }
+}
+
+void FUNCTION_NAME(Socket_ReadInto)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  Dart_Handle buffer_obj = Dart_GetNativeArgument(args, 1);
+  ASSERT(Dart_IsList(buffer_obj));
+  // start and end arguments are checked in Dart code to be
+  // integers and have the property that end <=
+  // list.length. Therefore, it is safe to extract their value as
+  // intptr_t.
+  intptr_t start = DartUtils::GetNativeIntptrArgument(args, 2);
+  intptr_t end = DartUtils::GetNativeIntptrArgument(args, 3);
+  intptr_t length = end - start;
+  if (Socket::short_socket_read()) {
+    length = (length + 1) / 2;
+  }
+  intptr_t bytes_read = 0;
+  Dart_TypedData_Type type = Dart_GetTypeOfTypedData(buffer_obj);
+  if (type == Dart_TypedData_kInvalid) {
+    type = Dart_GetTypeOfExternalTypedData(buffer_obj);
+  }
+  if ((type == Dart_TypedData_kUint8) || (type == Dart_TypedData_kInt8)) {
+    // Read straight into the caller's typed data. The read is non-blocking,
+    // so holding on to the data pointer while in the system call is fine.
+    uint8_t* data = NULL;
+    intptr_t data_length = 0;
+    Dart_Handle result = Dart_TypedDataAcquireData(
+        buffer_obj, &type, reinterpret_cast<void**>(&data), &data_length);
     if (Dart_IsError(result)) {
       Dart_PropagateError(result);
     }
-    ASSERT(buffer != NULL);
-    intptr_t bytes_read =
+    ASSERT(end <= data_length);
+    bytes_read = SocketBase::Read(socket->fd(), data + start, length,
+                                  SocketBase::kAsync);
+    // Capture errno before releasing the data, which may clobber it.
+    Dart_Handle error =
+        (bytes_read < 0) ? DartUtils::NewDartOSError() : Dart_Null();
+    result = Dart_TypedDataReleaseData(buffer_obj);
+    if (Dart_IsError(result)) {
+      Dart_PropagateError(result);
+    }
+    if (bytes_read < 0) {
+      Dart_SetReturnValue(args, error);
+      return;
+    }
+  } else {
+    uint8_t* buffer = Dart_ScopeAllocate(length);
+    bytes_read =
         SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
-    if (bytes_read == length) {
-      Dart_SetReturnValue(args, result);
-    } else if (bytes_read > 0) {
-      uint8_t* new_buffer = NULL;
-      Dart_Handle new_result = IOBuffer::Allocate(bytes_read, &new_buffer);
-      if (Dart_IsNull(new_result)) {
-        Dart_SetReturnValue(args, DartUtils::NewDartOSError());
-        return;
-      }
-      if (Dart_IsError(new_result)) {
-        Dart_PropagateError(new_result);
-      }
-      ASSERT(new_buffer != NULL);
-      memmove(new_buffer, buffer, bytes_read);
-      Dart_SetReturnValue(args, new_result);
-    } else if (bytes_read == 0) {
-      // On MacOS when reading from a tty Ctrl-D will result in reading one
-      // less byte then reported as available.
-      Dart_SetReturnValue(args, Dart_Null());
-    } else {
-      ASSERT(bytes_read == -1);
+    if (bytes_read < 0) {
       Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+      return;
+    }
+    if (bytes_read > 0) {
+      Dart_Handle result =
+          Dart_ListSetAsBytes(buffer_obj, start, buffer, bytes_read);
+      if (Dart_IsError(result)) {
+        Dart_PropagateError(result);
+      }
     }
+  }
+  Dart_SetIntegerReturnValue(args, bytes_read);
+}
+
+void FUNCTION_NAME(Socket_SendFile)(Dart_NativeArguments args) {
+#if defined(HOST_OS_WINDOWS)
+  // Not called, as RawSocket.sendFile copies the data on Windows.
+  UNREACHABLE();
+#else
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  // The file pointer was retained by File_GetPointer.
+  File* file = reinterpret_cast<File*>(
+      DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 1)));
+  ASSERT(file != NULL);
+  RefCntReleaseScope<File> rs(file);
+  // Offset and count are checked in Dart code to be non-negative.
+  int64_t offset = DartUtils::GetIntegerValue(Dart_GetNativeArgument(args, 2));
+  intptr_t count = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 3));
+  bool end_of_file;
+  intptr_t bytes_written =
+      SocketBase::SendFile(socket->fd(), file->GetFD(), offset, count,
+                           SocketBase::kAsync, &end_of_file);
+  if (bytes_written >= 0) {
+    // A short write at the end of the file is returned negated and minus
+    // one, as the socket may still take more.
+    Dart_SetIntegerReturnValue(
+        args, end_of_file ? -bytes_written - 1 : bytes_written);
   } else {
-    OSError os_error(-1, "Invalid argument", OSError::kUnknown);
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
   }
+#endif
 }
 
 void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
@@ -417,7 +499,7 @@ void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
   // Datagram data read. Copy into buffer of the exact size,
   ASSERT(bytes_read > 0);
   uint8_t* data_buffer = NULL;
-  Dart_Handle data = IOBuffer::Allocate(bytes_read, &data_buffer);
+  Dart_Handle data = IOBufferPool::Allocate(bytes_read, &data_buffer);
   if (Dart_IsNull(data)) {
     Dart_SetReturnValue(args, DartUtils::NewDartOSError());
     return;
@@ -154,6 +154,21 @@ class SocketBase : public AllStatic {
                         const void* buffer,
                         intptr_t num_bytes,
                         SocketOpKind sync);
+#if !defined(HOST_OS_WINDOWS)
+  // Write up to num_bytes of the file file_fd, starting at the given file
+  // offset, to the socket without copying the data through user space.
+  // The file position of file_fd is not changed. end_of_file is set if
+  // fewer bytes were written because the file ended, rather than because
+  // the socket is full. Returns -1 with the OS error set on platforms that
+  // do not support it. On Windows, whose sockets write through their own
+  // overlapped buffers, RawSocket.sendFile copies the data instead.
+  static intptr_t SendFile(intptr_t fd,
+                           intptr_t file_fd,
+                           int64_t offset,
+                           intptr_t num_bytes,
+                           SocketOpKind sync,
+                           bool* end_of_file);
+#endif
   // Send data on a socket. The port to send to is specified in the port
   // component of the passed RawAddr structure. The RawAddr structure is only
   // used for datagram sockets.
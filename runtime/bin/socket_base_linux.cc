@@ -7,15 +7,16 @@
 
 #include "bin/socket_base.h"
 
-#include <errno.h>        // NOLINT
-#include <ifaddrs.h>      // NOLINT
-#include <net/if.h>       // NOLINT
-#include <netinet/tcp.h>  // NOLINT
-#include <stdio.h>        // NOLINT
-#include <stdlib.h>       // NOLINT
-#include <string.h>       // NOLINT
-#include <sys/stat.h>     // NOLINT
-#include <unistd.h>       // NOLINT
+#include <errno.h>         // NOLINT
+#include <ifaddrs.h>       // NOLINT
+#include <net/if.h>        // NOLINT
+#include <netinet/tcp.h>   // NOLINT
+#include <stdio.h>         // NOLINT
+#include <stdlib.h>        // NOLINT
+#include <string.h>        // NOLINT
+#include <sys/sendfile.h>  // NOLINT
+#include <sys/stat.h>      // NOLINT
+#include <unistd.h>        // NOLINT
 
 #include "bin/fdutils.h"
 #include "bin/file.h"
@@ -105,6 +106,41 @@ intptr_t SocketBase::Write(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              intptr_t file_fd,
+                              int64_t offset,
+                              intptr_t num_bytes,
+                              SocketOpKind sync,
+                              bool* end_of_file) {
+  ASSERT(fd >= 0);
+  *end_of_file = false;
+  off64_t file_offset = offset;
+  intptr_t written_bytes = 0;
+  // A short write is either a full socket or the end of the file. Sending the
+  // rest tells them apart: sendfile returns 0 only at the end of the file.
+  while (written_bytes < num_bytes) {
+    ssize_t result = TEMP_FAILURE_RETRY(sendfile64(
+        fd, file_fd, &file_offset, num_bytes - written_bytes));
+    if (result > 0) {
+      written_bytes += result;
+      continue;
+    }
+    if (result == 0) {
+      *end_of_file = true;
+      break;
+    }
+    ASSERT(EAGAIN == EWOULDBLOCK);
+    if ((written_bytes == 0) &&
+        ((sync != kAsync) || (errno != EWOULDBLOCK))) {
+      return -1;
+    }
+    // If the would block we need to retry and therefore return the number
+    // of bytes written so far. Other errors are reported by the next call.
+    break;
+  }
+  return written_bytes;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
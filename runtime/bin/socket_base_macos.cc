@@ -14,7 +14,9 @@
 #include <stdio.h>        // NOLINT
 #include <stdlib.h>       // NOLINT
 #include <string.h>       // NOLINT
+#include <sys/socket.h>   // NOLINT
 #include <sys/stat.h>     // NOLINT
+#include <sys/uio.h>      // NOLINT
 #include <unistd.h>       // NOLINT
 
 #include "bin/fdutils.h"
@@ -104,6 +106,29 @@ intptr_t SocketBase::Write(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              intptr_t file_fd,
+                              int64_t offset,
+                              intptr_t num_bytes,
+                              SocketOpKind sync,
+                              bool* end_of_file) {
+  ASSERT(fd >= 0);
+  *end_of_file = false;
+  // On input len is the number of bytes to send, on output the number of
+  // bytes sent, which is also valid when the call fails with EAGAIN.
+  off_t len = num_bytes;
+  int result = sendfile(file_fd, fd, offset, &len, NULL, 0);
+  if (result == -1) {
+    if ((errno == EINTR) || ((sync == kAsync) && (errno == EWOULDBLOCK))) {
+      return len;
+    }
+    return -1;
+  }
+  // Success with fewer bytes than asked for means the file ended.
+  *end_of_file = len < num_bytes;
+  return len;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
@@ -381,6 +381,20 @@ DART_EXPORT void Dart_TimelineEvent(const char* label,
                                     const char** argument_names,
                                     const char** argument_values);
 
+/**
+ * Writes the events recorded on the global timeline so far to a file, in the
+ * Chrome trace event format. The file is written with the file callbacks
+ * passed to Dart_Initialize.
+ *
+ * This lets an embedder save a trace, for example of its startup, when it
+ * exits without calling Dart_Cleanup.
+ *
+ * \param path The path of the file to write.
+ *
+ * \return Whether the file was written. Always false in product mode.
+ */
+DART_EXPORT bool Dart_TimelineWriteToFile(const char* path);
+
 /**
  * Associates a name with the current thread. This name will be used to name
  * threads in the timeline. Can only be called after a call to Dart_Initialize.
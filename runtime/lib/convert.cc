@@ -0,0 +1,1001 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/bootstrap_natives.h"
+
+#if defined(HOST_ARCH_X64)
+#include <emmintrin.h>
+#elif defined(HOST_ARCH_ARM64)
+#include <arm_neon.h>
+#endif
+
+#include "platform/text_buffer.h"
+#include "platform/unicode.h"
+#include "vm/dart_entry.h"
+#include "vm/double_conversion.h"
+#include "vm/exceptions.h"
+#include "vm/growable_array.h"
+#include "vm/native_entry.h"
+#include "vm/object.h"
+
+namespace dart {
+
+// Returns a position from [i], at or before the first byte in [bytes] that is
+// a quote, a backslash, a control character or outside ASCII. These are the
+// bytes JSON strings need a closer look at, both when decoding and encoding.
+static intptr_t SkipPlainBytes(const uint8_t* bytes,
+                               intptr_t i,
+                               intptr_t length) {
+#if defined(HOST_ARCH_X64)
+  // SSE2 and NEON are part of the x64 and ARM64 baselines, so these need no
+  // CPU feature check.
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i space = _mm_set1_epi8(' ');
+  for (; i + 16 <= length; i += 16) {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&bytes[i]));
+    // Bytes from 0x80 are negative, so they compare less than a space.
+    const __m128i special =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                  _mm_cmpeq_epi8(chunk, backslash)),
+                     _mm_cmplt_epi8(chunk, space));
+    const uint32_t mask = _mm_movemask_epi8(special);
+    if (mask != 0) {
+      return i + Utils::CountTrailingZeros32(mask);
+    }
+  }
+#elif defined(HOST_ARCH_ARM64)
+  const uint8x16_t quote = vdupq_n_u8('"');
+  const uint8x16_t backslash = vdupq_n_u8('\\');
+  const uint8x16_t space = vdupq_n_u8(' ');
+  const uint8x16_t del = vdupq_n_u8(0x7F);
+  for (; i + 16 <= length; i += 16) {
+    const uint8x16_t chunk = vld1q_u8(&bytes[i]);
+    const uint8x16_t special = vorrq_u8(
+        vorrq_u8(vceqq_u8(chunk, quote), vceqq_u8(chunk, backslash)),
+        vorrq_u8(vcltq_u8(chunk, space), vcgtq_u8(chunk, del)));
+    if (vmaxvq_u8(special) != 0) {
+      break;
+    }
+  }
+#endif
+  return i;
+}
+
+// Decodes a complete JSON document to the objects the _BuildJsonListener in
+// convert_patch.dart would build: growable lists, maps with String keys and
+// dynamic values, strings, ints, doubles, bools and null. [CharType] is
+// uint8_t for Latin-1 strings and UTF-8 bytes, and uint16_t for UTF-16
+// strings.
+//
+// The decoder does not report errors. It gives up on any input it does not
+// accept, and the Dart parser then decodes it again to produce the same
+// values or throw its FormatException.
+template <typename CharType, bool kIsUtf8>
+class JsonDecoder : public ValueObject {
+ public:
+  JsonDecoder(Zone* zone, const CharType* chars, intptr_t length)
+      : zone_(zone),
+        chars_(chars),
+        length_(length),
+        position_(0),
+        containers_(zone, 16),
+        buffer_(zone, 64),
+        values_(GrowableObjectArray::Handle(zone, GrowableObjectArray::New())),
+        map_type_arguments_(TypeArguments::Handle(zone)),
+        value_(Object::Handle(zone)),
+        key_(String::Handle(zone)),
+        other_key_(String::Handle(zone)) {}
+
+  // Returns false if the decoder gives up on the input.
+  bool Decode(Object* result) {
+    if (kIsUtf8 && (length_ >= 3) && (chars_[0] == 0xEF) &&
+        (chars_[1] == 0xBB) && (chars_[2] == 0xBF)) {
+      position_ = 3;  // Byte order mark.
+    }
+    while (true) {
+      // Parse a value.
+      SkipWhitespace();
+      if (position_ == length_) return false;
+      const CharType ch = chars_[position_];
+      if ((ch == '{') || (ch == '[')) {
+        const bool is_object = (ch == '{');
+        position_++;
+        SkipWhitespace();
+        if ((position_ < length_) &&
+            (chars_[position_] == (is_object ? '}' : ']'))) {
+          position_++;
+          value_ = MakeContainer(is_object, values_.Length());
+          values_.Add(value_);
+        } else {
+          containers_.Add(Container(is_object, values_.Length()));
+          if (is_object && !ParseKey()) return false;
+          continue;
+        }
+      } else if (!ParseScalar()) {
+        return false;
+      }
+      // Close the containers that end after the value, and find where the
+      // next one starts.
+      while (true) {
+        SkipWhitespace();
+        if (containers_.is_empty()) {
+          if (position_ != length_) return false;
+          *result = values_.At(0);
+          return true;
+        }
+        if (position_ == length_) return false;
+        const Container& container = containers_.Last();
+        const CharType ch = chars_[position_++];
+        if (ch == ',') {
+          if (container.is_object && !ParseKey()) return false;
+          break;
+        }
+        if (ch != (container.is_object ? '}' : ']')) return false;
+        value_ = MakeContainer(container.is_object, container.start);
+        values_.SetLength(container.start);
+        values_.Add(value_);
+        containers_.RemoveLast();
+      }
+    }
+  }
+
+ private:
+  // A list or object being parsed, whose elements, or keys and values, are
+  // on [values_] from [start].
+  struct Container {
+    Container(bool is_object, intptr_t start)
+        : is_object(is_object), start(start) {}
+    bool is_object;
+    intptr_t start;
+  };
+
+  // Keep these in sync with _HashBase in compact_hash.dart.
+  static const intptr_t kInitialIndexSize = 16;
+  static const intptr_t kAvailableHashBits = (kSmiBits >= 32) ? 32 : kSmiBits;
+
+  static bool IsWhitespace(CharType ch) {
+    return (ch == ' ') || (ch == '\n') || (ch == '\r') || (ch == '\t');
+  }
+
+  static bool IsDigit(CharType ch) { return (ch >= '0') && (ch <= '9'); }
+
+  void SkipWhitespace() {
+    while ((position_ < length_) && IsWhitespace(chars_[position_])) {
+      position_++;
+    }
+  }
+
+  bool Match(const char* keyword) {
+    for (intptr_t i = 0; keyword[i] != '\0'; i++, position_++) {
+      if ((position_ == length_) || (chars_[position_] != keyword[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Parses a key and the following colon, and pushes the key.
+  bool ParseKey() {
+    SkipWhitespace();
+    if ((position_ == length_) || (chars_[position_] != '"')) return false;
+    position_++;
+    if (!ParseString()) return false;
+    values_.Add(key_);
+    SkipWhitespace();
+    if ((position_ == length_) || (chars_[position_] != ':')) return false;
+    position_++;
+    return true;
+  }
+
+  // Parses a value that is not a list or object, and pushes it.
+  bool ParseScalar() {
+    switch (chars_[position_]) {
+      case '"':
+        position_++;
+        if (!ParseString()) return false;
+        values_.Add(key_);
+        return true;
+      case 't':
+        if (!Match("true")) return false;
+        values_.Add(Bool::True());
+        return true;
+      case 'f':
+        if (!Match("false")) return false;
+        values_.Add(Bool::False());
+        return true;
+      case 'n':
+        if (!Match("null")) return false;
+        values_.Add(Object::null_object());
+        return true;
+      default:
+        if (!ParseNumber()) return false;
+        values_.Add(value_);
+        return true;
+    }
+  }
+
+  // Returns the position of the first character from [position_] that needs
+  // a closer look inside a string: a quote, a backslash, a control character
+  // or, for bytes, any character outside ASCII.
+  intptr_t ScanString() const {
+    intptr_t i = position_;
+    if (sizeof(CharType) == 1) {
+      i = SkipPlainBytes(reinterpret_cast<const uint8_t*>(chars_), i, length_);
+    }
+    for (; i < length_; i++) {
+      const CharType ch = chars_[i];
+      if ((ch == '"') || (ch == '\\') || (ch < ' ') ||
+          ((sizeof(CharType) == 1) && (ch > 0x7F))) {
+        return i;
+      }
+    }
+    return i;
+  }
+
+  // Parses the rest of a string after its opening quote into [key_].
+  bool ParseString() {
+    const intptr_t start = position_;
+    intptr_t end = ScanString();
+    // Latin-1 characters need no decoding.
+    while (!kIsUtf8 && (sizeof(CharType) == 1) && (end < length_) &&
+           (chars_[end] > 0x7F)) {
+      position_ = end + 1;
+      end = ScanString();
+    }
+    if ((end < length_) && (chars_[end] == '"')) {
+      position_ = end + 1;
+      if (sizeof(CharType) == 1) {
+        key_ = OneByteString::New(
+            reinterpret_cast<const uint8_t*>(&chars_[start]), end - start,
+            Heap::kNew);
+      } else {
+        key_ = String::FromUTF16(
+            reinterpret_cast<const uint16_t*>(&chars_[start]), end - start);
+      }
+      return true;
+    }
+    position_ = start;
+    return ParseEscapedString();
+  }
+
+  // Parses a string with escapes or, for UTF-8, characters outside ASCII,
+  // into [key_].
+  bool ParseEscapedString() {
+    buffer_.Clear();
+    while (true) {
+      const intptr_t end = ScanString();
+      for (intptr_t i = position_; i < end; i++) {
+        buffer_.Add(chars_[i]);
+      }
+      position_ = end;
+      if (position_ == length_) return false;
+      const uint32_t ch = chars_[position_++];
+      if (ch == '"') {
+        key_ = String::FromUTF16(buffer_.data(), buffer_.length());
+        return true;
+      } else if (ch == '\\') {
+        if (!ParseEscape()) return false;
+      } else if (ch < ' ') {
+        return false;
+      } else if (!kIsUtf8) {
+        buffer_.Add(ch);
+      } else if (!DecodeUtf8(ch)) {
+        return false;
+      }
+    }
+  }
+
+  bool ParseEscape() {
+    if (position_ == length_) return false;
+    switch (chars_[position_++]) {
+      case '"':
+        buffer_.Add('"');
+        return true;
+      case '\\':
+        buffer_.Add('\\');
+        return true;
+      case '/':
+        buffer_.Add('/');
+        return true;
+      case 'b':
+        buffer_.Add('\b');
+        return true;
+      case 'f':
+        buffer_.Add('\f');
+        return true;
+      case 'n':
+        buffer_.Add('\n');
+        return true;
+      case 'r':
+        buffer_.Add('\r');
+        return true;
+      case 't':
+        buffer_.Add('\t');
+        return true;
+      case 'u': {
+        if (position_ + 4 > length_) return false;
+        uint32_t code_unit = 0;
+        for (intptr_t i = 0; i < 4; i++) {
+          const uint32_t ch = chars_[position_++];
+          uint32_t digit;
+          if (IsDigit(ch)) {
+            digit = ch - '0';
+          } else if (((ch | 0x20) >= 'a') && ((ch | 0x20) <= 'f')) {
+            digit = (ch | 0x20) - 'a' + 10;
+          } else {
+            return false;
+          }
+          code_unit = (code_unit << 4) | digit;
+        }
+        // Like the Dart parser, this keeps unpaired surrogates.
+        buffer_.Add(code_unit);
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+
+  // Decodes the rest of the UTF-8 sequence that starts with [lead]. Only
+  // shortest forms of scalar values are accepted.
+  bool DecodeUtf8(uint32_t lead) {
+    intptr_t trail_count;
+    uint32_t min;
+    if ((lead >= 0xC2) && (lead <= 0xDF)) {
+      trail_count = 1;
+      min = 0x80;
+    } else if ((lead >= 0xE0) && (lead <= 0xEF)) {
+      trail_count = 2;
+      min = 0x800;
+    } else if ((lead >= 0xF0) && (lead <= 0xF4)) {
+      trail_count = 3;
+      min = 0x10000;
+    } else {
+      return false;
+    }
+    if (position_ + trail_count > length_) return false;
+    uint32_t code_point = lead & (0x3F >> trail_count);
+    for (intptr_t i = 0; i < trail_count; i++) {
+      const uint32_t trail = chars_[position_++];
+      if ((trail & 0xC0) != 0x80) return false;
+      code_point = (code_point << 6) | (trail & 0x3F);
+    }
+    if ((code_point < min) || (code_point > Utf::kMaxCodePoint) ||
+        Utf16::IsSurrogate(code_point)) {
+      return false;
+    }
+    if (code_point > Utf16::kMaxCodeUnit) {
+      uint16_t pair[2];
+      Utf16::Encode(code_point, pair);
+      buffer_.Add(pair[0]);
+      buffer_.Add(pair[1]);
+    } else {
+      buffer_.Add(code_point);
+    }
+    return true;
+  }
+
+  // Parses a number into [value_]. Like the Dart parser, this keeps integer
+  // literals that fit in 64 bits as ints, and rounds other literals to the
+  // nearest double.
+  bool ParseNumber() {
+    const intptr_t start = position_;
+    const bool is_negative = (chars_[position_] == '-');
+    if (is_negative) position_++;
+    if ((position_ == length_) || !IsDigit(chars_[position_])) return false;
+    // The first 19 significant digits, the number of digits after them and
+    // the number of digits after the decimal point.
+    uint64_t mantissa = 0;
+    intptr_t mantissa_digits = 0;
+    intptr_t dropped_digits = 0;
+    intptr_t fraction_digits = 0;
+    bool is_zero = true;
+    bool is_double = false;
+    if (chars_[position_] == '0') {
+      position_++;
+      if ((position_ < length_) && IsDigit(chars_[position_])) return false;
+    }
+    while (true) {
+      for (; (position_ < length_) && IsDigit(chars_[position_]);
+           position_++) {
+        const intptr_t digit = chars_[position_] - '0';
+        is_zero = is_zero && (digit == 0);
+        if (mantissa_digits < 19) {
+          mantissa = 10 * mantissa + digit;
+          if (mantissa != 0) mantissa_digits++;
+        } else {
+          dropped_digits++;
+        }
+        if (is_double) fraction_digits++;
+      }
+      if (is_double || (position_ == length_) ||
+          (chars_[position_] != '.')) {
+        break;
+      }
+      is_double = true;
+      position_++;
+      if ((position_ == length_) || !IsDigit(chars_[position_])) return false;
+    }
+    int64_t exponent = 0;
+    bool exponent_overflow = false;
+    if ((position_ < length_) && ((chars_[position_] | 0x20) == 'e')) {
+      is_double = true;
+      position_++;
+      bool is_exponent_negative = false;
+      if ((position_ < length_) &&
+          ((chars_[position_] == '+') || (chars_[position_] == '-'))) {
+        is_exponent_negative = (chars_[position_] == '-');
+        position_++;
+      }
+      if ((position_ == length_) || !IsDigit(chars_[position_])) return false;
+      for (; (position_ < length_) && IsDigit(chars_[position_]);
+           position_++) {
+        if (exponent <= 400) exponent = 10 * exponent + chars_[position_] - '0';
+      }
+      exponent_overflow = (exponent > 400);
+      if (is_exponent_negative) exponent = -exponent;
+    }
+    if (!is_double && (dropped_digits == 0)) {
+      const uint64_t limit =
+          static_cast<uint64_t>(kMaxInt64) + (is_negative ? 1 : 0);
+      if (mantissa <= limit) {
+        value_ = Integer::New(
+            static_cast<int64_t>(is_negative ? 0 - mantissa : mantissa));
+        return true;
+      }
+    }
+    double result;
+    if (exponent_overflow) {
+      // The Dart parser does not look at the digits of such numbers.
+      result = (is_zero || (exponent < 0)) ? 0.0 : kPosInfinity;
+      if (is_negative) result = -result;
+    } else if ((dropped_digits == 0) && (mantissa < (DART_UINT64_C(1) << 53)) &&
+               (exponent - fraction_digits >= -22) &&
+               (exponent - fraction_digits <= 22)) {
+      // Both the mantissa and the power of ten are exact, so this rounds
+      // once, like a full conversion would.
+      static const double kPowersOfTen[] = {
+          1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+          1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+          1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+      const intptr_t power = exponent - fraction_digits;
+      result = static_cast<double>(mantissa);
+      if (is_negative) result = -result;
+      result = (power < 0) ? result / kPowersOfTen[-power]
+                           : result * kPowersOfTen[power];
+    } else {
+      const intptr_t length = position_ - start;
+      char* literal = zone_->Alloc<char>(length);
+      for (intptr_t i = 0; i < length; i++) {
+        literal[i] = static_cast<char>(chars_[start + i]);
+      }
+      if (!CStringToDouble(literal, length, &result)) return false;
+    }
+    value_ = Double::New(result);
+    return true;
+  }
+
+  RawInstance* MakeContainer(bool is_object, intptr_t start) {
+    if (is_object) {
+      return MakeMap(start);
+    }
+    return MakeList(start);
+  }
+
+  // Returns a list of the values on [values_] from [start].
+  RawGrowableObjectArray* MakeList(intptr_t start) {
+    const intptr_t length = values_.Length() - start;
+    if (length == 0) {
+      return GrowableObjectArray::New();
+    }
+    const Array& elements = Array::Handle(zone_, Array::New(length));
+    for (intptr_t i = 0; i < length; i++) {
+      value_ = values_.At(start + i);
+      elements.SetAt(i, value_);
+    }
+    return GrowableObjectArray::New(elements);
+  }
+
+  // Returns a map of the keys and values on [values_] from [start], laid
+  // out as if they were added to an empty map in order.
+  RawLinkedHashMap* MakeMap(intptr_t start) {
+    const intptr_t count = (values_.Length() - start) / 2;
+    // The index has room for twice as many entries as the data, and both
+    // double whenever the data is full.
+    intptr_t index_size = kInitialIndexSize;
+    while (index_size < 2 * count) {
+      index_size <<= 1;
+    }
+    const intptr_t index_bits = Utils::ShiftForPowerOfTwo(index_size) - 1;
+    const intptr_t hash_mask = (1 << (kAvailableHashBits - index_bits)) - 1;
+    const intptr_t size_mask = index_size - 1;
+    const intptr_t max_entries = index_size >> 1;
+    const Array& data = Array::Handle(zone_, Array::New(index_size));
+    const TypedData& index = TypedData::Handle(
+        zone_, TypedData::New(kTypedDataUint32ArrayCid, index_size));
+    intptr_t used_data = 0;
+    for (intptr_t i = 0; i < count; i++) {
+      key_ ^= values_.At(start + 2 * i);
+      value_ = values_.At(start + 2 * i + 1);
+      const intptr_t hash = key_.Hash();
+      const intptr_t masked_hash = hash & hash_mask;
+      const uint32_t hash_pattern =
+          (masked_hash == 0) ? max_entries : masked_hash * max_entries;
+      intptr_t probe = (3 * (hash & size_mask)) & size_mask;
+      bool is_duplicate = false;
+      uint32_t pair;
+      while ((pair = index.GetUint32(probe * sizeof(uint32_t))) != 0) {
+        const intptr_t entry = hash_pattern ^ pair;
+        if (entry < max_entries) {
+          other_key_ ^= data.At(2 * entry);
+          if (other_key_.Equals(key_)) {
+            // The last value wins, but the key keeps its place.
+            data.SetAt(2 * entry + 1, value_);
+            is_duplicate = true;
+            break;
+          }
+        }
+        probe = (probe + 1) & size_mask;
+      }
+      if (!is_duplicate) {
+        index.SetUint32(probe * sizeof(uint32_t),
+                        hash_pattern | (used_data >> 1));
+        data.SetAt(used_data++, key_);
+        data.SetAt(used_data++, value_);
+      }
+    }
+    const LinkedHashMap& map = LinkedHashMap::Handle(
+        zone_, LinkedHashMap::New(data, index, hash_mask, used_data, 0));
+    map.SetTypeArguments(MapTypeArguments());
+    return map.raw();
+  }
+
+  // Returns <String, dynamic>, the type arguments of the map literals in
+  // _BuildJsonListener.
+  const TypeArguments& MapTypeArguments() {
+    if (map_type_arguments_.IsNull()) {
+      map_type_arguments_ = TypeArguments::New(2);
+      map_type_arguments_.SetTypeAt(0, Type::Handle(zone_, Type::StringType()));
+      map_type_arguments_.SetTypeAt(1,
+                                    Type::Handle(zone_, Type::DynamicType()));
+      map_type_arguments_ = map_type_arguments_.Canonicalize();
+    }
+    return map_type_arguments_;
+  }
+
+  Zone* zone_;
+  const CharType* chars_;
+  const intptr_t length_;
+  intptr_t position_;
+  GrowableArray<Container> containers_;
+  // The code units of a string with escapes.
+  GrowableArray<uint16_t> buffer_;
+  // Values of the containers being parsed, and then the document.
+  const GrowableObjectArray& values_;
+  TypeArguments& map_type_arguments_;
+  Object& value_;
+  String& key_;
+  String& other_key_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonDecoder);
+};
+
+template <typename CharType, bool kIsUtf8>
+static RawObject* DecodeJson(Zone* zone,
+                             const CharType* chars,
+                             intptr_t length) {
+  JsonDecoder<CharType, kIsUtf8> decoder(zone, chars, length);
+  Object& result = Object::Handle(zone);
+  return decoder.Decode(&result) ? result.raw() : Object::null();
+}
+
+// Decodes a String, or a Uint8List of UTF-8. Returns null if the Dart parser
+// should decode the input instead, which is also how errors are reported.
+DEFINE_NATIVE_ENTRY(Json_decode, 0, 1) {
+  const Instance& input =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(0));
+  // Objects in the Dart heap may move while the result is allocated, so
+  // their contents are decoded from a copy.
+  if (input.IsString()) {
+    const String& source = String::Cast(input);
+    const intptr_t length = source.Length();
+    if (source.IsOneByteString() || source.IsExternalOneByteString()) {
+      uint8_t* chars = zone->Alloc<uint8_t>(length);
+      source.ToLatin1(chars, length);
+      return DecodeJson<uint8_t, false>(zone, chars, length);
+    }
+    uint16_t* chars = zone->Alloc<uint16_t>(length);
+    source.ToUTF16(chars, length);
+    return DecodeJson<uint16_t, false>(zone, chars, length);
+  }
+  const intptr_t cid = input.GetClassId();
+  if (RawObject::IsTypedDataClassId(cid) ||
+      RawObject::IsTypedDataViewClassId(cid) ||
+      RawObject::IsExternalTypedDataClassId(cid)) {
+    const TypedDataBase& bytes =
+        TypedDataBase::CheckedHandle(zone, input.raw());
+    if (bytes.ElementSizeInBytes() != 1) {
+      return Object::null();
+    }
+    const intptr_t length = bytes.LengthInBytes();
+    if (RawObject::IsExternalTypedDataClassId(cid)) {
+      return DecodeJson<uint8_t, true>(
+          zone, reinterpret_cast<const uint8_t*>(bytes.DataAddr(0)), length);
+    }
+    uint8_t* chars = zone->Alloc<uint8_t>(length);
+    {
+      NoSafepointScope no_safepoint;
+      memmove(chars, bytes.DataAddr(0), length);
+    }
+    return DecodeJson<uint8_t, true>(zone, chars, length);
+  }
+  return Object::null();
+}
+
+// Encodes objects to compact JSON, writing the UTF-8 the _JsonUtf8Stringifier
+// in json.dart would write. Strings, numbers, bools, null and the VM's lists
+// and maps are written directly. Other objects are passed to [replace_],
+// which stands in for the toEncodable function, and must be replaced by one
+// of those.
+//
+// Like the decoder, the encoder does not report errors. It gives up on
+// anything it does not encode exactly like the Dart stringifiers, and they
+// then encode the object again, throwing their errors. [replace_] keeps
+// what it returned or threw, so they are not replaced a second time.
+class JsonEncoder : public ValueObject {
+ public:
+  JsonEncoder(Thread* thread, const Instance& replace, bool allow_surrogates)
+      : thread_(thread),
+        zone_(thread->zone()),
+        replace_(replace),
+        allow_surrogates_(allow_surrogates),
+        buffer_(kInitialBufferSize),
+        latin1_(zone_, 64),
+        utf16_(zone_, 64),
+        path_(GrowableObjectArray::Handle(zone_, GrowableObjectArray::New())),
+        arguments_(Array::Handle(zone_, Array::New(2))),
+        arguments_descriptor_(
+            Array::Handle(zone_, ArgumentsDescriptor::New(0, 2))),
+        error_(Error::Handle(zone_)) {
+    arguments_.SetAt(0, replace_);
+  }
+
+  // Returns false if the encoder gives up on [object].
+  bool Encode(const Instance& object) { return WriteObject(object, 0); }
+
+  TextBuffer* buffer() { return &buffer_; }
+
+  // An error other than an exception that [replace_] returned, which is
+  // propagated once the encoder is gone.
+  const Error& error() const { return error_; }
+
+ private:
+  enum Result {
+    kWritten,
+    kGaveUp,
+    // The object is not a string, number, bool, null, list or map.
+    kNotJsonValue,
+  };
+
+  static const intptr_t kInitialBufferSize = 256;
+  // Deeper structures are left to the Dart stringifiers, so that the
+  // encoder cannot overflow the native stack.
+  static const intptr_t kMaxDepth = 256;
+  // See DoubleToCString in double_conversion.cc.
+  static const intptr_t kDoubleBufferSize = 25;
+
+  static bool IsPlain(uint32_t ch) {
+    return (ch >= ' ') && (ch < 0x80) && (ch != '"') && (ch != '\\');
+  }
+
+  static char HexDigit(uint32_t digit) {
+    return (digit < 10) ? ('0' + digit) : ('a' + digit - 10);
+  }
+
+  bool WriteObject(const Instance& object, intptr_t depth) {
+    const Result result = WriteValue(object, depth);
+    if (result != kNotJsonValue) {
+      return result == kWritten;
+    }
+    // Like the Dart stringifiers, check for cycles through the object, and
+    // replace it once.
+    if (IsOnPath(object)) return false;
+    HANDLESCOPE(thread_);
+    path_.Add(object);
+    arguments_.SetAt(1, object);
+    const Object& replacement = Object::Handle(
+        zone_, DartEntry::InvokeClosure(arguments_, arguments_descriptor_));
+    if (replacement.IsError()) {
+      if (!replacement.IsUnhandledException()) {
+        error_ ^= replacement.raw();
+      }
+      return false;
+    }
+    if (WriteValue(Instance::Cast(replacement), depth) != kWritten) {
+      return false;
+    }
+    path_.RemoveLast();
+    return true;
+  }
+
+  Result WriteValue(const Instance& object, intptr_t depth) {
+    if (object.IsNull()) {
+      AddString("null");
+      return kWritten;
+    }
+    switch (object.GetClassId()) {
+      case kBoolCid:
+        AddString(Bool::Cast(object).value() ? "true" : "false");
+        return kWritten;
+      case kSmiCid:
+      case kMintCid:
+        WriteInteger(Integer::Cast(object).AsInt64Value());
+        return kWritten;
+      case kDoubleCid:
+        return WriteDouble(Double::Cast(object).value()) ? kWritten : kGaveUp;
+      case kOneByteStringCid:
+      case kExternalOneByteStringCid:
+      case kTwoByteStringCid:
+      case kExternalTwoByteStringCid:
+        return WriteString(String::Cast(object)) ? kWritten : kGaveUp;
+      case kArrayCid:
+      case kImmutableArrayCid:
+      case kGrowableObjectArrayCid:
+        return WriteList(object, depth) ? kWritten : kGaveUp;
+      case kLinkedHashMapCid:
+        return WriteMap(LinkedHashMap::Cast(object), depth) ? kWritten
+                                                             : kGaveUp;
+      default:
+        return kNotJsonValue;
+    }
+  }
+
+  bool IsOnPath(const Instance& object) const {
+    for (intptr_t i = 0; i < path_.Length(); i++) {
+      if (path_.At(i) == object.raw()) return true;
+    }
+    return false;
+  }
+
+  void AddString(const char* string) {
+    buffer_.AddRaw(reinterpret_cast<const uint8_t*>(string), strlen(string));
+  }
+
+  void WriteInteger(int64_t value) {
+    char digits[20];
+    uint64_t magnitude = (value < 0) ? 0 - static_cast<uint64_t>(value)
+                                     : static_cast<uint64_t>(value);
+    intptr_t start = sizeof(digits);
+    do {
+      digits[--start] = '0' + (magnitude % 10);
+      magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) buffer_.AddChar('-');
+    buffer_.AddRaw(reinterpret_cast<const uint8_t*>(&digits[start]),
+                   sizeof(digits) - start);
+  }
+
+  // Non-finite doubles are passed to toEncodable, which is left to the Dart
+  // stringifiers.
+  bool WriteDouble(double value) {
+    if (isinf(value) || isnan(value)) return false;
+    char digits[kDoubleBufferSize];
+    DoubleToCString(value, digits, kDoubleBufferSize);
+    AddString(digits);
+    return true;
+  }
+
+  // Strings are written from a copy, as [replace_] may move them.
+  bool WriteString(const String& string) {
+    const intptr_t length = string.Length();
+    buffer_.AddChar('"');
+    if (string.IsOneByteString() || string.IsExternalOneByteString()) {
+      latin1_.SetLength(length);
+      string.ToLatin1(latin1_.data(), length);
+      WriteLatin1(latin1_.data(), length);
+    } else {
+      utf16_.SetLength(length);
+      string.ToUTF16(utf16_.data(), length);
+      if (!WriteUtf16(utf16_.data(), length)) return false;
+    }
+    buffer_.AddChar('"');
+    return true;
+  }
+
+  void WriteLatin1(const uint8_t* chars, intptr_t length) {
+    intptr_t start = 0;
+    intptr_t i = 0;
+    while (true) {
+      i = SkipPlainBytes(chars, i, length);
+      while ((i < length) && IsPlain(chars[i])) {
+        i++;
+      }
+      buffer_.AddRaw(&chars[start], i - start);
+      if (i == length) return;
+      WriteCodePoint(chars[i]);
+      start = ++i;
+    }
+  }
+
+  // Unpaired surrogates cannot be written to a String through UTF-8, so
+  // the encoder gives up on them unless it writes UTF-8 bytes.
+  bool WriteUtf16(const uint16_t* chars, intptr_t length) {
+    for (intptr_t i = 0; i < length; i++) {
+      const uint16_t ch = chars[i];
+      if (IsPlain(ch)) {
+        buffer_.AddChar(static_cast<char>(ch));
+      } else if (Utf16::IsLeadSurrogate(ch) && (i + 1 < length) &&
+                 Utf16::IsTrailSurrogate(chars[i + 1])) {
+        WriteCodePoint(Utf16::Decode(ch, chars[i + 1]));
+        i++;
+      } else if (Utf16::IsSurrogate(ch) && !allow_surrogates_) {
+        return false;
+      } else {
+        WriteCodePoint(ch);
+      }
+    }
+    return true;
+  }
+
+  // Writes a character that is not plain, escaping it like
+  // _JsonStringifier.writeStringContent.
+  void WriteCodePoint(int32_t ch) {
+    if (ch >= 0x80) {
+      char bytes[4];
+      const intptr_t length = Utf8::Encode(ch, bytes);
+      buffer_.AddRaw(reinterpret_cast<const uint8_t*>(bytes), length);
+      return;
+    }
+    buffer_.AddChar('\\');
+    switch (ch) {
+      case '"':
+      case '\\':
+        buffer_.AddChar(ch);
+        break;
+      case '\b':
+        buffer_.AddChar('b');
+        break;
+      case '\t':
+        buffer_.AddChar('t');
+        break;
+      case '\n':
+        buffer_.AddChar('n');
+        break;
+      case '\f':
+        buffer_.AddChar('f');
+        break;
+      case '\r':
+        buffer_.AddChar('r');
+        break;
+      default:
+        AddString("u00");
+        buffer_.AddChar(HexDigit(ch >> 4));
+        buffer_.AddChar(HexDigit(ch & 0xF));
+        break;
+    }
+  }
+
+  // Like _JsonStringifier.writeList, this reads the length and elements of
+  // [list] again after each element.
+  bool WriteList(const Instance& list, intptr_t depth) {
+    if ((depth == kMaxDepth) || IsOnPath(list)) return false;
+    HANDLESCOPE(thread_);
+    const bool is_growable = list.IsGrowableObjectArray();
+    Instance& element = Instance::Handle(zone_);
+    path_.Add(list);
+    buffer_.AddChar('[');
+    for (intptr_t i = 0;; i++) {
+      if (is_growable) {
+        const GrowableObjectArray& elements = GrowableObjectArray::Cast(list);
+        if (i == elements.Length()) break;
+        element ^= elements.At(i);
+      } else {
+        const Array& elements = Array::Cast(list);
+        if (i == elements.Length()) break;
+        element ^= elements.At(i);
+      }
+      if (i > 0) buffer_.AddChar(',');
+      if (!WriteObject(element, depth + 1)) return false;
+    }
+    buffer_.AddChar(']');
+    path_.RemoveLast();
+    return true;
+  }
+
+  // Like _JsonStringifier.writeMap, this writes the keys and values [map]
+  // has when it is reached, and gives up before writing any of them if a
+  // key is not a String, leaving toEncodable to the Dart stringifiers.
+  bool WriteMap(const LinkedHashMap& map, intptr_t depth) {
+    if ((depth == kMaxDepth) || IsOnPath(map)) return false;
+    HANDLESCOPE(thread_);
+    // The data is copied when the map grows, so this keeps the entries.
+    const Array& data = Array::Handle(zone_, map.data());
+    const intptr_t used_data = Smi::Value(map.used_data());
+    Object& key = Object::Handle(zone_);
+    for (intptr_t i = 0; i < used_data; i += 2) {
+      key = data.At(i);
+      // Deleted entries have the data as their key.
+      if ((key.raw() != data.raw()) && !key.IsString()) return false;
+    }
+    Instance& value = Instance::Handle(zone_);
+    path_.Add(map);
+    buffer_.AddChar('{');
+    bool is_first = true;
+    for (intptr_t i = 0; i < used_data; i += 2) {
+      key = data.At(i);
+      if (key.raw() == data.raw()) continue;
+      if (!is_first) buffer_.AddChar(',');
+      is_first = false;
+      if (!WriteString(String::Cast(key))) return false;
+      buffer_.AddChar(':');
+      value ^= data.At(i + 1);
+      if (!WriteObject(value, depth + 1)) return false;
+    }
+    buffer_.AddChar('}');
+    path_.RemoveLast();
+    return true;
+  }
+
+  Thread* thread_;
+  Zone* zone_;
+  const Instance& replace_;
+  const bool allow_surrogates_;
+  TextBuffer buffer_;
+  // Copies of the characters of a string.
+  GrowableArray<uint8_t> latin1_;
+  GrowableArray<uint16_t> utf16_;
+  // The lists, maps and replaced objects being written.
+  const GrowableObjectArray& path_;
+  const Array& arguments_;
+  const Array& arguments_descriptor_;
+  Error& error_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonEncoder);
+};
+
+// Encodes an object as compact JSON, to a String or, if asUtf8, to an
+// external Uint8List of UTF-8. Returns null if the Dart stringifiers should
+// encode it instead, which is also how errors are reported.
+DEFINE_NATIVE_ENTRY(Json_encode, 0, 3) {
+  const Instance& object =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(0));
+  const Instance& replace =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Bool, as_utf8, arguments->NativeArgAt(2));
+  Object& result = Object::Handle(zone);
+  Error& error = Error::Handle(zone);
+  {
+    JsonEncoder encoder(thread, replace, as_utf8.value());
+    if (encoder.Encode(object)) {
+      TextBuffer* buffer = encoder.buffer();
+      const intptr_t length = buffer->length();
+      if (as_utf8.value()) {
+        // The bytes are handed over to the list, which frees them.
+        uint8_t* bytes = reinterpret_cast<uint8_t*>(buffer->Steal());
+        const ExternalTypedData& list = ExternalTypedData::Handle(
+            zone, ExternalTypedData::New(kExternalTypedDataUint8ArrayCid,
+                                         bytes, length));
+        list.AddFinalizer(bytes,
+                          [](void* isolate_callback_data,
+                             Dart_WeakPersistentHandle handle,
+                             void* data) { free(data); },
+                          length);
+        result = list.raw();
+      } else {
+        result = String::FromUTF8(
+            reinterpret_cast<const uint8_t*>(buffer->buf()), length);
+      }
+    }
+    error = encoder.error().raw();
+  }
+  // The encoder's buffer is freed before the error unwinds the stack.
+  if (!error.IsNull()) {
+    Exceptions::PropagateError(error);
+  }
+  return result.raw();
+}
+
+}  // namespace dart
@@ -9,6 +9,7 @@
 #include "vm/object.h"
 #include "vm/regexp_assembler_bytecode.h"
 #include "vm/regexp_assembler_ir.h"
+#include "vm/regexp_linear.h"
 #include "vm/regexp_parser.h"
 #include "vm/thread.h"
 
@@ -118,6 +119,10 @@ static RawObject* ExecuteMatch(Zone* zone,
   GET_NON_NULL_NATIVE_ARGUMENT(String, subject, arguments->NativeArgAt(1));
   GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_index, arguments->NativeArgAt(2));
 
+  if (regexp.is_linear()) {
+    return LinearRegExp::Match(regexp, subject, start_index,
+                               /*sticky=*/sticky, zone);
+  }
 #if !defined(DART_PRECOMPILED_RUNTIME)
   if (!FLAG_interpret_irregexp) {
     return IRRegExpMacroAssembler::Execute(regexp, subject, start_index,
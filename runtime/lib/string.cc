@@ -257,6 +257,16 @@ DEFINE_NATIVE_ENTRY(OneByteString_substringUnchecked, 0, 3) {
   return OneByteString::New(receiver, start, end - start, Heap::kNew);
 }
 
+DEFINE_NATIVE_ENTRY(String_indexOf, 0, 3) {
+  const String& receiver =
+      String::CheckedHandle(zone, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(String, pattern, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_obj, arguments->NativeArgAt(2));
+  // The start is checked in string_patch.dart.
+  ASSERT((0 <= start_obj.Value()) && (start_obj.Value() <= receiver.Length()));
+  return Smi::New(receiver.IndexOf(pattern, start_obj.Value()));
+}
+
 // This is high-performance code.
 DEFINE_NATIVE_ENTRY(OneByteString_splitWithCharCode, 0, 2) {
   const String& receiver =
@@ -265,20 +275,23 @@ DEFINE_NATIVE_ENTRY(OneByteString_splitWithCharCode, 0, 2) {
   GET_NON_NULL_NATIVE_ARGUMENT(Smi, smi_split_code, arguments->NativeArgAt(1));
   const intptr_t len = receiver.Length();
   const intptr_t split_code = smi_split_code.Value();
+  ASSERT(Utf::IsLatin1(split_code));
   const GrowableObjectArray& result = GrowableObjectArray::Handle(
       zone, GrowableObjectArray::New(16, Heap::kNew));
   String& str = String::Handle(zone);
   intptr_t start = 0;
-  intptr_t i = 0;
-  for (; i < len; i++) {
-    if (split_code == OneByteString::CharAt(receiver, i)) {
-      str = OneByteString::SubStringUnchecked(receiver, start, (i - start),
-                                              Heap::kNew);
-      result.Add(str);
-      start = i + 1;
+  while (true) {
+    const intptr_t i =
+        receiver.IndexOf(static_cast<uint16_t>(split_code), start);
+    if (i < 0) {
+      break;
     }
+    str = OneByteString::SubStringUnchecked(receiver, start, (i - start),
+                                            Heap::kNew);
+    result.Add(str);
+    start = i + 1;
   }
-  str = OneByteString::SubStringUnchecked(receiver, start, (i - start),
+  str = OneByteString::SubStringUnchecked(receiver, start, (len - start),
                                           Heap::kNew);
   result.Add(str);
   result.SetTypeArguments(TypeArguments::Handle(
@@ -526,10 +539,19 @@ DEFINE_NATIVE_ENTRY(String_codeUnitAt, 0, 2) {
   return Smi::New(static_cast<intptr_t>(value));
 }
 
+// Copies both operands unless one is empty (there is no lazy rope string).
 DEFINE_NATIVE_ENTRY(String_concat, 0, 2) {
   const String& receiver =
       String::CheckedHandle(zone, arguments->NativeArgAt(0));
   GET_NON_NULL_NATIVE_ARGUMENT(String, b, arguments->NativeArgAt(1));
+  // Strings are immutable, so the other operand is the result. This keeps
+  // loops that build a string starting from "" from copying it once more.
+  if (receiver.Length() == 0) {
+    return b.raw();
+  }
+  if (b.Length() == 0) {
+    return receiver.raw();
+  }
   return String::Concat(receiver, b);
 }
 
@@ -602,4 +624,30 @@ DEFINE_NATIVE_ENTRY(StringBuffer_createStringFromUint16Array, 0, 3) {
   return result.raw();
 }
 
+// Returns null if [units] is not one of the VM's byte lists, such as an
+// UnmodifiableUint8ListView, which is then scanned in Dart.
+DEFINE_NATIVE_ENTRY(Utf8_scanOneByteCharacters, 0, 3) {
+  const Instance& instance =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, from_obj, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, to_obj, arguments->NativeArgAt(2));
+  const intptr_t cid = instance.GetClassId();
+  if (!RawObject::IsTypedDataClassId(cid) &&
+      !RawObject::IsTypedDataViewClassId(cid) &&
+      !RawObject::IsExternalTypedDataClassId(cid)) {
+    return Object::null();
+  }
+  const TypedDataBase& units = TypedDataBase::Cast(instance);
+  if (units.ElementSizeInBytes() != 1) {
+    return Object::null();
+  }
+  const intptr_t from = from_obj.Value();
+  const intptr_t to = to_obj.Value();
+  // The range is checked in convert_patch.dart.
+  ASSERT((0 <= from) && (from < to) && (to <= units.LengthInBytes()));
+  NoSafepointScope no_safepoint;
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(units.DataAddr(from));
+  return Smi::New(Utf8::AsciiPrefixLength(data, to - from));
+}
+
 }  // namespace dart
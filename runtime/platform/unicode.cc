@@ -4,12 +4,27 @@
 
 #include "platform/unicode.h"
 
+#if defined(HOST_ARCH_X64)
+#include <emmintrin.h>
+#elif defined(HOST_ARCH_ARM64)
+#include <arm_neon.h>
+#endif
+
 #include "platform/allocation.h"
 #include "platform/globals.h"
 #include "platform/syslog.h"
+#include "platform/utils.h"
 
 namespace dart {
 
+// A constant mask that can be 'and'ed with a word of data to determine if it
+// is all ASCII.
+#if defined(ARCH_IS_64_BIT)
+static const uword kAsciiWordMask = DART_UINT64_C(0x8080808080808080);
+#else
+static const uword kAsciiWordMask = 0x80808080u;
+#endif
+
 // clang-format off
 const int8_t Utf8::kTrailBytes[256] = {
   1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
@@ -50,6 +65,13 @@ intptr_t Utf8::CodeUnitCount(const uint8_t* utf8_array,
   Type char_type = kLatin1;
   for (intptr_t i = 0; i < array_len; i++) {
     uint8_t code_unit = utf8_array[i];
+    if (code_unit <= kMaxOneByteChar) {
+      // Each ASCII code unit is one code unit in any form.
+      intptr_t ascii_len = AsciiPrefixLength(&utf8_array[i], array_len - i);
+      len += ascii_len;
+      i += ascii_len - 1;
+      continue;
+    }
     if (!IsTrailByte(code_unit)) {
       ++len;
       if (!IsLatin1SequenceStart(code_unit)) {          // > U+00FF
@@ -72,7 +94,9 @@ bool Utf8::IsValid(const uint8_t* utf8_array, intptr_t array_len) {
   while (i < array_len) {
     uint32_t ch = utf8_array[i] & 0xFF;
     intptr_t j = 1;
-    if (ch >= 0x80) {
+    if (ch <= kMaxOneByteChar) {
+      j = AsciiPrefixLength(&utf8_array[i], array_len - i);
+    } else {
       int8_t num_trail_bytes = kTrailBytes[ch];
       bool is_malformed = false;
       for (; j < num_trail_bytes; ++j) {
@@ -95,6 +119,41 @@ bool Utf8::IsValid(const uint8_t* utf8_array, intptr_t array_len) {
   return true;
 }
 
+intptr_t Utf8::AsciiPrefixLength(const uint8_t* utf8_array,
+                                 intptr_t array_len) {
+  intptr_t i = 0;
+  // SSE2 and NEON are part of the x64 and ARM64 baselines, so these need no
+  // CPU feature check.
+#if defined(HOST_ARCH_X64)
+  for (; i + 16 <= array_len; i += 16) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&utf8_array[i]));
+    // The high bit of each byte, which is only set outside ASCII.
+    uint32_t non_ascii = _mm_movemask_epi8(chunk);
+    if (non_ascii != 0) {
+      return i + Utils::CountTrailingZeros32(non_ascii);
+    }
+  }
+#elif defined(HOST_ARCH_ARM64)
+  for (; i + 16 <= array_len; i += 16) {
+    if (vmaxvq_u8(vld1q_u8(&utf8_array[i])) > kMaxOneByteChar) {
+      break;
+    }
+  }
+#endif
+  for (; i + static_cast<intptr_t>(sizeof(uword)) <= array_len;
+       i += sizeof(uword)) {
+    uword chunk = ReadUnaligned(reinterpret_cast<const uword*>(&utf8_array[i]));
+    if ((chunk & kAsciiWordMask) != 0) {
+      break;
+    }
+  }
+  while ((i < array_len) && (utf8_array[i] <= kMaxOneByteChar)) {
+    i++;
+  }
+  return i;
+}
+
 intptr_t Utf8::Length(int32_t ch) {
   if (ch <= kMaxOneByteChar) {
     return 1;
@@ -200,6 +259,15 @@ bool Utf8::DecodeToLatin1(const uint8_t* utf8_array,
   intptr_t num_bytes;
   for (; (i < array_len) && (j < len); i += num_bytes, ++j) {
     int32_t ch;
+    if (utf8_array[i] <= kMaxOneByteChar) {
+      // Runs of ASCII are copied as they are.
+      intptr_t ascii_len = Utils::Minimum(
+          AsciiPrefixLength(&utf8_array[i], array_len - i), len - j);
+      memmove(&dst[j], &utf8_array[i], ascii_len);
+      num_bytes = ascii_len;
+      j += ascii_len - 1;
+      continue;
+    }
     ASSERT(IsLatin1SequenceStart(utf8_array[i]));
     num_bytes = Utf8::Decode(&utf8_array[i], (array_len - i), &ch);
     if (ch == -1) {
@@ -223,6 +291,17 @@ bool Utf8::DecodeToUTF16(const uint8_t* utf8_array,
   intptr_t num_bytes;
   for (; (i < array_len) && (j < len); i += num_bytes, ++j) {
     int32_t ch;
+    if (utf8_array[i] <= kMaxOneByteChar) {
+      // Runs of ASCII are widened without decoding each code unit.
+      intptr_t ascii_len = Utils::Minimum(
+          AsciiPrefixLength(&utf8_array[i], array_len - i), len - j);
+      for (intptr_t k = 0; k < ascii_len; k++) {
+        dst[j + k] = utf8_array[i + k];
+      }
+      num_bytes = ascii_len;
+      j += ascii_len - 1;
+      continue;
+    }
     bool is_supplementary = IsSupplementarySequenceStart(utf8_array[i]);
     num_bytes = Utf8::Decode(&utf8_array[i], (array_len - i), &ch);
     if (ch == -1) {
@@ -53,6 +53,10 @@ class Utf8 : AllStatic {
   // Returns true if 'utf8_array' is a valid UTF-8 string.
   static bool IsValid(const uint8_t* utf8_array, intptr_t array_len);
 
+  // Returns the number of leading code units of 'utf8_array' that are ASCII.
+  static intptr_t AsciiPrefixLength(const uint8_t* utf8_array,
+                                    intptr_t array_len);
+
   static intptr_t Length(int32_t ch);
   static intptr_t Length(const String& str);
 
@@ -126,6 +126,9 @@ namespace dart {
   V(OneByteString_allocateFromOneByteList, 3)                                  \
   V(OneByteString_setAt, 3)                                                    \
   V(TwoByteString_allocateFromTwoByteList, 3)                                  \
+  V(Utf8_scanOneByteCharacters, 3)                                             \
+  V(Json_decode, 1)                                                            \
+  V(Json_encode, 3)                                                            \
   V(String_getHashCode, 1)                                                     \
   V(String_getLength, 1)                                                       \
   V(String_charAt, 2)                                                          \
@@ -135,6 +138,7 @@ namespace dart {
   V(String_toLowerCase, 1)                                                     \
   V(String_toUpperCase, 1)                                                     \
   V(String_concatRange, 3)                                                     \
+  V(String_indexOf, 3)                                                         \
   V(Math_sqrt, 1)                                                              \
   V(Math_sin, 1)                                                               \
   V(Math_cos, 1)                                                               \
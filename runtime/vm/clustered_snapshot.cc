@@ -14,12 +14,14 @@
 #include "vm/dart.h"
 #include "vm/heap/heap.h"
 #include "vm/image_snapshot.h"
+#include "vm/lockers.h"
 #include "vm/native_entry.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/program_visitor.h"
 #include "vm/stub_code.h"
 #include "vm/symbols.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 #include "vm/version.h"
 
@@ -222,6 +224,9 @@ class ClassDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  // Registers classes in the isolate's class table.
+  bool CanFillConcurrently() const { return false; }
+
   void ReadFill(Deserializer* d) {
     ClassTable* table = d->isolate()->class_table();
 
@@ -1515,27 +1520,13 @@ class CodeDeserializationCluster : public DeserializationCluster {
       RawCode* code = reinterpret_cast<RawCode*>(d->Ref(id));
       Deserializer::InitializeHeader(code, kCodeCid, Code::InstanceSize(0));
 
-      RawInstructions* instr = d->ReadInstructions();
-
-      code->ptr()->entry_point_ = Instructions::EntryPoint(instr);
-      code->ptr()->monomorphic_entry_point_ =
-          Instructions::MonomorphicEntryPoint(instr);
-      code->ptr()->unchecked_entry_point_ =
-          Instructions::UncheckedEntryPoint(instr);
-      code->ptr()->monomorphic_unchecked_entry_point_ =
-          Instructions::MonomorphicUncheckedEntryPoint(instr);
+      RawInstructions* instr = d->ReadInstructions(code);
       NOT_IN_PRECOMPILED(code->ptr()->active_instructions_ = instr);
       code->ptr()->instructions_ = instr;
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
       if (d->kind() == Snapshot::kFullJIT) {
-        RawInstructions* instr = d->ReadInstructions();
-        code->ptr()->active_instructions_ = instr;
-        code->ptr()->entry_point_ = Instructions::EntryPoint(instr);
-        code->ptr()->monomorphic_entry_point_ =
-            Instructions::MonomorphicEntryPoint(instr);
-        code->ptr()->unchecked_entry_point_ =
-            Instructions::UncheckedEntryPoint(instr);
+        code->ptr()->active_instructions_ = d->ReadInstructions(code);
       }
 #endif  // !DART_PRECOMPILED_RUNTIME
 
@@ -2529,6 +2520,7 @@ class SubtypeTestCacheSerializationCluster : public SerializationCluster {
       RawSubtypeTestCache* cache = objects_[i];
       AutoTraceObject(cache);
       WriteField(cache, cache_);
+      s->Write<int32_t>(cache->ptr()->num_inputs_);
     }
   }
 
@@ -2560,6 +2552,7 @@ class SubtypeTestCacheDeserializationCluster : public DeserializationCluster {
       Deserializer::InitializeHeader(cache, kSubtypeTestCacheCid,
                                      SubtypeTestCache::InstanceSize());
       cache->ptr()->cache_ = reinterpret_cast<RawArray*>(d->ReadRef());
+      cache->ptr()->num_inputs_ = d->Read<int32_t>();
     }
   }
 };
@@ -3361,11 +3354,38 @@ class DoubleSerializationCluster : public SerializationCluster {
 
   void Trace(Serializer* s, RawObject* object) {
     RawDouble* dbl = Double::RawCast(object);
-    objects_.Add(dbl);
+    // Canonical doubles are never mutated, so AOT snapshots place them in the
+    // read-only data image, where they are shared between processes.
+    if ((s->kind() == Snapshot::kFullAOT) && dbl->IsCanonical()) {
+      if (!dbl->InVMIsolateHeap() &&
+          !s->isolate()->heap()->old_space()->IsObjectFromImagePages(dbl)) {
+        Object::FinalizeReadOnlyObject(dbl);
+      }
+      ro_objects_.Add(dbl);
+    } else {
+      objects_.Add(dbl);
+    }
   }
 
   void WriteAlloc(Serializer* s) {
     s->WriteCid(kDoubleCid);
+    if (s->kind() == Snapshot::kFullAOT) {
+      const intptr_t ro_count = ro_objects_.length();
+      s->WriteUnsigned(ro_count);
+      uint32_t running_offset = 0;
+      for (intptr_t i = 0; i < ro_count; i++) {
+        RawDouble* dbl = ro_objects_[i];
+        s->AssignRef(dbl);
+        AutoTraceObject(dbl);
+        uint32_t offset = s->GetDataOffset(dbl);
+        s->TraceDataOffset(offset);
+        ASSERT(offset > running_offset);
+        s->WriteUnsigned(
+            (offset - running_offset) >>
+            compiler::target::ObjectAlignment::kObjectAlignmentLog2);
+        running_offset = offset;
+      }
+    }
     const intptr_t count = objects_.length();
     s->WriteUnsigned(count);
     for (intptr_t i = 0; i < count; i++) {
@@ -3386,6 +3406,7 @@ class DoubleSerializationCluster : public SerializationCluster {
 
  private:
   GrowableArray<RawDouble*> objects_;
+  GrowableArray<RawDouble*> ro_objects_;
 };
 #endif  // !DART_PRECOMPILED_RUNTIME
 
@@ -3395,6 +3416,15 @@ class DoubleDeserializationCluster : public DeserializationCluster {
   ~DoubleDeserializationCluster() {}
 
   void ReadAlloc(Deserializer* d) {
+    if (d->kind() == Snapshot::kFullAOT) {
+      const intptr_t ro_count = d->ReadUnsigned();
+      uint32_t running_offset = 0;
+      for (intptr_t i = 0; i < ro_count; i++) {
+        running_offset += d->ReadUnsigned() << kObjectAlignmentLog2;
+        d->AssignRef(d->GetObjectAt(running_offset));
+      }
+    }
+
     start_index_ = d->next_index();
     PageSpace* old_space = d->heap()->old_space();
     const intptr_t count = d->ReadUnsigned();
@@ -4002,6 +4032,9 @@ class LinkedHashMapDeserializationCluster : public DeserializationCluster {
     stop_index_ = d->next_index();
   }
 
+  // Allocates the maps' data arrays.
+  bool CanFillConcurrently() const { return false; }
+
   void ReadFill(Deserializer* d) {
     PageSpace* old_space = d->heap()->old_space();
 
@@ -4303,6 +4336,17 @@ class FakeSerializationCluster : public SerializationCluster {
 static const int32_t kSectionMarker = 0xABAB;
 #endif
 
+// Below this size, filling on the main thread is faster than starting helper
+// tasks.
+static const intptr_t kMinConcurrentFillSize = 256 * KB;
+
+// Helper deserializers read from the start of the fill sections, so that
+// start is aligned for any data the clusters align, such as the payloads of
+// external typed data. Their positions are then aligned like the
+// serializer's.
+static const intptr_t kFillSectionsAlignment =
+    ExternalTypedData::kDataSerializationAlignment;
+
 Serializer::Serializer(Thread* thread,
                        Snapshot::Kind kind,
                        uint8_t** buffer,
@@ -4529,6 +4573,10 @@ void Serializer::WriteInstructions(RawInstructions* instr, RawCode* code) {
     UnexpectedObject(code, "Expected instructions to reuse");
   }
   Write<uint32_t>(offset);
+  // Entry point layout is duplicated here so the reader can compute entry
+  // points without paging in the instructions, most of which are never run.
+  WriteUnsigned(Instructions::UncheckedEntryPointPcOffset(instr));
+  Write<bool>(Instructions::HasSingleEntryPoint(instr));
 
   // If offset < 0, it's pointing to a shared instruction. We don't profile
   // references to shared text/data (since they don't consume any space). Of
@@ -4791,15 +4839,37 @@ void Serializer::Serialize() {
   // We should have assigned a ref to every object we pushed.
   ASSERT((next_ref_index_ - 1) == num_objects);
 
+  // Reserve a table with the offset of each cluster's fill section, and of
+  // the end of the last one, so the reader can fill clusters in parallel. It
+  // is patched once the fill sections have been written, so its entries are
+  // fixed width.
+  const intptr_t fill_table_position = stream_.Position();
+  for (intptr_t i = 0; i <= num_clusters; i++) {
+    stream_.WriteFixed<uint32_t>(0);
+  }
+  Align(kFillSectionsAlignment);
+  const intptr_t fill_start = stream_.Position();
+  GrowableArray<uint32_t> fill_offsets(num_clusters + 1);
+
   for (intptr_t cid = 1; cid < num_cids_; cid++) {
     SerializationCluster* cluster = clusters_by_cid_[cid];
     if (cluster != NULL) {
+      fill_offsets.Add(stream_.Position() - fill_start);
       cluster->WriteAndMeasureFill(this);
 #if defined(DEBUG)
       Write<int32_t>(kSectionMarker);
 #endif
     }
   }
+  fill_offsets.Add(stream_.Position() - fill_start);
+  ASSERT(fill_offsets.length() == num_clusters + 1);
+
+  const intptr_t fill_end = stream_.Position();
+  stream_.SetPosition(fill_table_position);
+  for (intptr_t i = 0; i <= num_clusters; i++) {
+    stream_.WriteFixed<uint32_t>(fill_offsets[i]);
+  }
+  stream_.SetPosition(fill_end);
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
   if (FLAG_print_snapshot_sizes_verbose) {
@@ -5001,6 +5071,23 @@ Deserializer::Deserializer(Thread* thread,
   stream_.SetPosition(offset);
 }
 
+Deserializer::Deserializer(const Deserializer& parent,
+                           const uint8_t* buffer,
+                           intptr_t size)
+    : ThreadStackResource(nullptr),
+      heap_(parent.heap_),
+      zone_(nullptr),
+      kind_(parent.kind_),
+      stream_(buffer, size),
+      image_reader_(parent.image_reader_),
+      num_base_objects_(parent.num_base_objects_),
+      num_objects_(parent.num_objects_),
+      num_clusters_(0),
+      code_order_length_(parent.code_order_length_),
+      refs_(parent.refs_),
+      next_ref_index_(parent.next_ref_index_),
+      clusters_(NULL) {}
+
 Deserializer::~Deserializer() {
   delete[] clusters_;
 }
@@ -5246,9 +5333,26 @@ RawApiError* FullSnapshotReader::ConvertToApiError(char* message) {
   return ApiError::New(msg, Heap::kOld);
 }
 
-RawInstructions* Deserializer::ReadInstructions() {
+RawInstructions* Deserializer::ReadInstructions(RawCode* code) {
   uint32_t offset = Read<uint32_t>();
-  return image_reader_->GetInstructionsAt(offset);
+  const uint32_t unchecked_offset = ReadUnsigned();
+  const bool has_single_entry_point = Read<bool>();
+  RawInstructions* instr = image_reader_->GetInstructionsAt(offset);
+
+  // The Instructions accessors would read the header from the text image,
+  // paging in the code of every function at startup.
+  const uword payload_start = Instructions::PayloadStart(instr);
+  code->ptr()->entry_point_ =
+      Instructions::EntryPoint(payload_start, has_single_entry_point);
+  code->ptr()->monomorphic_entry_point_ =
+      Instructions::MonomorphicEntryPoint(payload_start,
+                                          has_single_entry_point);
+  code->ptr()->unchecked_entry_point_ = Instructions::UncheckedEntryPoint(
+      payload_start, unchecked_offset, has_single_entry_point);
+  code->ptr()->monomorphic_unchecked_entry_point_ =
+      Instructions::MonomorphicUncheckedEntryPoint(
+          payload_start, unchecked_offset, has_single_entry_point);
+  return instr;
 }
 
 RawObject* Deserializer::GetObjectAt(uint32_t offset) const {
@@ -5272,25 +5376,165 @@ void Deserializer::Deserialize() {
            num_base_objects_, next_ref_index_ - 1);
   }
 
-  for (intptr_t i = 0; i < num_clusters_; i++) {
-    clusters_[i] = ReadCluster();
-    clusters_[i]->ReadAlloc(this);
+  {
+    TIMELINE_DURATION(thread(), Isolate, "ReadAlloc");
+    for (intptr_t i = 0; i < num_clusters_; i++) {
+      clusters_[i] = ReadCluster();
+      clusters_[i]->ReadAlloc(this);
 #if defined(DEBUG)
-    intptr_t serializers_next_ref_index_ = Read<int32_t>();
-    ASSERT(serializers_next_ref_index_ == next_ref_index_);
+      intptr_t serializers_next_ref_index_ = Read<int32_t>();
+      ASSERT(serializers_next_ref_index_ == next_ref_index_);
 #endif
+    }
   }
 
   // We should have completely filled the ref array.
   ASSERT((next_ref_index_ - 1) == num_objects_);
 
+  uint32_t* fill_offsets = zone_->Alloc<uint32_t>(num_clusters_ + 1);
+  ReadBytes(reinterpret_cast<uint8_t*>(fill_offsets),
+            (num_clusters_ + 1) * sizeof(uint32_t));
+  Align(kFillSectionsAlignment);
+#if defined(DEBUG)
+  ASSERT(fill_offsets[0] == 0);
+  for (intptr_t i = 0; i < num_clusters_; i++) {
+    ASSERT(fill_offsets[i] <= fill_offsets[i + 1]);
+  }
+#endif
+  const uint8_t* fill_start = CurrentBufferAddress();
+  const intptr_t fill_size = fill_offsets[num_clusters_];
+
+  TIMELINE_DURATION(thread(), Isolate, "ReadFill");
+  intptr_t num_tasks = FLAG_snapshot_fill_tasks;
+  if ((fill_size < kMinConcurrentFillSize) || (num_clusters_ < 2)) {
+    num_tasks = 0;
+  }
+  if (num_tasks > 0) {
+    FillClustersConcurrently(fill_start, fill_offsets, num_tasks);
+    Advance(fill_size);
+  } else {
+    for (intptr_t i = 0; i < num_clusters_; i++) {
+      clusters_[i]->ReadFill(this);
+#if defined(DEBUG)
+      int32_t section_marker = Read<int32_t>();
+      ASSERT(section_marker == kSectionMarker);
+#endif
+    }
+  }
+  ASSERT(CurrentBufferAddress() == fill_start + fill_size);
+}
+
+// Fills the clusters that can be filled concurrently, claiming them one at a
+// time from [next_cluster]. [d] reads from the start of the fill section.
+static void FillClusters(Deserializer* d,
+                         DeserializationCluster** clusters,
+                         intptr_t num_clusters,
+                         const uint32_t* fill_offsets,
+                         RelaxedAtomic<intptr_t>* next_cluster) {
+  for (intptr_t i = next_cluster->fetch_add(1); i < num_clusters;
+       i = next_cluster->fetch_add(1)) {
+    if (!clusters[i]->CanFillConcurrently()) continue;
+    // An empty section may start at the very end of the stream.
+    if (fill_offsets[i] != fill_offsets[i + 1]) {
+      d->SetPosition(fill_offsets[i]);
+    }
+    clusters[i]->ReadFill(d);
+#if defined(DEBUG)
+    int32_t section_marker = d->Read<int32_t>();
+    ASSERT(section_marker == kSectionMarker);
+#endif
+  }
+}
+
+class FillClustersTask : public ThreadPool::Task {
+ public:
+  FillClustersTask(const Deserializer* parent,
+                   const uint8_t* fill_start,
+                   intptr_t fill_size,
+                   DeserializationCluster** clusters,
+                   intptr_t num_clusters,
+                   const uint32_t* fill_offsets,
+                   RelaxedAtomic<intptr_t>* next_cluster,
+                   Monitor* monitor,
+                   intptr_t* pending_tasks)
+      : parent_(parent),
+        fill_start_(fill_start),
+        fill_size_(fill_size),
+        clusters_(clusters),
+        num_clusters_(num_clusters),
+        fill_offsets_(fill_offsets),
+        next_cluster_(next_cluster),
+        monitor_(monitor),
+        pending_tasks_(pending_tasks) {}
+
+  virtual void Run() {
+    {
+      Deserializer d(*parent_, fill_start_, fill_size_);
+      FillClusters(&d, clusters_, num_clusters_, fill_offsets_, next_cluster_);
+    }
+    MonitorLocker ml(monitor_);
+    if (--(*pending_tasks_) == 0) {
+      ml.Notify();
+    }
+  }
+
+ private:
+  const Deserializer* parent_;
+  const uint8_t* fill_start_;
+  intptr_t fill_size_;
+  DeserializationCluster** clusters_;
+  intptr_t num_clusters_;
+  const uint32_t* fill_offsets_;
+  RelaxedAtomic<intptr_t>* next_cluster_;
+  Monitor* monitor_;
+  intptr_t* pending_tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(FillClustersTask);
+};
+
+void Deserializer::FillClustersConcurrently(const uint8_t* fill_start,
+                                            const uint32_t* fill_offsets,
+                                            intptr_t num_tasks) {
+  const intptr_t fill_size = fill_offsets[num_clusters_];
+  const intptr_t fill_position = stream_.Position();
+  RelaxedAtomic<intptr_t> next_cluster = {0};
+  Monitor monitor;
+  intptr_t pending_tasks = 0;
+
+  for (intptr_t i = 0; i < num_tasks; i++) {
+    {
+      MonitorLocker ml(&monitor);
+      pending_tasks++;
+    }
+    if (!Dart::thread_pool()->Run<FillClustersTask>(
+            this, fill_start, fill_size, clusters_, num_clusters_,
+            fill_offsets, &next_cluster, &monitor, &pending_tasks)) {
+      MonitorLocker ml(&monitor);
+      pending_tasks--;
+    }
+  }
+
+  // Clusters that need the isolate are filled here, after which this thread
+  // helps with the remaining ones.
   for (intptr_t i = 0; i < num_clusters_; i++) {
+    if (clusters_[i]->CanFillConcurrently()) continue;
+    stream_.SetPosition(fill_position + fill_offsets[i]);
     clusters_[i]->ReadFill(this);
 #if defined(DEBUG)
     int32_t section_marker = Read<int32_t>();
     ASSERT(section_marker == kSectionMarker);
 #endif
   }
+  {
+    Deserializer d(*this, fill_start, fill_size);
+    FillClusters(&d, clusters_, num_clusters_, fill_offsets, &next_cluster);
+  }
+
+  MonitorLocker ml(&monitor);
+  while (pending_tasks > 0) {
+    ml.Wait();
+  }
+  stream_.SetPosition(fill_position);
 }
 
 class HeapLocker : public StackResource {
@@ -5453,8 +5697,11 @@ void Deserializer::ReadIsolateSnapshot(ObjectStore* object_store) {
   isolate->heap()->Verify();
 #endif
 
-  for (intptr_t i = 0; i < num_clusters_; i++) {
-    clusters_[i]->PostLoad(refs, kind_, zone_);
+  {
+    TIMELINE_DURATION(thread(), Isolate, "PostLoad");
+    for (intptr_t i = 0; i < num_clusters_; i++) {
+      clusters_[i]->PostLoad(refs, kind_, zone_);
+    }
   }
 
   // Setup native resolver for bootstrap impl.
@@ -92,6 +92,11 @@ class DeserializationCluster : public ZoneAllocated {
   // Initialize the cluster's objects. Do not touch the memory of other objects.
   virtual void ReadFill(Deserializer* deserializer) = 0;
 
+  // Whether ReadFill may run on a helper thread, concurrently with the fill of
+  // other clusters. Such a fill may only use the deserializer's stream, refs
+  // and images: it must not allocate or use the isolate.
+  virtual bool CanFillConcurrently() const { return true; }
+
   // Complete any action that requires the full graph to be deserialized, such
   // as rehashing.
   virtual void PostLoad(const Array& refs, Snapshot::Kind kind, Zone* zone) {}
@@ -467,6 +472,11 @@ class Deserializer : public ThreadStackResource {
                const uint8_t* data_buffer,
                const uint8_t* instructions_buffer,
                intptr_t offset = 0);
+  // Creates a deserializer for filling clusters on a helper thread. It shares
+  // the refs and images of [parent] and reads from the fill section [buffer].
+  Deserializer(const Deserializer& parent,
+               const uint8_t* buffer,
+               intptr_t size);
   ~Deserializer();
 
   // Verifies the image alignment.
@@ -543,10 +553,13 @@ class Deserializer : public ThreadStackResource {
     return Read<int32_t>();
   }
 
-  RawInstructions* ReadInstructions();
+  // Reads a reference written by Serializer::WriteInstructions and sets the
+  // entry points of [code] from it.
+  RawInstructions* ReadInstructions(RawCode* code);
   RawObject* GetObjectAt(uint32_t offset) const;
 
   void SkipHeader() { stream_.SetPosition(Snapshot::kHeaderSize); }
+  void SetPosition(intptr_t value) { stream_.SetPosition(value); }
 
   void Prepare();
   void Deserialize();
@@ -573,6 +586,10 @@ class Deserializer : public ThreadStackResource {
   intptr_t code_order_length() const { return code_order_length_; }
 
  private:
+  void FillClustersConcurrently(const uint8_t* fill_start,
+                                const uint32_t* fill_offsets,
+                                intptr_t num_tasks);
+
   Heap* heap_;
   Zone* zone_;
   Snapshot::Kind kind_;
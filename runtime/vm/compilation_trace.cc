@@ -18,6 +18,11 @@ namespace dart {
 #if !defined(DART_PRECOMPILED_RUNTIME)
 
 DEFINE_FLAG(bool, trace_compilation_trace, false, "Trace compilation trace.");
+DEFINE_FLAG(bool,
+            optimize_loaded_type_feedback,
+            true,
+            "Optimize the hot functions in loaded type feedback right away. "
+            "Otherwise they are optimized when they are next called.");
 
 CompilationTraceSaver::CompilationTraceSaver(Zone* zone)
     : buf_(zone, 1 * MB),
@@ -637,7 +642,11 @@ RawObject* TypeFeedbackLoader::LoadFeedback(ReadStream* stream) {
     }
   }
 
-  while (functions_to_compile_.Length() > 0) {
+  // Without eager optimization the usage counters restored above make the
+  // functions optimize with the loaded feedback on their next call, so only
+  // code that actually runs is optimized.
+  while (FLAG_optimize_loaded_type_feedback &&
+         (functions_to_compile_.Length() > 0)) {
     func_ ^= functions_to_compile_.RemoveLast();
 
     if (Compiler::CanOptimizeFunction(thread_, func_) &&
@@ -2193,6 +2193,14 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   // Load the specialized function pointer into R0. Leverage the fact the
   // string CIDs as well as stored function pointers are in sequence.
   __ ldr(R2, Address(SP, kRegExpParamOffset));
+  if (FLAG_linear_regexp) {
+    // Regular expressions matched in linear time have no specialized
+    // functions and are matched by the native implementation.
+    __ ldr(R0, FieldAddress(R2, target::RegExp::function_offset(
+                                    kExternalOneByteStringCid, sticky)));
+    __ CompareObject(R0, NullObject());
+    __ b(normal_ir_body, EQ);
+  }
   __ ldr(R1, Address(SP, kStringParamOffset));
   __ LoadClassId(R1, R1);
   __ AddImmediate(R1, -kOneByteStringCid);
@@ -2207,6 +2215,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   // Tail-call the function.
   __ ldr(CODE_REG, FieldAddress(R0, target::Function::code_offset()));
   __ Branch(FieldAddress(R0, target::Function::entry_point_offset()));
+
+  if (FLAG_linear_regexp) {
+    __ Bind(normal_ir_body);
+  }
 }
 
 // On stack: user tag (+0).
@@ -2198,6 +2198,15 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   // Load the specialized function pointer into EAX. Leverage the fact the
   // string CIDs as well as stored function pointers are in sequence.
   __ movl(EBX, Address(ESP, kRegExpParamOffset));
+  if (FLAG_linear_regexp) {
+    // Regular expressions matched in linear time have no specialized
+    // functions and are matched by the native implementation.
+    __ movl(EAX,
+            FieldAddress(EBX, target::RegExp::function_offset(
+                                  kExternalOneByteStringCid, sticky)));
+    __ CompareObject(EAX, NullObject());
+    __ j(EQUAL, normal_ir_body);
+  }
   __ movl(EDI, Address(ESP, kStringParamOffset));
   __ LoadClassId(EDI, EDI);
   __ SubImmediate(EDI, Immediate(kOneByteStringCid));
@@ -2211,6 +2220,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
 
   // Tail-call the function.
   __ jmp(FieldAddress(EAX, target::Function::entry_point_offset()));
+
+  if (FLAG_linear_regexp) {
+    __ Bind(normal_ir_body);
+  }
 }
 
 // On stack: user tag (+1), return-address (+0).
@@ -2164,29 +2164,38 @@ static void StringEquality(Assembler* assembler,
   __ cmpq(RDI, FieldAddress(RCX, target::String::length_offset()));
   __ j(NOT_EQUAL, &is_false, Assembler::kNearJump);
 
-  // Check contents, no fall-through possible.
-  // TODO(srdjan): write a faster check.
-  __ SmiUntag(RDI);
+  // Check contents, no fall-through possible. A word of code units is
+  // compared at a time, from the end, and then the remaining bytes.
+  ASSERT((string_cid == kOneByteStringCid) ||
+         (string_cid == kTwoByteStringCid));
+  const intptr_t data_offset = (string_cid == kOneByteStringCid)
+                                   ? target::OneByteString::data_offset()
+                                   : target::TwoByteString::data_offset();
+  if (string_cid == kOneByteStringCid) {
+    __ SmiUntag(RDI);
+  } else {
+    // The tagged length of a two-byte string is its length in bytes.
+    ASSERT(kSmiTagShift == 1);
+  }
+  Label byte_loop;
   __ Bind(&loop);
+  __ cmpq(RDI, Immediate(target::kWordSize));
+  __ j(LESS, &byte_loop, Assembler::kNearJump);
+  __ subq(RDI, Immediate(target::kWordSize));
+  __ movq(RBX, FieldAddress(RAX, RDI, TIMES_1, data_offset));
+  __ cmpq(RBX, FieldAddress(RCX, RDI, TIMES_1, data_offset));
+  __ j(NOT_EQUAL, &is_false, Assembler::kNearJump);
+  __ jmp(&loop, Assembler::kNearJump);
+
+  __ Bind(&byte_loop);
   __ decq(RDI);
   __ cmpq(RDI, Immediate(0));
   __ j(LESS, &is_true, Assembler::kNearJump);
-  if (string_cid == kOneByteStringCid) {
-    __ movzxb(RBX, FieldAddress(RAX, RDI, TIMES_1,
-                                target::OneByteString::data_offset()));
-    __ movzxb(RDX, FieldAddress(RCX, RDI, TIMES_1,
-                                target::OneByteString::data_offset()));
-  } else if (string_cid == kTwoByteStringCid) {
-    __ movzxw(RBX, FieldAddress(RAX, RDI, TIMES_2,
-                                target::TwoByteString::data_offset()));
-    __ movzxw(RDX, FieldAddress(RCX, RDI, TIMES_2,
-                                target::TwoByteString::data_offset()));
-  } else {
-    UNIMPLEMENTED();
-  }
+  __ movzxb(RBX, FieldAddress(RAX, RDI, TIMES_1, data_offset));
+  __ movzxb(RDX, FieldAddress(RCX, RDI, TIMES_1, data_offset));
   __ cmpq(RBX, RDX);
   __ j(NOT_EQUAL, &is_false, Assembler::kNearJump);
-  __ jmp(&loop, Assembler::kNearJump);
+  __ jmp(&byte_loop, Assembler::kNearJump);
 
   __ Bind(&is_true);
   __ LoadObject(RAX, CastHandle<Object>(TrueObject()));
@@ -2226,6 +2235,15 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   // Load the specialized function pointer into RAX. Leverage the fact the
   // string CIDs as well as stored function pointers are in sequence.
   __ movq(RBX, Address(RSP, kRegExpParamOffset));
+  if (FLAG_linear_regexp) {
+    // Regular expressions matched in linear time have no specialized
+    // functions and are matched by the native implementation.
+    __ movq(RAX,
+            FieldAddress(RBX, target::RegExp::function_offset(
+                                  kExternalOneByteStringCid, sticky)));
+    __ CompareObject(RAX, NullObject());
+    __ j(EQUAL, normal_ir_body);
+  }
   __ movq(RDI, Address(RSP, kStringParamOffset));
   __ LoadClassId(RDI, RDI);
   __ SubImmediate(RDI, Immediate(kOneByteStringCid));
@@ -2241,6 +2259,10 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ movq(CODE_REG, FieldAddress(RAX, target::Function::code_offset()));
   __ movq(RDI, FieldAddress(RAX, target::Function::entry_point_offset()));
   __ jmp(RDI);
+
+  if (FLAG_linear_regexp) {
+    __ Bind(normal_ir_body);
+  }
 }
 
 // On stack: user tag (+1), return-address (+0).
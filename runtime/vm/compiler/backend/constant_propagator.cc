@@ -1279,6 +1279,10 @@ void ConstantPropagator::VisitCaseInsensitiveCompare(
   SetValue(instr, non_constant_);
 }
 
+void ConstantPropagator::VisitFindBitInTable(FindBitInTableInstr* instr) {
+  SetValue(instr, non_constant_);
+}
+
 void ConstantPropagator::VisitUnbox(UnboxInstr* instr) {
   const Object& value = instr->value()->definition()->constant_value();
   if (IsNonConstant(value)) {
@@ -939,11 +939,12 @@ class FlowGraphCompiler : public ValueObject {
       compiler::Label* is_instance_lbl,
       compiler::Label* is_not_instance_lbl);
 
+  // The value of each kind is the number of inputs its stub compares.
   enum TypeTestStubKind {
-    kTestTypeOneArg,
-    kTestTypeTwoArgs,
-    kTestTypeFourArgs,
-    kTestTypeSixArgs,
+    kTestTypeOneArg = 1,
+    kTestTypeTwoArgs = 2,
+    kTestTypeFourArgs = 4,
+    kTestTypeSixArgs = 6,
   };
 
   RawSubtypeTestCache* GenerateCallSubtypeTestStub(
@@ -459,6 +459,7 @@ struct InstrAttrs {
   M(BoxInt64, _)                                                               \
   M(UnboxInt64, kNoGC)                                                         \
   M(CaseInsensitiveCompare, _)                                                 \
+  M(FindBitInTable, _)                                                         \
   M(BinaryInt64Op, kNoGC)                                                      \
   M(ShiftInt64Op, kNoGC)                                                       \
   M(SpeculativeShiftInt64Op, kNoGC)                                            \
@@ -6412,6 +6413,44 @@ class CaseInsensitiveCompareInstr
   DISALLOW_COPY_AND_ASSIGN(CaseInsensitiveCompareInstr);
 };
 
+// Calls into the runtime and returns the first index at or after start, in
+// steps of advance_by, of a code unit in str whose value (modulus the table
+// size) is set in the bitmap table, or the first such index at or after the
+// end of str. See RegExpMacroAssembler::SkipUntilBitInTable.
+class FindBitInTableInstr : public TemplateDefinition<4, NoThrow, Pure> {
+ public:
+  FindBitInTableInstr(Value* str,
+                      Value* start,
+                      Value* table,
+                      Value* advance_by) {
+    SetInputAt(0, str);
+    SetInputAt(1, start);
+    SetInputAt(2, table);
+    SetInputAt(3, advance_by);
+  }
+
+  Value* str() const { return inputs_[0]; }
+  Value* start() const { return inputs_[1]; }
+  Value* table() const { return inputs_[2]; }
+  Value* advance_by() const { return inputs_[3]; }
+
+  const RuntimeEntry& TargetFunction() const {
+    return kFindBitInTableRuntimeEntry;
+  }
+
+  virtual bool ComputeCanDeoptimize() const { return false; }
+
+  virtual Representation representation() const { return kTagged; }
+
+  DECLARE_INSTRUCTION(FindBitInTable)
+  virtual CompileType ComputeType() const;
+
+  virtual bool AttributesEqual(Instruction* other) const { return true; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(FindBitInTableInstr);
+};
+
 // Represents Math's static min and max functions.
 class MathMinMaxInstr : public TemplateDefinition<2, NoThrow, Pure> {
  public:
@@ -5417,6 +5417,24 @@ void CaseInsensitiveCompareInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ CallRuntime(TargetFunction(), TargetFunction().argument_count());
 }
 
+LocationSummary* FindBitInTableInstr::MakeLocationSummary(Zone* zone,
+                                                          bool opt) const {
+  const intptr_t kNumTemps = 0;
+  LocationSummary* summary = new (zone)
+      LocationSummary(zone, InputCount(), kNumTemps, LocationSummary::kCall);
+  summary->set_in(0, Location::RegisterLocation(R0));
+  summary->set_in(1, Location::RegisterLocation(R1));
+  summary->set_in(2, Location::RegisterLocation(R2));
+  summary->set_in(3, Location::RegisterLocation(R3));
+  summary->set_out(0, Location::RegisterLocation(R0));
+  return summary;
+}
+
+void FindBitInTableInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  // Call the function.
+  __ CallRuntime(TargetFunction(), TargetFunction().argument_count());
+}
+
 LocationSummary* MathMinMaxInstr::MakeLocationSummary(Zone* zone,
                                                       bool opt) const {
   if (result_cid() == kDoubleCid) {
@@ -4658,6 +4658,38 @@ void CaseInsensitiveCompareInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ movl(ESP, kSavedSPReg);
 }
 
+LocationSummary* FindBitInTableInstr::MakeLocationSummary(Zone* zone,
+                                                          bool opt) const {
+  const intptr_t kNumTemps = 0;
+  LocationSummary* summary = new (zone)
+      LocationSummary(zone, InputCount(), kNumTemps, LocationSummary::kCall);
+  summary->set_in(0, Location::RegisterLocation(EAX));
+  summary->set_in(1, Location::RegisterLocation(ECX));
+  summary->set_in(2, Location::RegisterLocation(EDX));
+  summary->set_in(3, Location::RegisterLocation(EBX));
+  summary->set_out(0, Location::RegisterLocation(EAX));
+  return summary;
+}
+
+void FindBitInTableInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  // Save ESP. EDI is chosen because it is callee saved so we do not need to
+  // back it up before calling into the runtime.
+  static const Register kSavedSPReg = EDI;
+  __ movl(kSavedSPReg, ESP);
+  __ ReserveAlignedFrameSpace(kWordSize * TargetFunction().argument_count());
+
+  __ movl(compiler::Address(ESP, +0 * kWordSize), locs()->in(0).reg());
+  __ movl(compiler::Address(ESP, +1 * kWordSize), locs()->in(1).reg());
+  __ movl(compiler::Address(ESP, +2 * kWordSize), locs()->in(2).reg());
+  __ movl(compiler::Address(ESP, +3 * kWordSize), locs()->in(3).reg());
+
+  // Call the function.
+  __ CallRuntime(TargetFunction(), TargetFunction().argument_count());
+
+  // Restore ESP and pop the old value off the stack.
+  __ movl(ESP, kSavedSPReg);
+}
+
 LocationSummary* MathMinMaxInstr::MakeLocationSummary(Zone* zone,
                                                       bool opt) const {
   if (result_cid() == kDoubleCid) {
@@ -4749,6 +4749,33 @@ void CaseInsensitiveCompareInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ movq(RSP, kSavedSPReg);
 }
 
+LocationSummary* FindBitInTableInstr::MakeLocationSummary(Zone* zone,
+                                                          bool opt) const {
+  const intptr_t kNumTemps = 0;
+  LocationSummary* summary = new (zone)
+      LocationSummary(zone, InputCount(), kNumTemps, LocationSummary::kCall);
+  summary->set_in(0, Location::RegisterLocation(CallingConventions::kArg1Reg));
+  summary->set_in(1, Location::RegisterLocation(CallingConventions::kArg2Reg));
+  summary->set_in(2, Location::RegisterLocation(CallingConventions::kArg3Reg));
+  summary->set_in(3, Location::RegisterLocation(CallingConventions::kArg4Reg));
+  summary->set_out(0, Location::RegisterLocation(RAX));
+  return summary;
+}
+
+void FindBitInTableInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  // Save RSP. R13 is chosen because it is callee saved so we do not need to
+  // back it up before calling into the runtime.
+  static const Register kSavedSPReg = R13;
+  __ movq(kSavedSPReg, RSP);
+  __ ReserveAlignedFrameSpace(0);
+
+  // Call the function. Parameters are already in their correct spots.
+  __ CallRuntime(TargetFunction(), TargetFunction().argument_count());
+
+  // Restore RSP.
+  __ movq(RSP, kSavedSPReg);
+}
+
 LocationSummary* UnarySmiOpInstr::MakeLocationSummary(Zone* zone,
                                                       bool opt) const {
   const intptr_t kNumInputs = 1;
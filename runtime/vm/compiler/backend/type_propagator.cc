@@ -1575,6 +1575,10 @@ CompileType CaseInsensitiveCompareInstr::ComputeType() const {
   return CompileType::FromCid(kBoolCid);
 }
 
+CompileType FindBitInTableInstr::ComputeType() const {
+  return CompileType::FromCid(kSmiCid);
+}
+
 CompileType UnboxInstr::ComputeType() const {
   switch (representation()) {
     case kUnboxedFloat:
@@ -436,7 +436,7 @@ RawArray* BytecodeReaderHelper::CreateForwarderChecks(
       check.set_index(index);
       check.set_type_or_bound(type);
       check.set_name(name);
-      cache = SubtypeTestCache::New();
+      cache = SubtypeTestCache::New(SubtypeTestCache::kMaxInputs);
       check.set_cache(cache);
       checks.Add(check);
     }
@@ -838,7 +838,7 @@ intptr_t BytecodeReaderHelper::ReadConstantPool(const Function& function,
         continue;
       }
       case ConstantPoolTag::kSubtypeTestCache: {
-        obj = SubtypeTestCache::New();
+        obj = SubtypeTestCache::New(SubtypeTestCache::kMaxInputs);
       } break;
       case ConstantPoolTag::kEmptyTypeArguments:
         obj = Object::empty_type_arguments().raw();
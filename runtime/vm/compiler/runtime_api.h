@@ -818,6 +818,7 @@ class SubtypeTestCache : public AllStatic {
   static const word kInstanceParentFunctionTypeArguments;
   static const word kInstanceDelayedFunctionTypeArguments;
   static const word kTestResult;
+  static const word kMaxLinearCacheEntries;
 };
 
 class Context : public AllStatic {
@@ -899,6 +900,7 @@ class Field : public AllStatic {
 
 class TypeArguments : public AllStatic {
  public:
+  static word hash_offset();
   static word instantiations_offset();
   static word type_at_offset(intptr_t i);
 };
@@ -46,6 +46,8 @@ static constexpr dart::compiler::target::word
     SubtypeTestCache_kInstanceTypeArguments = 2;
 static constexpr dart::compiler::target::word
     SubtypeTestCache_kInstantiatorTypeArguments = 3;
+static constexpr dart::compiler::target::word
+    SubtypeTestCache_kMaxLinearCacheEntries = 30;
 static constexpr dart::compiler::target::word
     SubtypeTestCache_kTestEntryLength = 7;
 static constexpr dart::compiler::target::word SubtypeTestCache_kTestResult = 0;
@@ -326,6 +328,7 @@ static constexpr dart::compiler::target::word Type_hash_offset = 20;
 static constexpr dart::compiler::target::word Type_signature_offset = 24;
 static constexpr dart::compiler::target::word Type_type_class_id_offset = 12;
 static constexpr dart::compiler::target::word Type_type_state_offset = 32;
+static constexpr dart::compiler::target::word TypeArguments_hash_offset = 12;
 static constexpr dart::compiler::target::word
     TypeArguments_instantiations_offset = 4;
 static constexpr dart::compiler::target::word TypeRef_type_offset = 12;
@@ -407,6 +410,8 @@ static constexpr dart::compiler::target::word
     SubtypeTestCache_kInstanceTypeArguments = 2;
 static constexpr dart::compiler::target::word
     SubtypeTestCache_kInstantiatorTypeArguments = 3;
+static constexpr dart::compiler::target::word
+    SubtypeTestCache_kMaxLinearCacheEntries = 30;
 static constexpr dart::compiler::target::word
     SubtypeTestCache_kTestEntryLength = 7;
 static constexpr dart::compiler::target::word SubtypeTestCache_kTestResult = 0;
@@ -689,6 +694,7 @@ static constexpr dart::compiler::target::word Type_hash_offset = 40;
 static constexpr dart::compiler::target::word Type_signature_offset = 48;
 static constexpr dart::compiler::target::word Type_type_class_id_offset = 24;
 static constexpr dart::compiler::target::word Type_type_state_offset = 60;
+static constexpr dart::compiler::target::word TypeArguments_hash_offset = 24;
 static constexpr dart::compiler::target::word
     TypeArguments_instantiations_offset = 8;
 static constexpr dart::compiler::target::word TypeRef_type_offset = 24;
@@ -768,6 +774,8 @@ static constexpr dart::compiler::target::word
     SubtypeTestCache_kInstanceTypeArguments = 2;
 static constexpr dart::compiler::target::word
     SubtypeTestCache_kInstantiatorTypeArguments = 3;
+static constexpr dart::compiler::target::word
+    SubtypeTestCache_kMaxLinearCacheEntries = 30;
 static constexpr dart::compiler::target::word
     SubtypeTestCache_kTestEntryLength = 7;
 static constexpr dart::compiler::target::word SubtypeTestCache_kTestResult = 0;
@@ -1048,6 +1056,7 @@ static constexpr dart::compiler::target::word Type_hash_offset = 20;
 static constexpr dart::compiler::target::word Type_signature_offset = 24;
 static constexpr dart::compiler::target::word Type_type_class_id_offset = 12;
 static constexpr dart::compiler::target::word Type_type_state_offset = 32;
+static constexpr dart::compiler::target::word TypeArguments_hash_offset = 12;
 static constexpr dart::compiler::target::word
     TypeArguments_instantiations_offset = 4;
 static constexpr dart::compiler::target::word TypeRef_type_offset = 12;
@@ -1125,6 +1134,8 @@ static constexpr dart::compiler::target::word
     SubtypeTestCache_kInstanceTypeArguments = 2;
 static constexpr dart::compiler::target::word
     SubtypeTestCache_kInstantiatorTypeArguments = 3;
+static constexpr dart::compiler::target::word
+    SubtypeTestCache_kMaxLinearCacheEntries = 30;
 static constexpr dart::compiler::target::word
     SubtypeTestCache_kTestEntryLength = 7;
 static constexpr dart::compiler::target::word SubtypeTestCache_kTestResult = 0;
@@ -1407,6 +1418,7 @@ static constexpr dart::compiler::target::word Type_hash_offset = 40;
 static constexpr dart::compiler::target::word Type_signature_offset = 48;
 static constexpr dart::compiler::target::word Type_type_class_id_offset = 24;
 static constexpr dart::compiler::target::word Type_type_state_offset = 60;
+static constexpr dart::compiler::target::word TypeArguments_hash_offset = 24;
 static constexpr dart::compiler::target::word
     TypeArguments_instantiations_offset = 8;
 static constexpr dart::compiler::target::word TypeRef_type_offset = 24;
@@ -47,6 +47,7 @@
   CONSTANT(SubtypeTestCache, kInstanceParentFunctionTypeArguments)             \
   CONSTANT(SubtypeTestCache, kInstanceTypeArguments)                           \
   CONSTANT(SubtypeTestCache, kInstantiatorTypeArguments)                       \
+  CONSTANT(SubtypeTestCache, kMaxLinearCacheEntries)                           \
   CONSTANT(SubtypeTestCache, kTestEntryLength)                                 \
   CONSTANT(SubtypeTestCache, kTestResult)                                      \
   FIELD(AbstractType, type_test_stub_entry_point_offset)                       \
@@ -225,6 +226,7 @@
   FIELD(Type, signature_offset)                                                \
   FIELD(Type, type_class_id_offset)                                            \
   FIELD(Type, type_state_offset)                                               \
+  FIELD(TypeArguments, hash_offset)                                            \
   FIELD(TypeArguments, instantiations_offset)                                  \
   FIELD(TypeRef, type_offset)                                                  \
   FIELD(TypedDataBase, data_field_offset)                                      \
@@ -2795,7 +2795,7 @@ static void GenerateSubtypeNTestCacheStub(Assembler* assembler, int n) {
          FieldAddress(kCacheReg, target::SubtypeTestCache::cache_offset()));
   __ AddImmediate(kCacheReg, target::Array::data_offset() - kHeapObjectTag);
 
-  Label loop, not_closure;
+  Label search, loop, not_closure;
   if (n >= 4) {
     __ LoadClassIdMayBeSmi(kInstanceCidOrFunction, kInstanceReg);
   } else {
@@ -2808,11 +2808,11 @@ static void GenerateSubtypeNTestCacheStub(Assembler* assembler, int n) {
   {
     __ ldr(kInstanceCidOrFunction,
            FieldAddress(kInstanceReg, target::Closure::function_offset()));
+    // The instance type arguments are also needed to probe hashed caches.
+    __ ldr(kInstanceInstantiatorTypeArgumentsReg,
+           FieldAddress(kInstanceReg,
+                        target::Closure::instantiator_type_arguments_offset()));
     if (n >= 2) {
-      __ ldr(
-          kInstanceInstantiatorTypeArgumentsReg,
-          FieldAddress(kInstanceReg,
-                       target::Closure::instantiator_type_arguments_offset()));
       if (n >= 6) {
         ASSERT(n == 6);
         __ ldr(kInstanceParentFunctionTypeArgumentsReg,
@@ -2823,33 +2823,71 @@ static void GenerateSubtypeNTestCacheStub(Assembler* assembler, int n) {
                             target::Closure::delayed_type_arguments_offset()));
       }
     }
-    __ b(&loop);
+    __ b(&search);
   }
 
   // Non-Closure handling.
   {
     __ Bind(&not_closure);
-    if (n >= 2) {
-      Label has_no_type_arguments;
-      __ LoadClassById(R5, kInstanceCidOrFunction);
-      __ mov(kInstanceInstantiatorTypeArgumentsReg, kNullReg);
-      __ LoadFieldFromOffset(
-          R5, R5, target::Class::type_arguments_field_offset_in_words_offset(),
-          kWord);
-      __ CompareImmediate(R5, target::Class::kNoTypeArguments);
-      __ b(&has_no_type_arguments, EQ);
-      __ add(R5, kInstanceReg, Operand(R5, LSL, 3));
-      __ ldr(kInstanceInstantiatorTypeArgumentsReg, FieldAddress(R5, 0));
-      __ Bind(&has_no_type_arguments);
-
-      if (n >= 6) {
-        __ mov(kInstanceParentFunctionTypeArgumentsReg, kNullReg);
-        __ mov(kInstanceDelayedFunctionTypeArgumentsReg, kNullReg);
-      }
+    Label has_no_type_arguments;
+    __ LoadClassById(R5, kInstanceCidOrFunction);
+    __ mov(kInstanceInstantiatorTypeArgumentsReg, kNullReg);
+    __ LoadFieldFromOffset(
+        R5, R5, target::Class::type_arguments_field_offset_in_words_offset(),
+        kWord);
+    __ CompareImmediate(R5, target::Class::kNoTypeArguments);
+    __ b(&has_no_type_arguments, EQ);
+    __ add(R5, kInstanceReg, Operand(R5, LSL, 3));
+    __ ldr(kInstanceInstantiatorTypeArgumentsReg, FieldAddress(R5, 0));
+    __ Bind(&has_no_type_arguments);
+
+    if (n >= 6) {
+      __ mov(kInstanceParentFunctionTypeArgumentsReg, kNullReg);
+      __ mov(kInstanceDelayedFunctionTypeArgumentsReg, kNullReg);
     }
     __ SmiTag(kInstanceCidOrFunction);
   }
 
+  // Caches with many checks are hash tables, which are probed from the entry
+  // picked by the instance class id and, if compared, type arguments instead
+  // of the first one (see SubtypeTestCache::FirstEntryToProbe).
+  Label hash_type_arguments, probe;
+  __ Bind(&search);
+  __ ldr(R5, Address(kCacheReg, target::Array::length_offset() -
+                                    target::Array::data_offset()));
+  __ CompareImmediate(
+      R5, target::ToRawSmi(
+              (target::SubtypeTestCache::kMaxLinearCacheEntries + 1) *
+              target::SubtypeTestCache::kTestEntryLength));
+  __ b(&loop, LE);
+  // The hash and mask are combined Smi-tagged. Closure functions do not
+  // contribute to the hash.
+  __ LoadImmediate(R5, 0);
+  __ tsti(kInstanceCidOrFunction, Immediate(kSmiTagMask));
+  __ b(&hash_type_arguments, NE);
+  __ mov(R5, kInstanceCidOrFunction);
+  __ Bind(&hash_type_arguments);
+  if (n >= 2) {
+    __ CompareRegisters(kInstanceInstantiatorTypeArgumentsReg, kNullReg);
+    __ b(&probe, EQ);
+    __ ldr(TMP, FieldAddress(kInstanceInstantiatorTypeArgumentsReg,
+                             target::TypeArguments::hash_offset()));
+    __ eor(R5, R5, Operand(TMP));
+  }
+  __ Bind(&probe);
+  __ ldr(TMP,
+         Address(kCacheReg,
+                 target::kWordSize *
+                     target::SubtypeTestCache::kInstanceClassIdOrFunction));
+  __ and_(R5, R5, Operand(TMP));
+  // kCacheReg += (1 + bucket) * entry size, skipping the header entry.
+  __ LoadImmediate(TMP, (target::kWordSize *
+                         target::SubtypeTestCache::kTestEntryLength) >>
+                            kSmiTagShift);
+  __ madd(kCacheReg, R5, TMP, kCacheReg);
+  __ AddImmediate(kCacheReg, target::kWordSize *
+                                 target::SubtypeTestCache::kTestEntryLength);
+
   Label found, not_found, next_iteration;
 
   // Loop header
@@ -2904,11 +2942,31 @@ static void GenerateSubtypeNTestCacheStub(Assembler* assembler, int n) {
       }
     }
   }
+  // kIllegalCid ends a hash table, whose probes wrap around to its first
+  // bucket. The end entry holds the number of buckets in kTestResult.
+  Label wrap_around;
   __ Bind(&next_iteration);
+  if (n >= 2) {
+    __ ldr(R5,
+           Address(kCacheReg,
+                   target::kWordSize *
+                       target::SubtypeTestCache::kInstanceClassIdOrFunction));
+  }
+  __ CompareImmediate(R5, target::ToRawSmi(kIllegalCid));
+  __ b(&wrap_around, EQ);
   __ AddImmediate(kCacheReg, target::kWordSize *
                                  target::SubtypeTestCache::kTestEntryLength);
   __ b(&loop);
 
+  __ Bind(&wrap_around);
+  __ ldr(R5, Address(kCacheReg, target::kWordSize *
+                                    target::SubtypeTestCache::kTestResult));
+  __ LoadImmediate(TMP, (target::kWordSize *
+                         target::SubtypeTestCache::kTestEntryLength) >>
+                            kSmiTagShift);
+  __ msub(kCacheReg, R5, TMP, kCacheReg);
+  __ b(&loop);
+
   __ Bind(&found);
   __ ldr(R1, Address(kCacheReg, target::kWordSize *
                                     target::SubtypeTestCache::kTestResult));
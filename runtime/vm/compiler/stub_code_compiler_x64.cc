@@ -2763,7 +2763,7 @@ static void GenerateSubtypeNTestCacheStub(Assembler* assembler, int n) {
           FieldAddress(kCacheReg, target::SubtypeTestCache::cache_offset()));
   __ addq(RSI, Immediate(target::Array::data_offset() - kHeapObjectTag));
 
-  Label loop, not_closure;
+  Label search, loop, not_closure;
   if (n >= 4) {
     __ LoadClassIdMayBeSmi(kInstanceCidOrFunction, kInstanceReg);
   } else {
@@ -2776,11 +2776,12 @@ static void GenerateSubtypeNTestCacheStub(Assembler* assembler, int n) {
   {
     __ movq(kInstanceCidOrFunction,
             FieldAddress(kInstanceReg, target::Closure::function_offset()));
+    // The instance type arguments are also needed to probe hashed caches.
+    __ movq(
+        kInstanceInstantiatorTypeArgumentsReg,
+        FieldAddress(kInstanceReg,
+                     target::Closure::instantiator_type_arguments_offset()));
     if (n >= 2) {
-      __ movq(
-          kInstanceInstantiatorTypeArgumentsReg,
-          FieldAddress(kInstanceReg,
-                       target::Closure::instantiator_type_arguments_offset()));
       if (n >= 6) {
         ASSERT(n == 6);
         __ movq(
@@ -2792,35 +2793,68 @@ static void GenerateSubtypeNTestCacheStub(Assembler* assembler, int n) {
                              target::Closure::delayed_type_arguments_offset()));
       }
     }
-    __ jmp(&loop, Assembler::kNearJump);
+    __ jmp(&search, Assembler::kNearJump);
   }
 
   // Non-Closure handling.
   {
     __ Bind(&not_closure);
-    if (n >= 2) {
-      Label has_no_type_arguments;
-      __ LoadClassById(RDI, kInstanceCidOrFunction);
-      __ movq(kInstanceInstantiatorTypeArgumentsReg, kNullReg);
-      __ movl(
-          RDI,
-          FieldAddress(
-              RDI,
-              target::Class::type_arguments_field_offset_in_words_offset()));
-      __ cmpl(RDI, Immediate(target::Class::kNoTypeArguments));
-      __ j(EQUAL, &has_no_type_arguments, Assembler::kNearJump);
-      __ movq(kInstanceInstantiatorTypeArgumentsReg,
-              FieldAddress(kInstanceReg, RDI, TIMES_8, 0));
-      __ Bind(&has_no_type_arguments);
-
-      if (n >= 6) {
-        __ movq(kInstanceParentFunctionTypeArgumentsReg, kNullReg);
-        __ movq(kInstanceDelayedFunctionTypeArgumentsReg, kNullReg);
-      }
+    Label has_no_type_arguments;
+    __ LoadClassById(RDI, kInstanceCidOrFunction);
+    __ movq(kInstanceInstantiatorTypeArgumentsReg, kNullReg);
+    __ movl(RDI,
+            FieldAddress(
+                RDI,
+                target::Class::type_arguments_field_offset_in_words_offset()));
+    __ cmpl(RDI, Immediate(target::Class::kNoTypeArguments));
+    __ j(EQUAL, &has_no_type_arguments, Assembler::kNearJump);
+    __ movq(kInstanceInstantiatorTypeArgumentsReg,
+            FieldAddress(kInstanceReg, RDI, TIMES_8, 0));
+    __ Bind(&has_no_type_arguments);
+
+    if (n >= 6) {
+      __ movq(kInstanceParentFunctionTypeArgumentsReg, kNullReg);
+      __ movq(kInstanceDelayedFunctionTypeArgumentsReg, kNullReg);
     }
     __ SmiTag(kInstanceCidOrFunction);
   }
 
+  // Caches with many checks are hash tables, which are probed from the entry
+  // picked by the instance class id and, if compared, type arguments instead
+  // of the first one (see SubtypeTestCache::FirstEntryToProbe).
+  Label hash_type_arguments, probe;
+  __ Bind(&search);
+  __ cmpq(Address(RSI, target::Array::length_offset() -
+                           target::Array::data_offset()),
+          Immediate(target::ToRawSmi(
+              (target::SubtypeTestCache::kMaxLinearCacheEntries + 1) *
+              target::SubtypeTestCache::kTestEntryLength)));
+  __ j(LESS_EQUAL, &loop, Assembler::kNearJump);
+  // The hash and mask are combined Smi-tagged. Closure functions do not
+  // contribute to the hash.
+  __ xorq(RDI, RDI);
+  __ testq(kInstanceCidOrFunction, Immediate(kSmiTagMask));
+  __ j(NOT_ZERO, &hash_type_arguments, Assembler::kNearJump);
+  __ movq(RDI, kInstanceCidOrFunction);
+  __ Bind(&hash_type_arguments);
+  if (n >= 2) {
+    __ cmpq(kInstanceInstantiatorTypeArgumentsReg, kNullReg);
+    __ j(EQUAL, &probe, Assembler::kNearJump);
+    __ xorq(RDI, FieldAddress(kInstanceInstantiatorTypeArgumentsReg,
+                              target::TypeArguments::hash_offset()));
+  }
+  __ Bind(&probe);
+  __ andq(RDI, Address(RSI, target::kWordSize *
+                                target::SubtypeTestCache::
+                                    kInstanceClassIdOrFunction));
+  // RSI += (1 + bucket) * entry size, skipping the header entry.
+  __ imulq(RDI, Immediate((target::kWordSize *
+                           target::SubtypeTestCache::kTestEntryLength) >>
+                          kSmiTagShift));
+  __ leaq(RSI, Address(RSI, RDI, TIMES_1,
+                       target::kWordSize *
+                           target::SubtypeTestCache::kTestEntryLength));
+
   Label found, not_found, next_iteration;
 
   // Loop header.
@@ -2874,11 +2908,24 @@ static void GenerateSubtypeNTestCacheStub(Assembler* assembler, int n) {
     }
   }
 
+  // RDI still holds the class id or function of the entry. kIllegalCid ends
+  // a hash table, whose probes wrap around to its first bucket.
+  Label wrap_around;
   __ Bind(&next_iteration);
+  __ cmpq(RDI, Immediate(target::ToRawSmi(kIllegalCid)));
+  __ j(EQUAL, &wrap_around, Assembler::kNearJump);
   __ addq(RSI, Immediate(target::kWordSize *
                          target::SubtypeTestCache::kTestEntryLength));
   __ jmp(&loop, Assembler::kNearJump);
 
+  __ Bind(&wrap_around);
+  __ movq(RSI,
+          FieldAddress(kCacheReg, target::SubtypeTestCache::cache_offset()));
+  __ addq(RSI, Immediate(target::Array::data_offset() - kHeapObjectTag +
+                         target::kWordSize *
+                             target::SubtypeTestCache::kTestEntryLength));
+  __ jmp(&loop, Assembler::kNearJump);
+
   __ Bind(&found);
   __ movq(R8, Address(RSI, target::kWordSize *
                                target::SubtypeTestCache::kTestResult));
@@ -5972,6 +5972,18 @@ DART_EXPORT void Dart_TimelineEvent(const char* label,
 #endif
 }
 
+DART_EXPORT bool Dart_TimelineWriteToFile(const char* path) {
+#if defined(SUPPORT_TIMELINE) && !defined(PRODUCT)
+  TimelineEventRecorder* recorder = Timeline::recorder();
+  if (recorder == NULL) {
+    return false;
+  }
+  return recorder->WriteToFile(path);
+#else
+  return false;
+#endif
+}
+
 DART_EXPORT void Dart_SetThreadName(const char* name) {
   OSThread* thread = OSThread::Current();
   if (thread == NULL) {
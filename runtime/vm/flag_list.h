@@ -99,6 +99,9 @@ constexpr bool kDartUseBytecode = false;
     "Allow idle tasks to run for this long.")                                  \
   P(interpret_irregexp, bool, false, "Use irregexp bytecode interpreter")      \
   P(lazy_dispatchers, bool, true, "Generate dispatchers lazily")               \
+  P(linear_regexp, bool, false,                                                \
+    "Match regular expressions without back references or lookarounds in "     \
+    "linear time")                                                             \
   P(link_natives_lazily, bool, false, "Link native calls lazily")              \
   R(log_marker_tasks, false, bool, false,                                      \
     "Log debugging information for old gen GC marking tasks.")                 \
@@ -153,6 +156,9 @@ constexpr bool kDartUseBytecode = false;
     "Show invisible frames in stack traces.")                                  \
   R(show_invisible_isolates, false, bool, false,                               \
     "Show invisible isolates in the vm-service.")                              \
+  P(snapshot_fill_tasks, int, 2,                                               \
+    "The number of tasks to spawn when filling objects read from a snapshot "  \
+    "(0 means perform all filling on main thread).")                           \
   R(support_disassembler, false, bool, true, "Support the disassembler.")      \
   R(support_il_printer, false, bool, true, "Support the IL printer.")          \
   C(support_reload, false, false, bool, true, "Support isolate reload.")       \
@@ -171,6 +171,11 @@ static intptr_t PcDescriptorsSizeInSnapshot(intptr_t len) {
                         compiler::target::ObjectAlignment::kObjectAlignment);
 }
 
+static intptr_t DoubleSizeInSnapshot() {
+  return Utils::RoundUp(compiler::target::Double::InstanceSize(),
+                        compiler::target::ObjectAlignment::kObjectAlignment);
+}
+
 static intptr_t InstructionsSizeInSnapshot(intptr_t len) {
   return Utils::RoundUp(compiler::target::Instructions::HeaderSize() + len,
                         compiler::target::ObjectAlignment::kObjectAlignment);
@@ -199,6 +204,8 @@ intptr_t ImageWriter::SizeInSnapshot(RawObject* raw_object) {
       RawPcDescriptors* raw_desc = static_cast<RawPcDescriptors*>(raw_object);
       return PcDescriptorsSizeInSnapshot(raw_desc->ptr()->length_);
     }
+    case kDoubleCid:
+      return DoubleSizeInSnapshot();
     case kInstructionsCid: {
       RawInstructions* raw_insns = static_cast<RawInstructions*>(raw_object);
       return InstructionsSizeInSnapshot(Instructions::Size(raw_insns));
@@ -422,6 +429,17 @@ void ImageWriter::WriteROData(WriteStream* stream) {
       stream->WriteTargetWord(desc.Length());
       stream->WriteBytes(desc.raw()->ptr()->data(), desc.Length());
       stream->Align(compiler::target::ObjectAlignment::kObjectAlignment);
+    } else if (obj.IsDouble()) {
+      const Double& dbl = Double::Cast(obj);
+
+      const intptr_t size_in_bytes = DoubleSizeInSnapshot();
+      marked_tags = RawObject::SizeTag::update(size_in_bytes * 2, marked_tags);
+
+      stream->WriteTargetWord(marked_tags);
+      // The value is 8-byte aligned, so a word of padding follows the header.
+      stream->WriteTargetWord(0);
+      stream->WriteFixed<double>(dbl.value());
+      stream->Align(compiler::target::ObjectAlignment::kObjectAlignment);
     } else {
       const Class& clazz = Class::Handle(obj.clazz());
       FATAL1("Unsupported class %s in rodata section.\n", clazz.ToCString());
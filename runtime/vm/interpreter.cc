@@ -1200,9 +1200,20 @@ bool Interpreter::AssertAssignable(Thread* thread,
           static_cast<RawTypeArguments*>(null_value);
     }
 
-    for (RawObject** entries = cache->ptr()->cache_->ptr()->data();
-         entries[0] != null_value;
+    RawObject** data = cache->ptr()->cache_->ptr()->data();
+    for (RawObject** entries =
+             data + SubtypeTestCache::FirstEntryToProbe(
+                        cache, instance_cid_or_function,
+                        instance_type_arguments) *
+                        SubtypeTestCache::kTestEntryLength;
+         entries[SubtypeTestCache::kInstanceClassIdOrFunction] != null_value;
          entries += SubtypeTestCache::kTestEntryLength) {
+      if (entries[SubtypeTestCache::kInstanceClassIdOrFunction] ==
+          Smi::New(kIllegalCid)) {
+        // The end of a hash table: continue with its first bucket.
+        entries = data;
+        continue;
+      }
       if ((entries[SubtypeTestCache::kInstanceClassIdOrFunction] ==
            instance_cid_or_function) &&
           (entries[SubtypeTestCache::kInstanceTypeArguments] ==
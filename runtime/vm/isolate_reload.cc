@@ -1687,7 +1687,7 @@ void IsolateReloadContext::ResetUnoptimizedICsOnStack() {
 }
 
 void IsolateReloadContext::ResetMegamorphicCaches() {
-  object_store()->set_megamorphic_cache_table(GrowableObjectArray::Handle());
+  object_store()->set_megamorphic_cache_table(Array::Handle());
   // Since any current optimized code will not make any more calls, it may be
   // better to clear the table instead of clearing each of the caches, allow
   // the current megamorphic caches get GC'd and any new optimized code allocate
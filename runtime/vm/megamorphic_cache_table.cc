@@ -6,6 +6,7 @@
 
 #include <stdlib.h>
 #include "vm/compiler/jit/compiler.h"
+#include "vm/hash_table.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/stub_code.h"
@@ -13,37 +14,99 @@
 
 namespace dart {
 
+// A selector a megamorphic cache is looked up by.
+class MegamorphicCacheKey {
+ public:
+  MegamorphicCacheKey(const String& name, const Array& descriptor)
+      : name_(name), descriptor_(descriptor) {}
+
+  bool Matches(const MegamorphicCache& cache) const {
+    return (cache.target_name() == name_.raw()) &&
+           (cache.arguments_descriptor() == descriptor_.raw());
+  }
+
+  // Arguments descriptors may move, so only the name contributes to the hash.
+  uword Hash() const { return String::HashRawSymbol(name_.raw()); }
+
+ private:
+  const String& name_;
+  const Array& descriptor_;
+};
+
+class MegamorphicCacheTraits {
+ public:
+  static const char* Name() { return "MegamorphicCacheTraits"; }
+  static bool ReportStats() { return false; }
+
+  static bool IsMatch(const Object& a, const Object& b) {
+    return a.raw() == b.raw();
+  }
+  static bool IsMatch(const MegamorphicCacheKey& key, const Object& obj) {
+    return key.Matches(MegamorphicCache::Cast(obj));
+  }
+  static uword Hash(const Object& obj) {
+    return String::HashRawSymbol(MegamorphicCache::Cast(obj).target_name());
+  }
+  static uword Hash(const MegamorphicCacheKey& key) { return key.Hash(); }
+};
+typedef UnorderedHashSet<MegamorphicCacheTraits> MegamorphicCacheSet;
+
 RawMegamorphicCache* MegamorphicCacheTable::Lookup(Thread* thread,
                                                    const String& name,
                                                    const Array& descriptor) {
   Isolate* isolate = thread->isolate();
+  Zone* zone = thread->zone();
   // Multiple compilation threads could access this lookup.
   SafepointMutexLocker ml(isolate->megamorphic_mutex());
   ASSERT(name.IsSymbol());
   // TODO(rmacnak): ASSERT(descriptor.IsCanonical());
 
-  // TODO(rmacnak): Make a proper hashtable a la symbol table.
-  GrowableObjectArray& table = GrowableObjectArray::Handle(
-      isolate->object_store()->megamorphic_cache_table());
-  MegamorphicCache& cache = MegamorphicCache::Handle();
-  if (table.IsNull()) {
-    table = GrowableObjectArray::New(Heap::kOld);
-    isolate->object_store()->set_megamorphic_cache_table(table);
-  } else {
-    for (intptr_t i = 0; i < table.Length(); i++) {
-      cache ^= table.At(i);
-      if ((cache.target_name() == name.raw()) &&
-          (cache.arguments_descriptor() == descriptor.raw())) {
-        return cache.raw();
-      }
-    }
+  ObjectStore* object_store = isolate->object_store();
+  if (object_store->megamorphic_cache_table() == Array::null()) {
+    object_store->set_megamorphic_cache_table(Array::Handle(
+        zone, HashTables::New<MegamorphicCacheSet>(16, Heap::kOld)));
   }
-
-  cache = MegamorphicCache::New(name, descriptor);
-  table.Add(cache, Heap::kOld);
+  MegamorphicCacheSet table(zone, object_store->megamorphic_cache_table());
+  MegamorphicCacheKey key(name, descriptor);
+  MegamorphicCache& cache = MegamorphicCache::Handle(zone);
+  cache ^= table.GetOrNull(key);
+  if (cache.IsNull()) {
+    cache = MegamorphicCache::New(name, descriptor);
+    table.Insert(cache);
+  }
+  object_store->set_megamorphic_cache_table(table.Release());
   return cache.raw();
 }
 
+RawArray* MegamorphicCacheTable::EmptyBuckets(Isolate* isolate) {
+  ASSERT(isolate->megamorphic_mutex()->IsOwnedByCurrentThread());
+  ObjectStore* object_store = isolate->object_store();
+  if (object_store->megamorphic_empty_buckets() == Array::null()) {
+    const Array& buckets = Array::Handle(
+        Array::New(MegamorphicCache::kEntryLength, Heap::kOld));
+    const Function& handler = Function::Handle(miss_handler(isolate));
+    MegamorphicCache::SetEntry(buckets, 0, Object::smi_illegal_cid(), handler);
+    object_store->set_megamorphic_empty_buckets(buckets);
+  }
+  return object_store->megamorphic_empty_buckets();
+}
+
+void MegamorphicCacheTable::VisitCaches(Isolate* isolate,
+                                        MegamorphicCacheVisitor* visitor) {
+  Zone* zone = Thread::Current()->zone();
+  const Array& data =
+      Array::Handle(zone, isolate->object_store()->megamorphic_cache_table());
+  if (data.IsNull()) return;
+  MegamorphicCacheSet table(zone, data.raw());
+  MegamorphicCacheSet::Iterator it(&table);
+  MegamorphicCache& cache = MegamorphicCache::Handle(zone);
+  while (it.MoveNext()) {
+    cache ^= table.GetKey(it.Current());
+    visitor->Visit(cache);
+  }
+  table.Release();
+}
+
 RawFunction* MegamorphicCacheTable::miss_handler(Isolate* isolate) {
   ASSERT(isolate->object_store()->megamorphic_miss_function() !=
          Function::null());
@@ -108,69 +171,120 @@ void MegamorphicCacheTable::ReInitMissHandlerCode(
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
 void MegamorphicCacheTable::PrintSizes(Isolate* isolate) {
-  StackZone zone(Thread::Current());
-  intptr_t size = 0;
-  MegamorphicCache& cache = MegamorphicCache::Handle();
-  Array& buckets = Array::Handle();
-  const GrowableObjectArray& table = GrowableObjectArray::Handle(
-      isolate->object_store()->megamorphic_cache_table());
-  if (table.IsNull()) return;
-  intptr_t max_size = 0;
-  for (intptr_t i = 0; i < table.Length(); i++) {
-    cache ^= table.At(i);
-    buckets = cache.buckets();
-    size += MegamorphicCache::InstanceSize();
-    size += Array::InstanceSize(buckets.Length());
-    if (buckets.Length() > max_size) {
-      max_size = buckets.Length();
+  class MegamorphicCacheSizeVisitor : public MegamorphicCacheVisitor {
+   public:
+    explicit MegamorphicCacheSizeVisitor(const Array& empty_buckets)
+        : empty_buckets_(empty_buckets),
+          buckets_(Array::Handle()),
+          cache_count_(0),
+          empty_count_(0),
+          size_(0),
+          max_size_(0) {}
+
+    void Visit(const MegamorphicCache& cache) {
+      buckets_ = cache.buckets();
+      cache_count_++;
+      size_ += MegamorphicCache::InstanceSize();
+      if (buckets_.raw() == empty_buckets_.raw()) {
+        // Shared by all caches that have never been filled.
+        empty_count_++;
+        return;
+      }
+      size_ += Array::InstanceSize(buckets_.Length());
+      if (buckets_.Length() > max_size_) {
+        max_size_ = buckets_.Length();
+      }
     }
-  }
-  OS::PrintErr("%" Pd " megamorphic caches using %" Pd "KB.\n", table.Length(),
-               size / 1024);
 
-  intptr_t* probe_counts = new intptr_t[max_size];
-  intptr_t entry_count = 0;
-  intptr_t max_probe_count = 0;
-  for (intptr_t i = 0; i < max_size; i++) {
-    probe_counts[i] = 0;
-  }
-  for (intptr_t i = 0; i < table.Length(); i++) {
-    cache ^= table.At(i);
-    buckets = cache.buckets();
-    intptr_t mask = cache.mask();
-    intptr_t capacity = mask + 1;
-    for (intptr_t j = 0; j < capacity; j++) {
-      intptr_t class_id =
-          Smi::Value(Smi::RawCast(cache.GetClassId(buckets, j)));
-      if (class_id != kIllegalCid) {
-        intptr_t probe_count = 0;
-        intptr_t probe_index =
-            (class_id * MegamorphicCache::kSpreadFactor) & mask;
-        intptr_t probe_cid;
-        while (true) {
-          probe_count++;
-          probe_cid =
-              Smi::Value(Smi::RawCast(cache.GetClassId(buckets, probe_index)));
-          if (probe_cid == class_id) {
-            break;
+    intptr_t cache_count() const { return cache_count_; }
+    intptr_t empty_count() const { return empty_count_; }
+    intptr_t size() const { return size_; }
+    intptr_t max_size() const { return max_size_; }
+
+   private:
+    const Array& empty_buckets_;
+    Array& buckets_;
+    intptr_t cache_count_;
+    intptr_t empty_count_;
+    intptr_t size_;
+    intptr_t max_size_;
+  };
+
+  class MegamorphicCacheProbeVisitor : public MegamorphicCacheVisitor {
+   public:
+    explicit MegamorphicCacheProbeVisitor(intptr_t* probe_counts)
+        : probe_counts_(probe_counts),
+          buckets_(Array::Handle()),
+          entry_count_(0),
+          max_probe_count_(0) {}
+
+    void Visit(const MegamorphicCache& cache) {
+      buckets_ = cache.buckets();
+      intptr_t mask = cache.mask();
+      intptr_t capacity = mask + 1;
+      for (intptr_t j = 0; j < capacity; j++) {
+        intptr_t class_id =
+            Smi::Value(Smi::RawCast(cache.GetClassId(buckets_, j)));
+        if (class_id != kIllegalCid) {
+          intptr_t probe_count = 0;
+          intptr_t probe_index =
+              (class_id * MegamorphicCache::kSpreadFactor) & mask;
+          intptr_t probe_cid;
+          while (true) {
+            probe_count++;
+            probe_cid = Smi::Value(
+                Smi::RawCast(cache.GetClassId(buckets_, probe_index)));
+            if (probe_cid == class_id) {
+              break;
+            }
+            probe_index = (probe_index + 1) & mask;
           }
-          probe_index = (probe_index + 1) & mask;
-        }
-        probe_counts[probe_count]++;
-        if (probe_count > max_probe_count) {
-          max_probe_count = probe_count;
+          probe_counts_[probe_count]++;
+          if (probe_count > max_probe_count_) {
+            max_probe_count_ = probe_count;
+          }
+          entry_count_++;
         }
-        entry_count++;
       }
     }
+
+    intptr_t entry_count() const { return entry_count_; }
+    intptr_t max_probe_count() const { return max_probe_count_; }
+
+   private:
+    intptr_t* probe_counts_;
+    Array& buckets_;
+    intptr_t entry_count_;
+    intptr_t max_probe_count_;
+  };
+
+  StackZone zone(Thread::Current());
+  if (isolate->object_store()->megamorphic_cache_table() == Array::null()) {
+    return;
+  }
+  const Array& empty_buckets =
+      Array::Handle(isolate->object_store()->megamorphic_empty_buckets());
+  MegamorphicCacheSizeVisitor sizes(empty_buckets);
+  VisitCaches(isolate, &sizes);
+  OS::PrintErr("%" Pd " megamorphic caches using %" Pd "KB.\n",
+               sizes.cache_count(), sizes.size() / 1024);
+  OS::PrintErr("%" Pd " megamorphic caches are empty.\n", sizes.empty_count());
+  if (sizes.empty_count() == sizes.cache_count()) return;
+
+  const intptr_t max_size = sizes.max_size();
+  intptr_t* probe_counts = new intptr_t[max_size];
+  for (intptr_t i = 0; i < max_size; i++) {
+    probe_counts[i] = 0;
   }
+  MegamorphicCacheProbeVisitor probes(probe_counts);
+  VisitCaches(isolate, &probes);
   intptr_t cumulative_entries = 0;
-  for (intptr_t i = 0; i <= max_probe_count; i++) {
+  for (intptr_t i = 0; i <= probes.max_probe_count(); i++) {
     cumulative_entries += probe_counts[i];
     OS::PrintErr("Megamorphic probe %" Pd ": %" Pd " (%lf)\n", i,
                  probe_counts[i],
                  static_cast<double>(cumulative_entries) /
-                     static_cast<double>(entry_count));
+                     static_cast<double>(probes.entry_count()));
   }
   delete[] probe_counts;
 }
@@ -16,6 +16,7 @@ class ObjectPoolBuilder;
 class Array;
 class Function;
 class Isolate;
+class MegamorphicCache;
 class ObjectPointerVisitor;
 class RawArray;
 class RawFunction;
@@ -25,6 +26,13 @@ class RawString;
 class String;
 class Thread;
 
+class MegamorphicCacheVisitor : public ValueObject {
+ public:
+  virtual ~MegamorphicCacheVisitor() {}
+  virtual void Visit(const MegamorphicCache& cache) = 0;
+};
+
+// Finds the megamorphic cache of a selector and arguments descriptor.
 class MegamorphicCacheTable : public AllStatic {
  public:
   static RawFunction* miss_handler(Isolate* isolate);
@@ -43,6 +51,13 @@ class MegamorphicCacheTable : public AllStatic {
                                      const String& name,
                                      const Array& descriptor);
 
+  // Returns the buckets shared by all caches that have no entries yet: a
+  // single entry that calls the miss handler. The caller must hold
+  // Isolate::megamorphic_mutex().
+  static RawArray* EmptyBuckets(Isolate* isolate);
+
+  static void VisitCaches(Isolate* isolate, MegamorphicCacheVisitor* visitor);
+
   static void PrintSizes(Isolate* isolate);
 };
 
@@ -6,6 +6,10 @@
 
 #include <memory>
 
+#if defined(HOST_ARCH_X64)
+#include <emmintrin.h>
+#endif
+
 #include "include/dart_api.h"
 #include "platform/assert.h"
 #include "platform/unicode.h"
@@ -1315,6 +1319,12 @@ void Object::FinalizeReadOnlyObject(RawObject* object) {
     ASSERT(size <= desc->HeapSize());
     memset(reinterpret_cast<void*>(RawObject::ToAddr(desc) + size), 0,
            desc->HeapSize() - size);
+  } else if (cid == kDoubleCid) {
+    // On 32-bit the value is preceded by a word of padding.
+    RawDouble* dbl = Double::RawCast(object);
+    const intptr_t header_size = sizeof(RawObject);
+    memset(reinterpret_cast<void*>(RawObject::ToAddr(dbl) + header_size), 0,
+           Double::value_offset() - header_size);
   }
 }
 
@@ -15791,16 +15801,12 @@ RawMegamorphicCache* MegamorphicCache::New(const String& target_name,
     NoSafepointScope no_safepoint;
     result ^= raw;
   }
-  const intptr_t capacity = kInitialCapacity;
+  // Many caches never see a call, so buckets are only allocated by the first
+  // insertion.
   const Array& buckets =
-      Array::Handle(Array::New(kEntryLength * capacity, Heap::kOld));
-  const Function& handler =
-      Function::Handle(MegamorphicCacheTable::miss_handler(Isolate::Current()));
-  for (intptr_t i = 0; i < capacity; ++i) {
-    SetEntry(buckets, i, smi_illegal_cid(), handler);
-  }
+      Array::Handle(MegamorphicCacheTable::EmptyBuckets(Isolate::Current()));
   result.set_buckets(buckets);
-  result.set_mask(capacity - 1);
+  result.set_mask(0);
   result.set_target_name(target_name);
   result.set_arguments_descriptor(arguments_descriptor);
   result.set_filled_entry_count(0);
@@ -15819,7 +15825,7 @@ void MegamorphicCache::EnsureCapacityLocked() const {
   double load_limit = kLoadFactor * static_cast<double>(old_capacity);
   if (static_cast<double>(filled_entry_count() + 1) > load_limit) {
     const Array& old_buckets = Array::Handle(buckets());
-    intptr_t new_capacity = old_capacity * 2;
+    intptr_t new_capacity = Utils::Maximum(old_capacity * 2, kInitialCapacity);
     const Array& new_buckets =
         Array::Handle(Array::New(kEntryLength * new_capacity));
 
@@ -15896,8 +15902,10 @@ void SubtypeTestCache::Cleanup() {
   cached_array_ = NULL;
 }
 
-RawSubtypeTestCache* SubtypeTestCache::New() {
+RawSubtypeTestCache* SubtypeTestCache::New(intptr_t num_inputs) {
   ASSERT(Object::subtypetestcache_class() != Class::null());
+  ASSERT(num_inputs == 1 || num_inputs == 2 || num_inputs == 4 ||
+         num_inputs == kMaxInputs);
   SubtypeTestCache& result = SubtypeTestCache::Handle();
   {
     // SubtypeTestCache objects are long living objects, allocate them in the
@@ -15909,6 +15917,7 @@ RawSubtypeTestCache* SubtypeTestCache::New() {
     result ^= raw;
   }
   result.set_cache(Array::Handle(cached_array_));
+  result.set_num_inputs(num_inputs);
   return result.raw();
 }
 
@@ -15916,8 +15925,142 @@ void SubtypeTestCache::set_cache(const Array& value) const {
   StorePointer(&raw_ptr()->cache_, value.raw());
 }
 
+void SubtypeTestCache::set_num_inputs(intptr_t value) const {
+  StoreNonPointer(&raw_ptr()->num_inputs_, value);
+}
+
+// Caches with more than kMaxLinearCacheEntries checks are kept in an
+// open-addressed hash table instead of a list, on targets whose stubs can
+// probe it:
+//  - The first entry is a header, with the hash mask in
+//    kInstanceClassIdOrFunction and the number of checks in kTestResult.
+//  - The following mask + 1 entries are buckets, probed linearly from the
+//    one picked by Hash.
+//  - The last entry ends the table, with kIllegalCid as its class id and
+//    the number of buckets in kTestResult. A probe reaching it wraps around
+//    to the first bucket.
+// Tables are kept at most half full, so every probe ends at an empty bucket,
+// whose null class id or function ends a search of the list layout too. So
+// both layouts are searched by the same loop, which only starts at a
+// different entry (see FirstEntryToProbe).
+bool SubtypeTestCache::IsHashed(RawArray* cache) {
+  // Lists only grow past kMaxLinearCacheEntries checks on targets that do
+  // not hash them.
+  return kHashLargeCaches &&
+         (Smi::Value(cache->ptr()->length_) >
+          (kMaxLinearCacheEntries + 1) * kTestEntryLength);
+}
+
+// Only hashes what the stubs for [num_inputs] compare, so that checks they
+// treat as equal are found in the same run of buckets.
+intptr_t SubtypeTestCache::Hash(intptr_t num_inputs,
+                                RawObject* instance_class_id_or_function,
+                                RawTypeArguments* instance_type_arguments) {
+  // Closure functions may be moved by the GC, so closures are only told
+  // apart by their type arguments.
+  intptr_t hash = 0;
+  if (!instance_class_id_or_function->IsHeapObject()) {
+    hash = Smi::Value(static_cast<RawSmi*>(instance_class_id_or_function));
+  }
+  if (num_inputs >= 2 && instance_type_arguments != TypeArguments::null()) {
+    hash ^= Smi::Value(instance_type_arguments->ptr()->hash_);
+  }
+  return hash;
+}
+
+intptr_t SubtypeTestCache::FirstBucketToProbe(
+    RawArray* cache,
+    intptr_t num_inputs,
+    RawObject* instance_class_id_or_function,
+    RawTypeArguments* instance_type_arguments) {
+  ASSERT(IsHashed(cache));
+  const intptr_t mask = Smi::Value(static_cast<RawSmi*>(
+      cache->ptr()->data()[kInstanceClassIdOrFunction]));
+  return 1 + (Hash(num_inputs, instance_class_id_or_function,
+                   instance_type_arguments) &
+              mask);
+}
+
+intptr_t SubtypeTestCache::FirstEntryToProbe(
+    RawSubtypeTestCache* cache,
+    RawObject* instance_class_id_or_function,
+    RawTypeArguments* instance_type_arguments) {
+  RawArray* checks = cache->ptr()->cache_;
+  if (!IsHashed(checks)) {
+    return 0;
+  }
+  return FirstBucketToProbe(checks, cache->ptr()->num_inputs_,
+                            instance_class_id_or_function,
+                            instance_type_arguments);
+}
+
+// Returns the index of the first empty bucket for the given check in the
+// hashed [cache].
+intptr_t SubtypeTestCache::FindEmptyEntry(
+    const Array& cache,
+    intptr_t num_inputs,
+    const Object& instance_class_id_or_function,
+    const TypeArguments& instance_type_arguments) {
+  const intptr_t mask = cache.Length() / kTestEntryLength - 3;
+  for (intptr_t i = FirstBucketToProbe(cache.raw(), num_inputs,
+                                       instance_class_id_or_function.raw(),
+                                       instance_type_arguments.raw());
+       ; i = 1 + (i & mask)) {
+    if (cache.At(i * kTestEntryLength + kInstanceClassIdOrFunction) ==
+        Object::null()) {
+      return i;
+    }
+  }
+}
+
+// Returns a hashed cache with [capacity] buckets holding the checks of
+// [cache] in either layout.
+RawArray* SubtypeTestCache::Rehash(const Array& cache,
+                                   intptr_t num_inputs,
+                                   intptr_t capacity) {
+  ASSERT(Utils::IsPowerOfTwo(capacity));
+  ASSERT(capacity > kMaxLinearCacheEntries);
+  Zone* zone = Thread::Current()->zone();
+  const Array& table = Array::Handle(
+      zone, Array::New((capacity + 2) * kTestEntryLength, Heap::kOld));
+  table.SetAt(kInstanceClassIdOrFunction,
+              Smi::Handle(zone, Smi::New(capacity - 1)));
+  table.SetAt((capacity + 1) * kTestEntryLength + kInstanceClassIdOrFunction,
+              Smi::Handle(zone, Smi::New(kIllegalCid)));
+  table.SetAt((capacity + 1) * kTestEntryLength + kTestResult,
+              Smi::Handle(zone, Smi::New(capacity)));
+  Object& instance_class_id_or_function = Object::Handle(zone);
+  TypeArguments& instance_type_arguments = TypeArguments::Handle(zone);
+  Object& value = Object::Handle(zone);
+  const intptr_t first = IsHashed(cache.raw()) ? 1 : 0;
+  const intptr_t sentinel = cache.Length() / kTestEntryLength - 1;
+  intptr_t count = 0;
+  for (intptr_t i = first; i < sentinel; i++) {
+    instance_class_id_or_function =
+        cache.At(i * kTestEntryLength + kInstanceClassIdOrFunction);
+    if (instance_class_id_or_function.IsNull()) continue;
+    instance_type_arguments ^=
+        cache.At(i * kTestEntryLength + kInstanceTypeArguments);
+    instance_type_arguments.Hash();
+    const intptr_t j = FindEmptyEntry(
+        table, num_inputs, instance_class_id_or_function,
+        instance_type_arguments);
+    for (intptr_t k = 0; k < kTestEntryLength; k++) {
+      value = cache.At(i * kTestEntryLength + k);
+      table.SetAt(j * kTestEntryLength + k, value);
+    }
+    count++;
+  }
+  table.SetAt(kTestResult, Smi::Handle(zone, Smi::New(count)));
+  return table.raw();
+}
+
 intptr_t SubtypeTestCache::NumberOfChecks() const {
   NoSafepointScope no_safepoint;
+  if (IsHashed(cache())) {
+    return Smi::Value(
+        static_cast<RawSmi*>(cache()->ptr()->data()[kTestResult]));
+  }
   // Do not count the sentinel;
   return (Smi::Value(cache()->ptr()->length_) / kTestEntryLength) - 1;
 }
@@ -15932,13 +16075,28 @@ void SubtypeTestCache::AddCheck(
     const Bool& test_result) const {
   intptr_t old_num = NumberOfChecks();
   Array& data = Array::Handle(cache());
-  intptr_t new_len = data.Length() + kTestEntryLength;
-  data = Array::Grow(data, new_len);
-  set_cache(data);
+  intptr_t index = old_num;
+  if (!IsHashed(data.raw()) &&
+      (!kHashLargeCaches || old_num < kMaxLinearCacheEntries)) {
+    intptr_t new_len = data.Length() + kTestEntryLength;
+    data = Array::Grow(data, new_len);
+  } else {
+    // The stubs probe with the hash stored in the type arguments.
+    instance_type_arguments.Hash();
+    // Keep the table at most half full.
+    const intptr_t capacity =
+        IsHashed(data.raw()) ? data.Length() / kTestEntryLength - 2 : 0;
+    if (2 * (old_num + 1) > capacity) {
+      data = Rehash(data, num_inputs(),
+                    Utils::RoundUpToPowerOfTwo(2 * (old_num + 1)));
+    }
+    index = FindEmptyEntry(data, num_inputs(), instance_class_id_or_function,
+                           instance_type_arguments);
+    data.SetAt(kTestResult, Smi::Handle(Smi::New(old_num + 1)));
+  }
 
   SubtypeTestCacheTable entries(data);
-  auto entry = entries[old_num];
-  entry.Set<kInstanceClassIdOrFunction>(instance_class_id_or_function);
+  auto entry = entries[index];
   entry.Set<kInstanceTypeArguments>(instance_type_arguments);
   entry.Set<kInstantiatorTypeArguments>(instantiator_type_arguments);
   entry.Set<kFunctionTypeArguments>(function_type_arguments);
@@ -15947,6 +16105,9 @@ void SubtypeTestCache::AddCheck(
   entry.Set<kInstanceDelayedFunctionTypeArguments>(
       instance_delayed_type_arguments);
   entry.Set<kTestResult>(test_result);
+  // Set last, as a non-null class id or function marks a used bucket.
+  entry.Set<kInstanceClassIdOrFunction>(instance_class_id_or_function);
+  set_cache(data);
 }
 
 void SubtypeTestCache::GetCheck(
@@ -15959,6 +16120,18 @@ void SubtypeTestCache::GetCheck(
     TypeArguments* instance_delayed_type_arguments,
     Bool* test_result) const {
   Array& data = Array::Handle(cache());
+  if (IsHashed(data.raw())) {
+    // Find the bucket of the ix-th check.
+    intptr_t i = 1;
+    for (;; i++) {
+      if (data.At(i * kTestEntryLength + kInstanceClassIdOrFunction) !=
+              Object::null() &&
+          ix-- == 0) {
+        break;
+      }
+    }
+    ix = i;
+  }
   SubtypeTestCacheTable entries(data);
   auto entry = entries[ix];
   *instance_class_id_or_function = entry.Get<kInstanceClassIdOrFunction>();
@@ -15972,6 +16145,37 @@ void SubtypeTestCache::GetCheck(
   *test_result ^= entry.Get<kTestResult>();
 }
 
+bool SubtypeTestCache::HasCheck(
+    const Object& instance_class_id_or_function,
+    const TypeArguments& instance_type_arguments,
+    const TypeArguments& instantiator_type_arguments,
+    const TypeArguments& function_type_arguments,
+    const TypeArguments& instance_parent_function_type_arguments,
+    const TypeArguments& instance_delayed_type_arguments) const {
+  const Array& data = Array::Handle(cache());
+  SubtypeTestCacheTable entries(data);
+  const intptr_t first = IsHashed(data.raw()) ? 1 : 0;
+  const intptr_t sentinel = entries.Length() - 1;
+  for (intptr_t i = first; i < sentinel; i++) {
+    auto entry = entries[i];
+    if ((entry.Get<kInstanceClassIdOrFunction>() ==
+         instance_class_id_or_function.raw()) &&
+        (entry.Get<kInstanceTypeArguments>() ==
+         instance_type_arguments.raw()) &&
+        (entry.Get<kInstantiatorTypeArguments>() ==
+         instantiator_type_arguments.raw()) &&
+        (entry.Get<kFunctionTypeArguments>() ==
+         function_type_arguments.raw()) &&
+        (entry.Get<kInstanceParentFunctionTypeArguments>() ==
+         instance_parent_function_type_arguments.raw()) &&
+        (entry.Get<kInstanceDelayedFunctionTypeArguments>() ==
+         instance_delayed_type_arguments.raw())) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void SubtypeTestCache::Reset() const {
   set_cache(Array::Handle(cached_array_));
 }
@@ -19516,6 +19720,159 @@ bool String::EndsWith(const String& other) const {
   return true;
 }
 
+// Returns the index of the first 'code_unit' in chars[start, end), or -1.
+// memchr compares many bytes at a time.
+static intptr_t FindCodeUnit(const uint8_t* chars,
+                             intptr_t start,
+                             intptr_t end,
+                             uint16_t code_unit) {
+  if ((code_unit > 0xFF) || (start >= end)) {
+    return -1;
+  }
+  const void* found = memchr(&chars[start], code_unit, end - start);
+  return (found == NULL) ? -1 : static_cast<const uint8_t*>(found) - chars;
+}
+
+static intptr_t FindCodeUnit(const uint16_t* chars,
+                             intptr_t start,
+                             intptr_t end,
+                             uint16_t code_unit) {
+  intptr_t i = start;
+#if defined(HOST_ARCH_X64)
+  // SSE2 is part of the x64 baseline, so this needs no CPU feature check.
+  const __m128i needle = _mm_set1_epi16(static_cast<int16_t>(code_unit));
+  for (; i + 8 <= end; i += 8) {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&chars[i]));
+    // Two bits, one per byte, for each code unit that matches.
+    const uint32_t matches =
+        _mm_movemask_epi8(_mm_cmpeq_epi16(chunk, needle));
+    if (matches != 0) {
+      return i + Utils::CountTrailingZeros32(matches) / 2;
+    }
+  }
+#endif
+  for (; i < end; i++) {
+    if (chars[i] == code_unit) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+template <typename CharType, typename PatternType>
+static bool CodeUnitsMatch(const CharType* chars,
+                           const PatternType* pattern,
+                           intptr_t length) {
+  for (intptr_t i = 0; i < length; i++) {
+    if (chars[i] != pattern[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename CharType>
+static bool CodeUnitsMatch(const CharType* chars,
+                           const CharType* pattern,
+                           intptr_t length) {
+  return memcmp(chars, pattern, length * sizeof(CharType)) == 0;
+}
+
+// Candidates are found by the pattern's first code unit, many code units at
+// a time, and then compared in full.
+template <typename CharType, typename PatternType>
+static intptr_t IndexOfCodeUnits(const CharType* chars,
+                                 intptr_t length,
+                                 const PatternType* pattern,
+                                 intptr_t pattern_length,
+                                 intptr_t start) {
+  ASSERT(pattern_length > 0);
+  const intptr_t end = length - pattern_length + 1;
+  while (start < end) {
+    const intptr_t index = FindCodeUnit(chars, start, end, pattern[0]);
+    if (index < 0) {
+      return -1;
+    }
+    if (CodeUnitsMatch(&chars[index + 1], &pattern[1], pattern_length - 1)) {
+      return index;
+    }
+    start = index + 1;
+  }
+  return -1;
+}
+
+// The pattern is given by exactly one of 'one_byte_pattern' and
+// 'two_byte_pattern'.
+template <typename CharType>
+static intptr_t IndexOfString(const CharType* chars,
+                              intptr_t length,
+                              const uint8_t* one_byte_pattern,
+                              const uint16_t* two_byte_pattern,
+                              intptr_t pattern_length,
+                              intptr_t start) {
+  if (one_byte_pattern != NULL) {
+    return IndexOfCodeUnits(chars, length, one_byte_pattern, pattern_length,
+                            start);
+  }
+  return IndexOfCodeUnits(chars, length, two_byte_pattern, pattern_length,
+                          start);
+}
+
+intptr_t String::IndexOf(const String& other, intptr_t start) const {
+  const intptr_t len = this->Length();
+  const intptr_t other_len = other.Length();
+  ASSERT((0 <= start) && (start <= len));
+  if (other_len == 0) {
+    return start;
+  }
+  NoSafepointScope no_safepoint;
+  const uint8_t* one_byte = NULL;
+  const uint16_t* two_byte = NULL;
+  if (other.IsOneByteString()) {
+    one_byte = OneByteString::DataStart(other);
+  } else if (other.IsTwoByteString()) {
+    two_byte = TwoByteString::DataStart(other);
+  } else if (other.IsExternalOneByteString()) {
+    one_byte = ExternalOneByteString::DataStart(other);
+  } else {
+    ASSERT(other.IsExternalTwoByteString());
+    two_byte = ExternalTwoByteString::DataStart(other);
+  }
+  if (IsOneByteString()) {
+    return IndexOfString(OneByteString::DataStart(*this), len, one_byte,
+                         two_byte, other_len, start);
+  } else if (IsTwoByteString()) {
+    return IndexOfString(TwoByteString::DataStart(*this), len, one_byte,
+                         two_byte, other_len, start);
+  } else if (IsExternalOneByteString()) {
+    return IndexOfString(ExternalOneByteString::DataStart(*this), len,
+                         one_byte, two_byte, other_len, start);
+  }
+  ASSERT(IsExternalTwoByteString());
+  return IndexOfString(ExternalTwoByteString::DataStart(*this), len, one_byte,
+                       two_byte, other_len, start);
+}
+
+intptr_t String::IndexOf(uint16_t code_unit, intptr_t start) const {
+  const intptr_t len = this->Length();
+  ASSERT((0 <= start) && (start <= len));
+  NoSafepointScope no_safepoint;
+  if (IsOneByteString()) {
+    return FindCodeUnit(OneByteString::DataStart(*this), start, len,
+                        code_unit);
+  } else if (IsTwoByteString()) {
+    return FindCodeUnit(TwoByteString::DataStart(*this), start, len,
+                        code_unit);
+  } else if (IsExternalOneByteString()) {
+    return FindCodeUnit(ExternalOneByteString::DataStart(*this), start, len,
+                        code_unit);
+  }
+  ASSERT(IsExternalTwoByteString());
+  return FindCodeUnit(ExternalTwoByteString::DataStart(*this), start, len,
+                      code_unit);
+}
+
 RawInstance* String::CheckAndCanonicalize(Thread* thread,
                                           const char** error_str) const {
   if (IsCanonical()) {
@@ -20024,6 +20381,34 @@ void String::ToUTF8(uint8_t* utf8_array, intptr_t array_len) const {
   Utf8::Encode(*this, reinterpret_cast<char*>(utf8_array), array_len);
 }
 
+void String::ToLatin1(uint8_t* latin1_array, intptr_t array_len) const {
+  ASSERT(array_len >= Length());
+  NoSafepointScope no_safepoint;
+  if (IsOneByteString()) {
+    memmove(latin1_array, OneByteString::DataStart(*this), Length());
+  } else {
+    ASSERT(IsExternalOneByteString());
+    memmove(latin1_array, ExternalOneByteString::DataStart(*this), Length());
+  }
+}
+
+void String::ToUTF16(uint16_t* utf16_array, intptr_t array_len) const {
+  ASSERT(array_len >= Length());
+  NoSafepointScope no_safepoint;
+  const intptr_t length = Length();
+  if (IsTwoByteString()) {
+    memmove(utf16_array, TwoByteString::DataStart(*this),
+            length * sizeof(uint16_t));
+  } else if (IsExternalTwoByteString()) {
+    memmove(utf16_array, ExternalTwoByteString::DataStart(*this),
+            length * sizeof(uint16_t));
+  } else {
+    for (intptr_t i = 0; i < length; i++) {
+      utf16_array[i] = CharAt(i);
+    }
+  }
+}
+
 static FinalizablePersistentHandle* AddFinalizer(
     const Object& referent,
     void* peer,
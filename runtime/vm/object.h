@@ -4793,41 +4793,65 @@ class Instructions : public Object {
 #endif
 
   static uword MonomorphicEntryPoint(const RawInstructions* instr) {
-    uword entry = PayloadStart(instr);
-    if (!HasSingleEntryPoint(instr)) {
+    return MonomorphicEntryPoint(PayloadStart(instr),
+                                 HasSingleEntryPoint(instr));
+  }
+
+  static uword EntryPoint(const RawInstructions* instr) {
+    return EntryPoint(PayloadStart(instr), HasSingleEntryPoint(instr));
+  }
+
+  static uword UncheckedEntryPoint(const RawInstructions* instr) {
+    return UncheckedEntryPoint(PayloadStart(instr),
+                               UncheckedEntryPointPcOffset(instr),
+                               HasSingleEntryPoint(instr));
+  }
+
+  static uword MonomorphicUncheckedEntryPoint(const RawInstructions* instr) {
+    return MonomorphicUncheckedEntryPoint(PayloadStart(instr),
+                                          UncheckedEntryPointPcOffset(instr),
+                                          HasSingleEntryPoint(instr));
+  }
+
+  // Variants of the above that take the header fields as arguments, for
+  // callers such as the snapshot reader that must not touch the (possibly
+  // not yet paged in) instructions.
+  static uword MonomorphicEntryPoint(uword payload_start,
+                                     bool has_single_entry_point) {
+    uword entry = payload_start;
+    if (!has_single_entry_point) {
       entry += !FLAG_precompiled_mode ? kMonomorphicEntryOffsetJIT
                                       : kMonomorphicEntryOffsetAOT;
     }
     return entry;
   }
 
-  static uword EntryPoint(const RawInstructions* instr) {
-    uword entry = PayloadStart(instr);
-    if (!HasSingleEntryPoint(instr)) {
+  static uword EntryPoint(uword payload_start, bool has_single_entry_point) {
+    uword entry = payload_start;
+    if (!has_single_entry_point) {
       entry += !FLAG_precompiled_mode ? kPolymorphicEntryOffsetJIT
                                       : kPolymorphicEntryOffsetAOT;
     }
     return entry;
   }
 
-  static uword UncheckedEntryPoint(const RawInstructions* instr) {
-    uword entry =
-        PayloadStart(instr) + instr->ptr()->unchecked_entrypoint_pc_offset_;
-    if (!HasSingleEntryPoint(instr)) {
-      entry += !FLAG_precompiled_mode ? kPolymorphicEntryOffsetJIT
-                                      : kPolymorphicEntryOffsetAOT;
-    }
-    return entry;
+  static uword UncheckedEntryPoint(uword payload_start,
+                                   uint32_t unchecked_entrypoint_pc_offset,
+                                   bool has_single_entry_point) {
+    return EntryPoint(payload_start + unchecked_entrypoint_pc_offset,
+                      has_single_entry_point);
   }
 
-  static uword MonomorphicUncheckedEntryPoint(const RawInstructions* instr) {
-    uword entry =
-        PayloadStart(instr) + instr->ptr()->unchecked_entrypoint_pc_offset_;
-    if (!HasSingleEntryPoint(instr)) {
-      entry += !FLAG_precompiled_mode ? kMonomorphicEntryOffsetJIT
-                                      : kMonomorphicEntryOffsetAOT;
-    }
-    return entry;
+  static uword MonomorphicUncheckedEntryPoint(
+      uword payload_start,
+      uint32_t unchecked_entrypoint_pc_offset,
+      bool has_single_entry_point) {
+    return MonomorphicEntryPoint(
+        payload_start + unchecked_entrypoint_pc_offset, has_single_entry_point);
+  }
+
+  static uint32_t UncheckedEntryPointPcOffset(const RawInstructions* instr) {
+    return instr->ptr()->unchecked_entrypoint_pc_offset_;
   }
 
   static const intptr_t kMaxElements =
@@ -6123,6 +6147,25 @@ class SubtypeTestCache : public Object {
     kTestEntryLength = 7,
   };
 
+  // Caches with more checks than this are kept in a hash table instead of a
+  // list, on targets whose stubs can probe it (see AddCheck).
+  static const intptr_t kMaxLinearCacheEntries = 30;
+
+  // Whether the stubs of the target probe the hash tables. Caches keep the
+  // list layout whatever their size otherwise.
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+  static const bool kHashLargeCaches = true;
+#else
+  static const bool kHashLargeCaches = false;
+#endif
+
+  // The most inputs a check compares, as in the Subtype6TestCache stub.
+  static const intptr_t kMaxInputs = 6;
+
+  // The number of inputs compared by the stubs probing this cache, which
+  // decides what is hashed once the cache is a hash table.
+  intptr_t num_inputs() const { return raw_ptr()->num_inputs_; }
+
   intptr_t NumberOfChecks() const;
   void AddCheck(const Object& instance_class_id_or_function,
                 const TypeArguments& instance_type_arguments,
@@ -6139,9 +6182,27 @@ class SubtypeTestCache : public Object {
                 TypeArguments* instance_parent_function_type_arguments,
                 TypeArguments* instance_delayed_type_arguments,
                 Bool* test_result) const;
+  bool HasCheck(const Object& instance_class_id_or_function,
+                const TypeArguments& instance_type_arguments,
+                const TypeArguments& instantiator_type_arguments,
+                const TypeArguments& function_type_arguments,
+                const TypeArguments& instance_parent_function_type_arguments,
+                const TypeArguments& instance_delayed_type_arguments) const;
   void Reset() const;
 
-  static RawSubtypeTestCache* New();
+  // Returns the index of the first entry of the checks of [cache] to compare
+  // with a check of an instance with the given class id (or closure function)
+  // and type arguments. The search continues with the following entries until
+  // one with a null class id or function. An entry with the class id
+  // kIllegalCid ends a hash table: the search then wraps around to entry 1.
+  static intptr_t FirstEntryToProbe(
+      RawSubtypeTestCache* cache,
+      RawObject* instance_class_id_or_function,
+      RawTypeArguments* instance_type_arguments);
+
+  // Returns a cache for checks compared on their first [num_inputs] inputs:
+  // 1, 2, 4 or 6, as in the SubtypeNTestCache stubs.
+  static RawSubtypeTestCache* New(intptr_t num_inputs);
 
   static intptr_t InstanceSize() {
     return RoundedAllocationSize(sizeof(RawSubtypeTestCache));
@@ -6161,9 +6222,27 @@ class SubtypeTestCache : public Object {
   RawArray* cache() const { return raw_ptr()->cache_; }
 
   void set_cache(const Array& value) const;
+  void set_num_inputs(intptr_t value) const;
 
   intptr_t TestEntryLength() const;
 
+  static bool IsHashed(RawArray* cache);
+  static intptr_t Hash(intptr_t num_inputs,
+                       RawObject* instance_class_id_or_function,
+                       RawTypeArguments* instance_type_arguments);
+  static intptr_t FirstBucketToProbe(
+      RawArray* cache,
+      intptr_t num_inputs,
+      RawObject* instance_class_id_or_function,
+      RawTypeArguments* instance_type_arguments);
+  static intptr_t FindEmptyEntry(const Array& cache,
+                                 intptr_t num_inputs,
+                                 const Object& instance_class_id_or_function,
+                                 const TypeArguments& instance_type_arguments);
+  static RawArray* Rehash(const Array& cache,
+                          intptr_t num_inputs,
+                          intptr_t capacity);
+
   FINAL_HEAP_OBJECT_IMPLEMENTATION(SubtypeTestCache, Object);
   friend class Class;
   friend class Serializer;
@@ -6699,6 +6778,8 @@ class TypeArguments : public Instance {
     return OFFSET_OF(RawTypeArguments, instantiations_);
   }
 
+  static intptr_t hash_offset() { return OFFSET_OF(RawTypeArguments, hash_); }
+
   static const intptr_t kBytesPerElement = kWordSize;
   static const intptr_t kMaxElements = kSmiMax / kBytesPerElement;
 
@@ -7664,6 +7745,11 @@ class String : public Instance {
   bool StartsWith(const String& other) const;
   bool EndsWith(const String& other) const;
 
+  // Returns the index of the first occurrence of 'other' at or after
+  // 'start', or -1 if there is none.
+  intptr_t IndexOf(const String& other, intptr_t start) const;
+  intptr_t IndexOf(uint16_t code_unit, intptr_t start) const;
+
   // Strings are canonicalized using the symbol table.
   virtual RawInstance* CheckAndCanonicalize(Thread* thread,
                                             const char** error_str) const;
@@ -7699,6 +7785,10 @@ class String : public Instance {
 
   char* ToMallocCString() const;
   void ToUTF8(uint8_t* utf8_array, intptr_t array_len) const;
+  // Copies the code units of a one-byte string to 'latin1_array'.
+  void ToLatin1(uint8_t* latin1_array, intptr_t array_len) const;
+  // Copies the code units of a string to 'utf16_array'.
+  void ToUTF16(uint16_t* utf16_array, intptr_t array_len) const;
 
   // Creates a new String object from a C string that is assumed to contain
   // UTF-8 encoded characters and '\0' is considered a termination character.
@@ -8006,6 +8096,8 @@ class OneByteString : public AllStatic {
                                     bool as_reference);
 
   friend class Class;
+  friend class LinearRegExp;
+  friend class RegExpMacroAssembler;
   friend class String;
   friend class Symbols;
   friend class ExternalOneByteString;
@@ -8131,6 +8223,8 @@ class TwoByteString : public AllStatic {
                                     bool as_reference);
 
   friend class Class;
+  friend class LinearRegExp;
+  friend class RegExpMacroAssembler;
   friend class String;
   friend class SnapshotReader;
   friend class Symbols;
@@ -8221,6 +8315,8 @@ class ExternalOneByteString : public AllStatic {
   }
 
   friend class Class;
+  friend class LinearRegExp;
+  friend class RegExpMacroAssembler;
   friend class String;
   friend class SnapshotReader;
   friend class Symbols;
@@ -8308,6 +8404,8 @@ class ExternalTwoByteString : public AllStatic {
   }
 
   friend class Class;
+  friend class LinearRegExp;
+  friend class RegExpMacroAssembler;
   friend class String;
   friend class SnapshotReader;
   friend class Symbols;
@@ -9649,10 +9747,13 @@ class RegExp : public Instance {
   // kUninitialized: the type of th regexp has not been initialized yet.
   // kSimple: A simple pattern to match against, using string indexOf operation.
   // kComplex: A complex pattern to match.
+  // kLinear: A pattern matched in linear time, see regexp_linear.h. Its
+  // program is kept as the one-byte, non-sticky bytecode.
   enum RegExType {
     kUninitialized = 0,
     kSimple = 1,
     kComplex = 2,
+    kLinear = 3,
   };
 
   enum {
@@ -9668,6 +9769,7 @@ class RegExp : public Instance {
   bool is_initialized() const { return (type() != kUninitialized); }
   bool is_simple() const { return (type() == kSimple); }
   bool is_complex() const { return (type() == kComplex); }
+  bool is_linear() const { return (type() == kLinear); }
 
   intptr_t num_registers(bool is_one_byte) const {
     return is_one_byte ? raw_ptr()->num_one_byte_registers_
@@ -9763,6 +9865,7 @@ class RegExp : public Instance {
   }
   void set_is_simple() const { set_type(kSimple); }
   void set_is_complex() const { set_type(kComplex); }
+  void set_is_linear() const { set_type(kLinear); }
   void set_num_registers(bool is_one_byte, intptr_t value) const {
     if (is_one_byte) {
       StoreNonPointer(&raw_ptr()->num_one_byte_registers_, value);
@@ -1539,7 +1539,7 @@ void RegExp::PrintJSONImpl(JSONStream* stream, bool ref) const {
   jsobj.AddProperty("isCaseSensitive", !flags().IgnoreCase());
   jsobj.AddProperty("isMultiLine", flags().IsMultiLine());
 
-  if (!FLAG_interpret_irregexp) {
+  if (!FLAG_interpret_irregexp && !is_linear()) {
     Function& func = Function::Handle();
     func = function(kOneByteStringCid, /*sticky=*/false);
     jsobj.AddProperty("_oneByteFunction", func);
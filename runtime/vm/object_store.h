@@ -131,7 +131,8 @@ class ObjectPointerVisitor;
   RW(Array, llvm_constant_hash_table)                                          \
   RW(ObjectPool, global_object_pool)                                           \
   RW(Array, unique_dynamic_targets)                                            \
-  RW(GrowableObjectArray, megamorphic_cache_table)                             \
+  RW(Array, megamorphic_cache_table)                                           \
+  RW(Array, megamorphic_empty_buckets)                                         \
   RW(Code, build_method_extractor_code)                                        \
   RW(Code, null_error_stub_with_fpu_regs_stub)                                 \
   RW(Code, null_error_stub_without_fpu_regs_stub)                              \
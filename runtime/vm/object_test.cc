@@ -2958,7 +2958,8 @@ ISOLATE_UNIT_TEST_CASE(SubtypeTestCache) {
   Script& script = Script::Handle();
   const Class& empty_class =
       Class::Handle(CreateDummyClass(class_name, script));
-  SubtypeTestCache& cache = SubtypeTestCache::Handle(SubtypeTestCache::New());
+  SubtypeTestCache& cache = SubtypeTestCache::Handle(
+      SubtypeTestCache::New(SubtypeTestCache::kMaxInputs));
   EXPECT(!cache.IsNull());
   EXPECT_EQ(0, cache.NumberOfChecks());
   const Object& class_id_or_fun = Object::Handle(Smi::New(empty_class.id()));
@@ -2986,6 +2987,174 @@ ISOLATE_UNIT_TEST_CASE(SubtypeTestCache) {
   EXPECT_EQ(Bool::True().raw(), test_result.raw());
 }
 
+ISOLATE_UNIT_TEST_CASE(SubtypeTestCacheManyChecks) {
+  SubtypeTestCache& cache = SubtypeTestCache::Handle(
+      SubtypeTestCache::New(SubtypeTestCache::kMaxInputs));
+  const TypeArguments& targ_0 = TypeArguments::Handle(TypeArguments::New(2));
+  const TypeArguments& null_targ = TypeArguments::Handle();
+  Object& class_id = Object::Handle();
+  // Enough checks to switch to the hashed layout and grow it.
+  const intptr_t kNumChecks = 4 * SubtypeTestCache::kMaxLinearCacheEntries;
+  for (intptr_t i = 0; i < kNumChecks; i++) {
+    class_id = Smi::New(kNumPredefinedCids + i);
+    cache.AddCheck(class_id, i % 2 == 0 ? targ_0 : null_targ, null_targ,
+                   null_targ, null_targ, null_targ, Bool::Get(i % 3 == 0));
+    EXPECT_EQ(i + 1, cache.NumberOfChecks());
+  }
+  for (intptr_t i = 0; i < kNumChecks; i++) {
+    class_id = Smi::New(kNumPredefinedCids + i);
+    EXPECT(cache.HasCheck(class_id, i % 2 == 0 ? targ_0 : null_targ,
+                          null_targ, null_targ, null_targ, null_targ));
+    EXPECT(!cache.HasCheck(class_id, i % 2 == 0 ? null_targ : targ_0,
+                           null_targ, null_targ, null_targ, null_targ));
+  }
+
+  // Every check is visited once.
+  Object& test_class_id = Object::Handle();
+  TypeArguments& test_targ_0 = TypeArguments::Handle();
+  TypeArguments& test_targ_1 = TypeArguments::Handle();
+  TypeArguments& test_targ_2 = TypeArguments::Handle();
+  TypeArguments& test_targ_3 = TypeArguments::Handle();
+  TypeArguments& test_targ_4 = TypeArguments::Handle();
+  Bool& test_result = Bool::Handle();
+  intptr_t sum = 0;
+  for (intptr_t ix = 0; ix < kNumChecks; ix++) {
+    cache.GetCheck(ix, &test_class_id, &test_targ_0, &test_targ_1,
+                   &test_targ_2, &test_targ_3, &test_targ_4, &test_result);
+    const intptr_t i = Smi::Cast(test_class_id).Value() - kNumPredefinedCids;
+    EXPECT_EQ(i % 2 == 0 ? targ_0.raw() : TypeArguments::null(),
+              test_targ_0.raw());
+    EXPECT_EQ(Bool::Get(i % 3 == 0).raw(), test_result.raw());
+    sum += i;
+  }
+  EXPECT_EQ(kNumChecks * (kNumChecks - 1) / 2, sum);
+
+  cache.Reset();
+  EXPECT_EQ(0, cache.NumberOfChecks());
+}
+
+// Targets whose stubs do not probe hash tables keep growing the list.
+ISOLATE_UNIT_TEST_CASE(SubtypeTestCacheLayout) {
+  SubtypeTestCache& cache = SubtypeTestCache::Handle(
+      SubtypeTestCache::New(SubtypeTestCache::kMaxInputs));
+  const TypeArguments& null_targ = TypeArguments::Handle();
+  Object& class_id = Object::Handle();
+  const intptr_t kNumChecks = 2 * SubtypeTestCache::kMaxLinearCacheEntries + 5;
+  for (intptr_t i = 0; i < kNumChecks; i++) {
+    class_id = Smi::New(kNumPredefinedCids + i);
+    cache.AddCheck(class_id, null_targ, null_targ, null_targ, null_targ,
+                   null_targ, Bool::Get(i % 2 == 0));
+    EXPECT_EQ(i + 1, cache.NumberOfChecks());
+  }
+
+  Object& test_class_id = Object::Handle();
+  TypeArguments& test_targ = TypeArguments::Handle();
+  Bool& test_result = Bool::Handle();
+  for (intptr_t i = 0; i < kNumChecks; i++) {
+    class_id = Smi::New(kNumPredefinedCids + i);
+    EXPECT(cache.HasCheck(class_id, null_targ, null_targ, null_targ,
+                          null_targ, null_targ));
+    const intptr_t first = SubtypeTestCache::FirstEntryToProbe(
+        cache.raw(), class_id.raw(), TypeArguments::null());
+    if (SubtypeTestCache::kHashLargeCaches) {
+      // Entry 0 is the header of the table.
+      EXPECT(first > 0);
+    } else {
+      // The stubs search the list from its start, in the order of AddCheck.
+      EXPECT_EQ(0, first);
+      cache.GetCheck(i, &test_class_id, &test_targ, &test_targ, &test_targ,
+                     &test_targ, &test_targ, &test_result);
+      EXPECT_EQ(class_id.raw(), test_class_id.raw());
+      EXPECT_EQ(Bool::Get(i % 2 == 0).raw(), test_result.raw());
+    }
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(SubtypeTestCacheEqualHashes) {
+  SubtypeTestCache& cache = SubtypeTestCache::Handle(
+      SubtypeTestCache::New(SubtypeTestCache::kMaxInputs));
+  const Object& class_id = Object::Handle(Smi::New(kNumPredefinedCids));
+  const TypeArguments& null_targ = TypeArguments::Handle();
+  const Type& type = Type::Handle(Type::IntType());
+  // Checks that only differ in their instantiator type arguments all hash
+  // alike, so their probes wrap around instead of growing the table.
+  const intptr_t kNumChecks = 8 * SubtypeTestCache::kMaxLinearCacheEntries;
+  GrowableArray<TypeArguments*> targs;
+  for (intptr_t i = 0; i < kNumChecks; i++) {
+    TypeArguments& targ = TypeArguments::Handle(TypeArguments::New(1));
+    targ.SetTypeAt(0, type);
+    targs.Add(&targ);
+    cache.AddCheck(class_id, null_targ, targ, null_targ, null_targ, null_targ,
+                   Bool::True());
+    EXPECT_EQ(i + 1, cache.NumberOfChecks());
+  }
+  for (intptr_t i = 0; i < kNumChecks; i++) {
+    EXPECT(cache.HasCheck(class_id, null_targ, *targs[i], null_targ,
+                          null_targ, null_targ));
+  }
+
+  // Stubs comparing only the class id probe from the same bucket whatever
+  // the instance type arguments.
+  SubtypeTestCache& one_input_cache =
+      SubtypeTestCache::Handle(SubtypeTestCache::New(1));
+  Object& other_class_id = Object::Handle();
+  for (intptr_t i = 0; i <= SubtypeTestCache::kMaxLinearCacheEntries; i++) {
+    other_class_id = Smi::New(kNumPredefinedCids + i);
+    one_input_cache.AddCheck(other_class_id, *targs[i], null_targ, null_targ,
+                             null_targ, null_targ, Bool::True());
+  }
+  const TypeArguments& int_targ =
+      TypeArguments::Handle(TypeArguments::New(1));
+  int_targ.SetTypeAt(0, type);
+  int_targ.Hash();
+  const TypeArguments& double_targ =
+      TypeArguments::Handle(TypeArguments::New(1));
+  double_targ.SetTypeAt(0, Type::Handle(Type::Double()));
+  double_targ.Hash();
+  EXPECT_EQ(SubtypeTestCache::FirstEntryToProbe(
+                one_input_cache.raw(), class_id.raw(), int_targ.raw()),
+            SubtypeTestCache::FirstEntryToProbe(
+                one_input_cache.raw(), class_id.raw(), double_targ.raw()));
+  EXPECT_EQ(SubtypeTestCache::FirstEntryToProbe(
+                one_input_cache.raw(), class_id.raw(), int_targ.raw()),
+            SubtypeTestCache::FirstEntryToProbe(
+                one_input_cache.raw(), class_id.raw(), null_targ.raw()));
+}
+
+ISOLATE_UNIT_TEST_CASE(MegamorphicCacheTable) {
+  const String& name = String::Handle(Symbols::New(thread, "foo"));
+  const String& other_name = String::Handle(Symbols::New(thread, "bar"));
+  const Array& descriptor =
+      Array::Handle(ArgumentsDescriptor::New(0, 1, Object::null_array()));
+  const Array& other_descriptor =
+      Array::Handle(ArgumentsDescriptor::New(0, 2, Object::null_array()));
+  const MegamorphicCache& cache = MegamorphicCache::Handle(
+      MegamorphicCacheTable::Lookup(thread, name, descriptor));
+  EXPECT_EQ(cache.raw(),
+            MegamorphicCacheTable::Lookup(thread, name, descriptor));
+  const MegamorphicCache& other_cache = MegamorphicCache::Handle(
+      MegamorphicCacheTable::Lookup(thread, name, other_descriptor));
+  EXPECT_NE(cache.raw(), other_cache.raw());
+  EXPECT_NE(cache.raw(),
+            MegamorphicCacheTable::Lookup(thread, other_name, descriptor));
+
+  // Caches without entries share their buckets.
+  EXPECT_EQ(cache.buckets(), other_cache.buckets());
+  EXPECT_EQ(0, cache.mask());
+
+  const Function& target =
+      Function::Handle(MegamorphicCacheTable::miss_handler(thread->isolate()));
+  const intptr_t kNumEntries = MegamorphicCache::kInitialCapacity;
+  for (intptr_t i = 0; i < kNumEntries; i++) {
+    cache.Insert(Smi::Handle(Smi::New(kNumPredefinedCids + i)), target);
+    EXPECT_EQ(i + 1, cache.filled_entry_count());
+  }
+  EXPECT_LE(MegamorphicCache::kInitialCapacity, cache.mask() + 1);
+  EXPECT_NE(cache.buckets(), other_cache.buckets());
+  EXPECT_EQ(0, other_cache.mask());
+  EXPECT_EQ(0, other_cache.filled_entry_count());
+}
+
 ISOLATE_UNIT_TEST_CASE(FieldTests) {
   const String& f = String::Handle(String::New("oneField"));
   const String& getter_f = String::Handle(Field::GetterName(f));
@@ -175,28 +175,30 @@ void ProgramVisitor::BindStaticCalls() {
 }
 
 void ProgramVisitor::ShareMegamorphicBuckets() {
+  class ShareMegamorphicBucketsVisitor : public MegamorphicCacheVisitor {
+   public:
+    explicit ShareMegamorphicBucketsVisitor(const Array& buckets)
+        : buckets_(buckets) {}
+
+    void Visit(const MegamorphicCache& cache) {
+      cache.set_buckets(buckets_);
+      cache.set_mask(0);
+      cache.set_filled_entry_count(0);
+    }
+
+   private:
+    const Array& buckets_;
+  };
+
   Thread* thread = Thread::Current();
   Isolate* isolate = thread->isolate();
   Zone* zone = thread->zone();
 
-  const GrowableObjectArray& table = GrowableObjectArray::Handle(
-      zone, isolate->object_store()->megamorphic_cache_table());
-  if (table.IsNull()) return;
-  MegamorphicCache& cache = MegamorphicCache::Handle(zone);
-
-  const intptr_t capacity = 1;
-  const Array& buckets = Array::Handle(
-      zone, Array::New(MegamorphicCache::kEntryLength * capacity, Heap::kOld));
-  const Function& handler =
-      Function::Handle(zone, MegamorphicCacheTable::miss_handler(isolate));
-  MegamorphicCache::SetEntry(buckets, 0, Object::smi_illegal_cid(), handler);
-
-  for (intptr_t i = 0; i < table.Length(); i++) {
-    cache ^= table.At(i);
-    cache.set_buckets(buckets);
-    cache.set_mask(capacity - 1);
-    cache.set_filled_entry_count(0);
-  }
+  SafepointMutexLocker ml(isolate->megamorphic_mutex());
+  const Array& buckets =
+      Array::Handle(zone, MegamorphicCacheTable::EmptyBuckets(isolate));
+  ShareMegamorphicBucketsVisitor visitor(buckets);
+  MegamorphicCacheTable::VisitCaches(isolate, &visitor);
 }
 
 class CompressedStackMapsKeyValueTrait {
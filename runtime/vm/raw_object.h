@@ -1867,6 +1867,8 @@ class RawSubtypeTestCache : public RawObject {
   VISIT_FROM(RawObject*, cache_);
   RawArray* cache_;
   VISIT_TO(RawObject*, cache_);
+
+  int32_t num_inputs_;
 };
 
 class RawError : public RawObject {
@@ -1973,6 +1975,7 @@ class RawTypeArguments : public RawInstance {
 
   friend class Object;
   friend class SnapshotReader;
+  friend class SubtypeTestCache;
 };
 
 class RawAbstractType : public RawInstance {
@@ -16,6 +16,8 @@
 #include "vm/regexp_assembler_bytecode.h"
 #include "vm/regexp_assembler_ir.h"
 #include "vm/regexp_ast.h"
+#include "vm/regexp_linear.h"
+#include "vm/regexp_parser.h"
 #include "vm/symbols.h"
 #include "vm/thread.h"
 #include "vm/unibrow-inl.h"
@@ -2959,22 +2961,6 @@ void BoyerMooreLookahead::EmitSkipInstructions(RegExpMacroAssembler* masm) {
     return;
   }
 
-  if (found_single_character) {
-    BlockLabel cont, again;
-    masm->BindBlock(&again);
-    masm->LoadCurrentCharacter(max_lookahead, &cont, true);
-    if (max_char_ > kSize) {
-      masm->CheckCharacterAfterAnd(single_character,
-                                   RegExpMacroAssembler::kTableMask, &cont);
-    } else {
-      masm->CheckCharacter(single_character, &cont);
-    }
-    masm->AdvanceCurrentPosition(lookahead_width);
-    masm->GoTo(&again);
-    masm->BindBlock(&cont);
-    return;
-  }
-
   const TypedData& boolean_skip_table = TypedData::ZoneHandle(
       compiler_->zone(),
       TypedData::New(kTypedDataUint8ArrayCid, kSize, Heap::kOld));
@@ -2982,17 +2968,24 @@ void BoyerMooreLookahead::EmitSkipInstructions(RegExpMacroAssembler* masm) {
       GetSkipTable(min_lookahead, max_lookahead, boolean_skip_table);
   ASSERT(skip_distance != 0);
 
-  BlockLabel cont, again;
-
-  masm->BindBlock(&again);
-  masm->CheckPreemption(/*is_backtrack=*/false);
+  // The first position is checked inline, and only when it cannot start a
+  // match is the rest of the subject scanned, which the macro assembler does
+  // natively and, for one or two characters, many characters at a time.
+  BlockLabel cont;
   masm->LoadCurrentCharacter(max_lookahead, &cont, true);
-  masm->CheckBitInTable(boolean_skip_table, &cont);
+  if (found_single_character) {
+    if (max_char_ > kSize) {
+      masm->CheckCharacterAfterAnd(single_character,
+                                   RegExpMacroAssembler::kTableMask, &cont);
+    } else {
+      masm->CheckCharacter(single_character, &cont);
+    }
+  } else {
+    masm->CheckBitInTable(boolean_skip_table, &cont);
+  }
   masm->AdvanceCurrentPosition(skip_distance);
-  masm->GoTo(&again);
+  masm->SkipUntilBitInTable(max_lookahead, boolean_skip_table, skip_distance);
   masm->BindBlock(&cont);
-
-  return;
 }
 
 /* Code generation for choice nodes.
@@ -5563,6 +5556,23 @@ RawRegExp* RegExpEngine::CreateRegExp(Thread* thread,
   regexp.set_is_complex();
   regexp.set_is_global();  // All dart regexps are global.
 
+  if (FLAG_linear_regexp) {
+    RegExpCompileData* compile_data = new (zone) RegExpCompileData();
+    // Parsing failures are handled in the RegExp factory constructor.
+    RegExpParser::ParseRegExp(pattern, flags, compile_data);
+    const TypedData& program = TypedData::Handle(
+        zone, LinearRegExp::Compile(compile_data->tree, flags,
+                                    compile_data->capture_count, zone));
+    if (!program.IsNull()) {
+      // Matched by LinearRegExp::Match, without specialized functions.
+      regexp.set_num_bracket_expressions(compile_data->capture_count);
+      regexp.set_capture_name_map(compile_data->capture_name_map);
+      regexp.set_bytecode(/*is_one_byte=*/true, /*sticky=*/false, program);
+      regexp.set_is_linear();
+      return regexp.raw();
+    }
+  }
+
   if (!FLAG_interpret_irregexp) {
     const Library& lib = Library::Handle(zone, Library::CoreLibrary());
     const Class& owner =
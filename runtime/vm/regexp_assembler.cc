@@ -4,6 +4,10 @@
 
 #include "vm/regexp_assembler.h"
 
+#if defined(HOST_ARCH_X64)
+#include <emmintrin.h>
+#endif
+
 #include "unicode/uchar.h"
 
 #include "platform/unicode.h"
@@ -96,6 +100,26 @@ DEFINE_RAW_LEAF_RUNTIME_ENTRY(
     false /* is_float */,
     reinterpret_cast<RuntimeFunction>(&CaseInsensitiveCompareUTF16));
 
+RawSmi* FindBitInTable(RawString* str_raw,
+                       RawSmi* start_raw,
+                       RawTypedData* table_raw,
+                       RawSmi* advance_by_raw) {
+  const String& str = String::Handle(str_raw);
+  const TypedData& table = TypedData::Handle(table_raw);
+  NoSafepointScope no_safepoint;
+  const intptr_t index = RegExpMacroAssembler::FindBitInTable(
+      str, Smi::Value(start_raw),
+      reinterpret_cast<const uint8_t*>(table.DataAddr(0)),
+      Smi::Value(advance_by_raw));
+  return Smi::New(index);
+}
+
+DEFINE_RAW_LEAF_RUNTIME_ENTRY(
+    FindBitInTable,
+    4,
+    false /* is_float */,
+    reinterpret_cast<RuntimeFunction>(&FindBitInTable));
+
 BlockLabel::BlockLabel()
     : block_(NULL), is_bound_(false), is_linked_(false), pos_(-1) {
 #if !defined(DART_PRECOMPILED_RUNTIME)
@@ -112,6 +136,134 @@ RegExpMacroAssembler::RegExpMacroAssembler(Zone* zone)
 
 RegExpMacroAssembler::~RegExpMacroAssembler() {}
 
+static bool IsBitSet(const uint8_t* table, uint16_t code_unit) {
+  const intptr_t c = code_unit & RegExpMacroAssembler::kTableMask;
+  return (table[c >> kBitsPerByteLog2] & (1 << (c & (kBitsPerByte - 1)))) != 0;
+}
+
+// Returns the first index in [start, end) that could hold a code unit that is
+// 'first' or 'second' modulus the table size, checking many code units at a
+// time. SSE2 is part of the x64 baseline, so this needs no CPU feature check.
+#if defined(HOST_ARCH_X64)
+static intptr_t SkipOtherCodeUnits(const uint8_t* chars,
+                                   intptr_t start,
+                                   intptr_t end,
+                                   uint16_t first,
+                                   uint16_t second) {
+  const __m128i mask = _mm_set1_epi8(RegExpMacroAssembler::kTableMask);
+  const __m128i first_needle = _mm_set1_epi8(static_cast<int8_t>(first));
+  const __m128i second_needle = _mm_set1_epi8(static_cast<int8_t>(second));
+  intptr_t i = start;
+  for (; i + 16 <= end; i += 16) {
+    const __m128i chunk = _mm_and_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&chars[i])), mask);
+    const uint32_t matches = _mm_movemask_epi8(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, first_needle),
+                     _mm_cmpeq_epi8(chunk, second_needle)));
+    if (matches != 0) {
+      return i + Utils::CountTrailingZeros32(matches);
+    }
+  }
+  return i;
+}
+
+static intptr_t SkipOtherCodeUnits(const uint16_t* chars,
+                                   intptr_t start,
+                                   intptr_t end,
+                                   uint16_t first,
+                                   uint16_t second) {
+  const __m128i mask = _mm_set1_epi16(RegExpMacroAssembler::kTableMask);
+  const __m128i first_needle = _mm_set1_epi16(static_cast<int16_t>(first));
+  const __m128i second_needle = _mm_set1_epi16(static_cast<int16_t>(second));
+  intptr_t i = start;
+  for (; i + 8 <= end; i += 8) {
+    const __m128i chunk = _mm_and_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&chars[i])), mask);
+    // Two bits, one per byte, for each code unit that matches.
+    const uint32_t matches = _mm_movemask_epi8(
+        _mm_or_si128(_mm_cmpeq_epi16(chunk, first_needle),
+                     _mm_cmpeq_epi16(chunk, second_needle)));
+    if (matches != 0) {
+      return i + Utils::CountTrailingZeros32(matches) / 2;
+    }
+  }
+  return i;
+}
+#else
+template <typename CharType>
+static intptr_t SkipOtherCodeUnits(const CharType* chars,
+                                   intptr_t start,
+                                   intptr_t end,
+                                   uint16_t first,
+                                   uint16_t second) {
+  return start;
+}
+#endif
+
+template <typename CharType>
+static intptr_t FindBitInTable(const CharType* chars,
+                               intptr_t length,
+                               intptr_t start,
+                               const uint8_t* table,
+                               intptr_t advance_by) {
+  // Tables of one or two characters are searched for at every index, and the
+  // index found is then rounded up to the next one the scan would look at.
+  intptr_t count = 0;
+  uint16_t characters[2] = {0, 0};
+  const intptr_t kTableBytes = RegExpMacroAssembler::kTableSize / kBitsPerByte;
+  for (intptr_t i = 0; i < kTableBytes; i++) {
+    for (uint32_t bits = table[i]; bits != 0; bits &= bits - 1) {
+      if (count < 2) {
+        characters[count] =
+            i * kBitsPerByte + Utils::CountTrailingZeros32(bits);
+      }
+      count++;
+    }
+  }
+  intptr_t index = start;
+  if ((count == 0) || (count > 2)) {
+    while ((index < length) && !IsBitSet(table, chars[index])) {
+      index += advance_by;
+    }
+    return index;
+  }
+  const uint16_t first = characters[0];
+  const uint16_t second = characters[count - 1];
+  while (index < length) {
+    intptr_t found = SkipOtherCodeUnits(chars, index, length, first, second);
+    while ((found < length) && !IsBitSet(table, chars[found])) {
+      found++;
+    }
+    index += ((found - index + advance_by - 1) / advance_by) * advance_by;
+    if (index == found) {
+      break;
+    }
+  }
+  return index;
+}
+
+intptr_t RegExpMacroAssembler::FindBitInTable(const String& subject,
+                                              intptr_t start,
+                                              const uint8_t* table,
+                                              intptr_t advance_by) {
+  ASSERT(advance_by > 0);
+  const intptr_t length = subject.Length();
+  NoSafepointScope no_safepoint;
+  if (subject.IsOneByteString()) {
+    return dart::FindBitInTable(OneByteString::DataStart(subject), length,
+                                start, table, advance_by);
+  } else if (subject.IsTwoByteString()) {
+    return dart::FindBitInTable(TwoByteString::DataStart(subject), length,
+                                start, table, advance_by);
+  } else if (subject.IsExternalOneByteString()) {
+    return dart::FindBitInTable(ExternalOneByteString::DataStart(subject),
+                                length, start, table, advance_by);
+  }
+  ASSERT(subject.IsExternalTwoByteString());
+  return dart::FindBitInTable(ExternalTwoByteString::DataStart(subject),
+                              length, start, table, advance_by);
+}
+
 void RegExpMacroAssembler::CheckNotInSurrogatePair(intptr_t cp_offset,
                                                    BlockLabel* on_failure) {
   BlockLabel ok;
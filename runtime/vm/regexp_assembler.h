@@ -27,6 +27,14 @@ RawBool* CaseInsensitiveCompareUTF16(RawString* str_raw,
                                      RawSmi* rhs_index_raw,
                                      RawSmi* length_raw);
 
+// Finds where RegExpMacroAssembler::SkipUntilBitInTable stops, see
+// RegExpMacroAssembler::FindBitInTable.
+// Called from generated RegExp code.
+RawSmi* FindBitInTable(RawString* str_raw,
+                       RawSmi* start_raw,
+                       RawTypedData* table_raw,
+                       RawSmi* advance_by_raw);
+
 /// Convenience wrapper around a BlockEntryInstr pointer.
 class BlockLabel : public ValueObject {
   // Used by the IR assembler.
@@ -168,6 +176,24 @@ class RegExpMacroAssembler : public ZoneAllocated {
   virtual void CheckBitInTable(const TypedData& table,
                                BlockLabel* on_bit_set) = 0;
 
+  // Advances the current position by 'advance_by' until the character at
+  // 'cp_offset' from it (modulus the kTableSize) is set in the byte array,
+  // or until that offset is at or after the end of input. Unlike a loop of
+  // CheckBitInTable, the subject is scanned natively, many characters at a
+  // time when the table holds at most two characters.
+  virtual void SkipUntilBitInTable(intptr_t cp_offset,
+                                   const TypedData& table,
+                                   intptr_t advance_by) = 0;
+
+  // Returns the first index at or after 'start', in steps of 'advance_by',
+  // of a code unit of 'subject' whose value (modulus the kTableSize) is set
+  // in the bitmap 'table', or the first such index at or after the end of
+  // 'subject' if there is none.
+  static intptr_t FindBitInTable(const String& subject,
+                                 intptr_t start,
+                                 const uint8_t* table,
+                                 intptr_t advance_by);
+
   // Checks for preemption and serves as an OSR entry.
   virtual void CheckPreemption(bool is_backtrack) {}
 
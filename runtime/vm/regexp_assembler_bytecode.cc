@@ -335,6 +335,24 @@ void BytecodeRegExpMacroAssembler::CheckBitInTable(const TypedData& table,
   }
 }
 
+void BytecodeRegExpMacroAssembler::SkipUntilBitInTable(
+    intptr_t cp_offset,
+    const TypedData& table,
+    intptr_t advance_by) {
+  ASSERT(cp_offset >= 0);
+  ASSERT(cp_offset <= kMaxCPOffset);
+  ASSERT(advance_by > 0);
+  Emit(BC_SKIP_UNTIL_BIT_IN_TABLE, cp_offset);
+  Emit32(advance_by);
+  for (int i = 0; i < kTableSize; i += kBitsPerByte) {
+    int byte = 0;
+    for (int j = 0; j < kBitsPerByte; j++) {
+      if (table.GetUint8(i + j) != 0) byte |= 1 << j;
+    }
+    Emit8(byte);
+  }
+}
+
 void BytecodeRegExpMacroAssembler::CheckNotBackReference(
     intptr_t start_reg,
     bool read_backward,
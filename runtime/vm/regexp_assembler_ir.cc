@@ -1230,6 +1230,49 @@ void IRRegExpMacroAssembler::CheckBitInTable(const TypedData& table,
   BranchOrBacktrack(Comparison(kNE, byte_def, zero_def), on_bit_set);
 }
 
+void IRRegExpMacroAssembler::SkipUntilBitInTable(intptr_t cp_offset,
+                                                 const TypedData& table,
+                                                 intptr_t advance_by) {
+  TAG();
+  ASSERT(cp_offset >= 0);
+  ASSERT(advance_by > 0);
+
+  // The runtime takes the table as a bitmap, as the bytecode does.
+  const TypedData& bits = TypedData::ZoneHandle(
+      Z, TypedData::New(kTypedDataUint8ArrayCid, kTableSize / kBitsPerByte,
+                        Heap::kOld));
+  for (intptr_t i = 0; i < kTableSize; i++) {
+    if (table.GetUint8(i) != 0) {
+      const intptr_t byte = i / kBitsPerByte;
+      bits.SetUint8(byte, bits.GetUint8(byte) | (1 << (i % kBitsPerByte)));
+    }
+  }
+
+  // Index of the first character looked at:
+  //    cp_offset + current_position_ + string_param_length_
+  PushArgumentInstr* off_push = PushArgument(Bind(Int64Constant(cp_offset)));
+  PushArgumentInstr* pos_push = PushLocal(current_position_);
+  PushArgumentInstr* off_pos_push = PushArgument(Bind(Add(off_push, pos_push)));
+  PushArgumentInstr* len_push = PushLocal(string_param_length_);
+  StoreLocal(index_temp_, Bind(Add(off_pos_push, len_push)));
+
+  Value* string_value = Bind(LoadLocal(string_param_));
+  Value* start_value = Bind(LoadLocal(index_temp_));
+  Value* table_value = Bind(new (Z) ConstantInstr(bits));
+  Value* advance_by_value = Bind(Int64Constant(advance_by));
+  StoreLocal(index_temp_,
+             Bind(new (Z) FindBitInTableInstr(string_value, start_value,
+                                              table_value, advance_by_value)));
+
+  // Move the current position so that cp_offset is at the index found.
+  PushArgumentInstr* index_push = PushLocal(index_temp_);
+  len_push = PushLocal(string_param_length_);
+  PushArgumentInstr* from_end_push =
+      PushArgument(Bind(Sub(index_push, len_push)));
+  off_push = PushArgument(Bind(Int64Constant(cp_offset)));
+  StoreLocal(current_position_, Bind(Sub(from_end_push, off_push)));
+}
+
 bool IRRegExpMacroAssembler::CheckSpecialCharacterClass(
     uint16_t type,
     BlockLabel* on_no_match) {
@@ -84,6 +84,9 @@ class IRRegExpMacroAssembler : public RegExpMacroAssembler {
                                         uint16_t to,
                                         BlockLabel* on_not_in_range);
   virtual void CheckBitInTable(const TypedData& table, BlockLabel* on_bit_set);
+  virtual void SkipUntilBitInTable(intptr_t cp_offset,
+                                   const TypedData& table,
+                                   intptr_t advance_by);
 
   // Checks whether the given offset from the current position is before
   // the end of the string.
@@ -67,7 +67,8 @@ V(CHECK_AT_START,    47, 8)   /* bc8 pad24 addr32                           */ \
 V(CHECK_NOT_AT_START, 48, 8)  /* bc8 offset24 addr32                        */ \
 V(CHECK_GREEDY,      49, 8)   /* bc8 pad24 addr32                           */ \
 V(ADVANCE_CP_AND_GOTO, 50, 8) /* bc8 offset24 addr32                        */ \
-V(SET_CURRENT_POSITION_FROM_END, 51, 4) /* bc8 idx24                        */
+V(SET_CURRENT_POSITION_FROM_END, 51, 4) /* bc8 idx24                        */ \
+V(SKIP_UNTIL_BIT_IN_TABLE, 52, 24) /* bc8 offset24 value32 bits128          */
 
 // clang-format on
 
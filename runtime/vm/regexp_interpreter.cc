@@ -616,6 +616,15 @@ static IrregexpInterpreter::IrregexpResult RawMatch(const uint8_t* code_base,
         pc += BC_SET_CURRENT_POSITION_FROM_END_LENGTH;
         break;
       }
+      BYTECODE(SKIP_UNTIL_BIT_IN_TABLE) {
+        const int32_t cp_offset = insn >> BYTECODE_SHIFT;
+        const intptr_t advance_by = Load32Aligned(pc + 4);
+        current = RegExpMacroAssembler::FindBitInTable(
+                      subject, current + cp_offset, pc + 8, advance_by) -
+                  cp_offset;
+        pc += BC_SKIP_UNTIL_BIT_IN_TABLE_LENGTH;
+        break;
+      }
       default:
         UNREACHABLE();
         break;
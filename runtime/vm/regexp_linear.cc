@@ -0,0 +1,590 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/regexp_linear.h"
+
+#include "vm/regexp_ast.h"
+
+namespace dart {
+
+// The instructions of a program, each followed by its operands. Jump targets
+// are indices into the program.
+enum LinearRegExpOpcode {
+  // Stop with a match.
+  kMatchOp,
+  // Consume the code unit <c>.
+  kCharOp,
+  // Consume any code unit.
+  kAnyOp,
+  // <count> <from> <to>...: Consume a code unit in one of the <count>
+  // inclusive ranges, which are sorted and do not overlap.
+  kClassOp,
+  // <target>: Continue at <target>.
+  kJumpOp,
+  // <first> <second>: Continue at both <first> and <second>, preferring
+  // matches found from <first>.
+  kSplitOp,
+  // <register>: Store the current position in <register>.
+  kSaveOp,
+  // <from> <to>: Reset the registers <from> to <to> to -1.
+  kClearOp,
+  // <type>: Continue if the RegExpAssertion::AssertionType <type> holds at
+  // the current position.
+  kAssertOp,
+};
+
+class LinearRegExpCompiler : public RegExpVisitor {
+ public:
+  explicit LinearRegExpCompiler(Zone* zone)
+      : zone_(zone), code_(zone, 64), failed_(false) {}
+
+  bool failed() const { return failed_; }
+  const GrowableArray<int32_t>& code() const { return code_; }
+
+  void CompileRegExp(RegExpTree* tree, intptr_t capture_count) {
+    Emit(kSaveOp);
+    Emit(RegExpCapture::StartRegister(0));
+    tree->Accept(this, NULL);
+    Emit(kSaveOp);
+    Emit(RegExpCapture::EndRegister(0));
+    Emit(kMatchOp);
+    const intptr_t register_count = (capture_count + 1) * 2;
+    if (code_.length() * register_count > LinearRegExp::kMaxThreadRegisters) {
+      failed_ = true;
+    }
+  }
+
+  void* VisitDisjunction(RegExpDisjunction* node, void* data) {
+    ZoneGrowableArray<RegExpTree*>* alternatives = node->alternatives();
+    const intptr_t count = alternatives->length();
+    GrowableArray<intptr_t> jumps(zone_, count);
+    for (intptr_t i = 0; i < count; i++) {
+      const bool is_last = (i == count - 1);
+      intptr_t split = pc();
+      if (!is_last) {
+        Emit(kSplitOp);
+        Emit(split + 3);
+        Emit(-1);
+      }
+      alternatives->At(i)->Accept(this, data);
+      if (!is_last) {
+        jumps.Add(pc());
+        Emit(kJumpOp);
+        Emit(-1);
+        Patch(split + 2, pc());
+      }
+    }
+    for (intptr_t i = 0; i < jumps.length(); i++) {
+      Patch(jumps[i] + 1, pc());
+    }
+    return NULL;
+  }
+
+  void* VisitAlternative(RegExpAlternative* node, void* data) {
+    ZoneGrowableArray<RegExpTree*>* nodes = node->nodes();
+    for (intptr_t i = 0; i < nodes->length() && !failed_; i++) {
+      nodes->At(i)->Accept(this, data);
+    }
+    return NULL;
+  }
+
+  void* VisitAssertion(RegExpAssertion* node, void* data) {
+    Emit(kAssertOp);
+    Emit(node->assertion_type());
+    return NULL;
+  }
+
+  void* VisitCharacterClass(RegExpCharacterClass* node, void* data) {
+    ZoneGrowableArray<CharacterRange>* ranges = node->ranges();
+    // Standard classes are the same when ignoring case, as in
+    // TextNode::MakeCaseIndependent.
+    if (node->flags().IgnoreCase() && !node->is_standard()) {
+      CharacterRange::AddCaseEquivalents(ranges, /*is_one_byte=*/false,
+                                         zone_);
+    }
+    CharacterRange::Canonicalize(ranges);
+    if (node->is_negated()) {
+      ZoneGrowableArray<CharacterRange>* negated =
+          new (zone_) ZoneGrowableArray<CharacterRange>(ranges->length() + 1);
+      CharacterRange::Negate(ranges, negated);
+      ranges = negated;
+    }
+    EmitRanges(ranges);
+    return NULL;
+  }
+
+  void* VisitAtom(RegExpAtom* node, void* data) {
+    ZoneGrowableArray<uint16_t>* chars = node->data();
+    for (intptr_t i = 0; i < chars->length(); i++) {
+      if (node->flags().IgnoreCase()) {
+        ZoneGrowableArray<CharacterRange>* ranges =
+            CharacterRange::List(zone_, CharacterRange::Singleton(chars->At(i)));
+        CharacterRange::AddCaseEquivalents(ranges, /*is_one_byte=*/false,
+                                           zone_);
+        CharacterRange::Canonicalize(ranges);
+        EmitRanges(ranges);
+      } else {
+        Emit(kCharOp);
+        Emit(chars->At(i));
+      }
+    }
+    return NULL;
+  }
+
+  void* VisitText(RegExpText* node, void* data) {
+    GrowableArray<TextElement>* elements = node->elements();
+    for (intptr_t i = 0; i < elements->length(); i++) {
+      const TextElement& element = elements->At(i);
+      if (element.text_type() == TextElement::ATOM) {
+        VisitAtom(element.atom(), data);
+      } else {
+        VisitCharacterClass(element.char_class(), data);
+      }
+    }
+    return NULL;
+  }
+
+  void* VisitQuantifier(RegExpQuantifier* node, void* data) {
+    RegExpTree* body = node->body();
+    if (body->min_match() == 0 || node->is_possessive()) {
+      failed_ = true;
+      return NULL;
+    }
+    const Interval captures = body->CaptureRegisters();
+    for (intptr_t i = 0; i < node->min() && !failed_; i++) {
+      EmitIteration(body, captures, data);
+    }
+    // The split prefers the body if the quantifier is greedy, or the exit if
+    // it is not.
+    const intptr_t exit_operand = node->is_greedy() ? 2 : 1;
+    const intptr_t body_operand = 3 - exit_operand;
+    if (node->max() == RegExpTree::kInfinity) {
+      const intptr_t loop = pc();
+      Emit(kSplitOp);
+      Emit(-1);
+      Emit(-1);
+      Patch(loop + body_operand, loop + 3);
+      EmitIteration(body, captures, data);
+      Emit(kJumpOp);
+      Emit(loop);
+      Patch(loop + exit_operand, pc());
+    } else {
+      GrowableArray<intptr_t> splits(zone_, 4);
+      for (intptr_t i = node->min(); i < node->max() && !failed_; i++) {
+        const intptr_t split = pc();
+        splits.Add(split);
+        Emit(kSplitOp);
+        Emit(-1);
+        Emit(-1);
+        Patch(split + body_operand, split + 3);
+        EmitIteration(body, captures, data);
+      }
+      for (intptr_t i = 0; i < splits.length(); i++) {
+        Patch(splits[i] + exit_operand, pc());
+      }
+    }
+    return NULL;
+  }
+
+  void* VisitCapture(RegExpCapture* node, void* data) {
+    Emit(kSaveOp);
+    Emit(RegExpCapture::StartRegister(node->index()));
+    node->body()->Accept(this, data);
+    Emit(kSaveOp);
+    Emit(RegExpCapture::EndRegister(node->index()));
+    return NULL;
+  }
+
+  void* VisitLookaround(RegExpLookaround* node, void* data) {
+    failed_ = true;
+    return NULL;
+  }
+
+  void* VisitBackReference(RegExpBackReference* node, void* data) {
+    failed_ = true;
+    return NULL;
+  }
+
+  void* VisitEmpty(RegExpEmpty* node, void* data) { return NULL; }
+
+ private:
+  intptr_t pc() const { return code_.length(); }
+
+  // Stops adding code once the program is too long. Compilation fails then,
+  // so the code does not need to be consistent.
+  void Emit(int32_t value) {
+    if (code_.length() >= LinearRegExp::kMaxProgramLength) {
+      failed_ = true;
+      return;
+    }
+    code_.Add(value);
+  }
+
+  void Patch(intptr_t index, int32_t target) {
+    if (index < code_.length()) {
+      code_[index] = target;
+    }
+  }
+
+  // Captures in the body of a quantifier are reset on every iteration, as
+  // in RegExpQuantifier::ToNode.
+  void EmitIteration(RegExpTree* body, const Interval& captures, void* data) {
+    if (!captures.is_empty()) {
+      Emit(kClearOp);
+      Emit(captures.from());
+      Emit(captures.to());
+    }
+    body->Accept(this, data);
+  }
+
+  void EmitRanges(ZoneGrowableArray<CharacterRange>* ranges) {
+    ASSERT(CharacterRange::IsCanonical(ranges));
+    if (ranges->length() == 1 && ranges->At(0).IsSingleton()) {
+      Emit(kCharOp);
+      Emit(ranges->At(0).from());
+    } else if (ranges->length() == 1 &&
+               ranges->At(0).IsEverything(Utf16::kMaxCodeUnit)) {
+      Emit(kAnyOp);
+    } else {
+      Emit(kClassOp);
+      Emit(ranges->length());
+      for (intptr_t i = 0; i < ranges->length(); i++) {
+        Emit(ranges->At(i).from());
+        Emit(ranges->At(i).to());
+      }
+    }
+  }
+
+  Zone* zone_;
+  GrowableArray<int32_t> code_;
+  bool failed_;
+
+  DISALLOW_COPY_AND_ASSIGN(LinearRegExpCompiler);
+};
+
+RawTypedData* LinearRegExp::Compile(RegExpTree* tree,
+                                    RegExpFlags flags,
+                                    intptr_t capture_count,
+                                    Zone* zone) {
+  // Unicode patterns match surrogate pairs as single characters.
+  if (flags.IsUnicode()) return TypedData::null();
+  LinearRegExpCompiler compiler(zone);
+  compiler.CompileRegExp(tree, capture_count);
+  if (compiler.failed()) return TypedData::null();
+
+  const GrowableArray<int32_t>& code = compiler.code();
+  const TypedData& program = TypedData::Handle(
+      zone, TypedData::New(kTypedDataInt32ArrayCid, code.length(), Heap::kOld));
+  for (intptr_t i = 0; i < code.length(); i++) {
+    program.SetInt32(i * sizeof(int32_t), code[i]);
+  }
+  return program.raw();
+}
+
+template <typename Char>
+class LinearRegExpMatcher : public ValueObject {
+ public:
+  LinearRegExpMatcher(const int32_t* program,
+                      intptr_t program_length,
+                      intptr_t register_count,
+                      Zone* zone)
+      : program_(program),
+        program_length_(program_length),
+        register_count_(register_count),
+        subject_(NULL),
+        subject_length_(0),
+        visited_(zone->Alloc<int32_t>(program_length)),
+        generation_(0),
+        start_registers_(zone->Alloc<int32_t>(register_count)),
+        match_registers_(zone->Alloc<int32_t>(register_count)),
+        stack_(zone, 16) {
+    for (intptr_t i = 0; i < program_length; i++) {
+      visited_[i] = 0;
+    }
+    for (intptr_t i = 0; i < register_count; i++) {
+      start_registers_[i] = -1;
+    }
+    for (intptr_t i = 0; i < 2; i++) {
+      lists_[i].count = 0;
+      lists_[i].pcs = zone->Alloc<int32_t>(program_length);
+      lists_[i].registers =
+          zone->Alloc<int32_t>(program_length * register_count);
+    }
+  }
+
+  // Returns whether a match was found. Its capture registers are then in
+  // match_registers().
+  bool Match(const Char* subject,
+             intptr_t subject_length,
+             intptr_t start,
+             bool sticky) {
+    subject_ = subject;
+    subject_length_ = subject_length;
+    ThreadList* current = &lists_[0];
+    ThreadList* next = &lists_[1];
+    bool matched = false;
+    generation_++;
+    for (intptr_t position = start;; position++) {
+      // A thread starting here has lower priority than threads that started
+      // earlier.
+      if (!matched && (!sticky || position == start)) {
+        AddThread(current, 0, start_registers_, position);
+      }
+      if (current->count == 0 && (matched || sticky)) break;
+
+      generation_++;
+      const intptr_t c =
+          (position < subject_length_) ? subject_[position] : -1;
+      for (intptr_t i = 0; i < current->count; i++) {
+        const int32_t pc = current->pcs[i];
+        int32_t* registers = &current->registers[i * register_count_];
+        const int32_t* instruction = &program_[pc];
+        int32_t next_pc = -1;
+        switch (instruction[0]) {
+          case kMatchOp:
+            memmove(match_registers_, registers,
+                    register_count_ * sizeof(int32_t));
+            matched = true;
+            break;
+          case kCharOp:
+            if (c == instruction[1]) next_pc = pc + 2;
+            break;
+          case kAnyOp:
+            if (c >= 0) next_pc = pc + 1;
+            break;
+          case kClassOp:
+            if (ClassContains(instruction, c)) {
+              next_pc = pc + 2 + 2 * instruction[1];
+            }
+            break;
+          default:
+            UNREACHABLE();
+        }
+        if (instruction[0] == kMatchOp) {
+          // Threads with lower priority cannot find a better match.
+          break;
+        }
+        if (next_pc >= 0) {
+          AddThread(next, next_pc, registers, position + 1);
+        }
+      }
+      if (position >= subject_length_) break;
+
+      ThreadList* temp = current;
+      current = next;
+      next = temp;
+      next->count = 0;
+    }
+    return matched;
+  }
+
+  const int32_t* match_registers() const { return match_registers_; }
+
+ private:
+  struct ThreadList {
+    intptr_t count;
+    // The instruction each thread waits at, and its registers.
+    int32_t* pcs;
+    int32_t* registers;
+  };
+
+  // Pending work in AddThread: either an instruction to visit, or a register
+  // to restore once the instructions after a kSaveOp or kClearOp have been
+  // visited.
+  struct Job {
+    int32_t pc;
+    int32_t reg;
+    int32_t value;
+  };
+
+  // Adds threads for the instructions that consume input, or match, reached
+  // from [pc] without consuming input. [registers] are updated while
+  // following the path to an instruction and restored afterwards.
+  void AddThread(ThreadList* list,
+                 int32_t pc,
+                 int32_t* registers,
+                 intptr_t position) {
+    ASSERT(stack_.is_empty());
+    PushVisit(pc);
+    while (!stack_.is_empty()) {
+      const Job job = stack_.RemoveLast();
+      if (job.pc < 0) {
+        registers[job.reg] = job.value;
+        continue;
+      }
+      pc = job.pc;
+      ASSERT(pc < program_length_);
+      // A thread that reaches an instruction first has priority over the
+      // threads that reach it later at the same position.
+      if (visited_[pc] == generation_) continue;
+      visited_[pc] = generation_;
+      const int32_t* instruction = &program_[pc];
+      switch (instruction[0]) {
+        case kJumpOp:
+          PushVisit(instruction[1]);
+          break;
+        case kSplitOp:
+          PushVisit(instruction[2]);
+          PushVisit(instruction[1]);
+          break;
+        case kSaveOp:
+          PushRestore(instruction[1], registers[instruction[1]]);
+          registers[instruction[1]] = position;
+          PushVisit(pc + 2);
+          break;
+        case kClearOp:
+          for (int32_t reg = instruction[1]; reg <= instruction[2]; reg++) {
+            PushRestore(reg, registers[reg]);
+            registers[reg] = -1;
+          }
+          PushVisit(pc + 3);
+          break;
+        case kAssertOp:
+          if (AssertionHolds(instruction[1], position)) {
+            PushVisit(pc + 2);
+          }
+          break;
+        default:
+          list->pcs[list->count] = pc;
+          memmove(&list->registers[list->count * register_count_], registers,
+                  register_count_ * sizeof(int32_t));
+          list->count++;
+          break;
+      }
+    }
+  }
+
+  void PushVisit(int32_t pc) {
+    Job job = {pc, -1, 0};
+    stack_.Add(job);
+  }
+
+  void PushRestore(int32_t reg, int32_t value) {
+    Job job = {-1, reg, value};
+    stack_.Add(job);
+  }
+
+  static bool ClassContains(const int32_t* instruction, intptr_t c) {
+    const int32_t* ranges = &instruction[2];
+    for (intptr_t i = 0; i < instruction[1]; i++) {
+      if (c < ranges[2 * i]) return false;
+      if (c <= ranges[2 * i + 1]) return true;
+    }
+    return false;
+  }
+
+  static bool IsLineTerminator(intptr_t c) {
+    return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+  }
+
+  bool IsWordAt(intptr_t position) const {
+    if (position < 0 || position >= subject_length_) return false;
+    const intptr_t c = subject_[position];
+    return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') ||
+           ('0' <= c && c <= '9') || c == '_';
+  }
+
+  bool AssertionHolds(int32_t type, intptr_t position) const {
+    switch (type) {
+      case RegExpAssertion::START_OF_INPUT:
+        return position == 0;
+      case RegExpAssertion::START_OF_LINE:
+        return position == 0 || IsLineTerminator(subject_[position - 1]);
+      case RegExpAssertion::END_OF_INPUT:
+        return position == subject_length_;
+      case RegExpAssertion::END_OF_LINE:
+        return position == subject_length_ ||
+               IsLineTerminator(subject_[position]);
+      case RegExpAssertion::BOUNDARY:
+        return IsWordAt(position - 1) != IsWordAt(position);
+      case RegExpAssertion::NON_BOUNDARY:
+        return IsWordAt(position - 1) == IsWordAt(position);
+    }
+    UNREACHABLE();
+    return false;
+  }
+
+  const int32_t* program_;
+  const intptr_t program_length_;
+  const intptr_t register_count_;
+  const Char* subject_;
+  intptr_t subject_length_;
+  // The generation in which each instruction was last reached. A generation
+  // covers the threads added for one position.
+  int32_t* visited_;
+  int32_t generation_;
+  ThreadList lists_[2];
+  int32_t* start_registers_;
+  int32_t* match_registers_;
+  GrowableArray<Job> stack_;
+
+  DISALLOW_COPY_AND_ASSIGN(LinearRegExpMatcher);
+};
+
+template <typename Char>
+static bool MatchRaw(const TypedData& program,
+                     intptr_t register_count,
+                     const Char* subject,
+                     intptr_t subject_length,
+                     intptr_t start,
+                     bool sticky,
+                     int32_t* output,
+                     Zone* zone) {
+  LinearRegExpMatcher<Char> matcher(
+      reinterpret_cast<const int32_t*>(program.DataAddr(0)), program.Length(),
+      register_count, zone);
+  if (!matcher.Match(subject, subject_length, start, sticky)) return false;
+  memmove(output, matcher.match_registers(), register_count * sizeof(int32_t));
+  return true;
+}
+
+RawInstance* LinearRegExp::Match(const RegExp& regexp,
+                                 const String& subject,
+                                 const Smi& start_index,
+                                 bool sticky,
+                                 Zone* zone) {
+  ASSERT(regexp.is_linear());
+  const TypedData& program = TypedData::Handle(
+      zone, regexp.bytecode(/*is_one_byte=*/true, /*sticky=*/false));
+  ASSERT(!program.IsNull());
+  const intptr_t register_count =
+      (Smi::Value(regexp.num_bracket_expressions()) + 1) * 2;
+  int32_t* output = zone->Alloc<int32_t>(register_count);
+  const intptr_t length = subject.Length();
+  const intptr_t start = start_index.Value();
+
+  bool matched;
+  {
+    NoSafepointScope no_safepoint;
+    if (subject.IsOneByteString()) {
+      matched = MatchRaw(program, register_count,
+                         OneByteString::DataStart(subject), length, start,
+                         sticky, output, zone);
+    } else if (subject.IsTwoByteString()) {
+      matched = MatchRaw(program, register_count,
+                         TwoByteString::DataStart(subject), length, start,
+                         sticky, output, zone);
+    } else if (subject.IsExternalOneByteString()) {
+      matched = MatchRaw(program, register_count,
+                         ExternalOneByteString::DataStart(subject), length,
+                         start, sticky, output, zone);
+    } else {
+      ASSERT(subject.IsExternalTwoByteString());
+      matched = MatchRaw(program, register_count,
+                         ExternalTwoByteString::DataStart(subject), length,
+                         start, sticky, output, zone);
+    }
+  }
+  if (!matched) return Instance::null();
+
+  const TypedData& result = TypedData::Handle(
+      zone, TypedData::New(kTypedDataInt32ArrayCid, register_count));
+  {
+    NoSafepointScope no_safepoint;
+    memmove(result.DataAddr(0), output, register_count * sizeof(int32_t));
+  }
+  return result.raw();
+}
+
+}  // namespace dart
@@ -0,0 +1,55 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// A matcher for regular expressions without back references or lookarounds
+// that takes time linear in the length of the subject.
+
+#ifndef RUNTIME_VM_REGEXP_LINEAR_H_
+#define RUNTIME_VM_REGEXP_LINEAR_H_
+
+#include "vm/allocation.h"
+#include "vm/object.h"
+#include "vm/regexp.h"
+#include "vm/zone.h"
+
+namespace dart {
+
+class RegExpTree;
+
+// The pattern is compiled to a program for a Pike VM, which follows every
+// path through the pattern in lock step, one subject position at a time, and
+// keeps at most one thread per instruction. Threads are kept in the order a
+// backtracking matcher would try them, so the match and captures found are
+// the ones irregexp would find.
+//
+// Patterns are only compiled if every quantified expression consumes input,
+// because the ECMAScript rules for empty iterations depend on more than the
+// current instruction and position.
+class LinearRegExp : public AllStatic {
+ public:
+  // Longest program, and most capture registers over all threads, before a
+  // pattern is left to irregexp. These bound the memory used by a match.
+  static const intptr_t kMaxProgramLength = 16 * KB;
+  static const intptr_t kMaxThreadRegisters = 256 * KB;
+
+  // Returns the program for [tree], or null if the pattern cannot be matched
+  // by this engine.
+  static RawTypedData* Compile(RegExpTree* tree,
+                               RegExpFlags flags,
+                               intptr_t capture_count,
+                               Zone* zone);
+
+  // Returns the capture registers of the first match of [regexp] in
+  // [subject] starting at [start_index] or, unless [sticky], after it. Returns
+  // null if there is no match.
+  static RawInstance* Match(const RegExp& regexp,
+                            const String& subject,
+                            const Smi& start_index,
+                            bool sticky,
+                            Zone* zone);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_REGEXP_LINEAR_H_
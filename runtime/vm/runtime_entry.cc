@@ -458,7 +458,8 @@ DEFINE_RUNTIME_ENTRY(SubtypeCheck, 5) {
 // Return value: newly allocated SubtypeTestCache.
 DEFINE_RUNTIME_ENTRY(AllocateSubtypeTestCache, 0) {
   ASSERT(FLAG_enable_interpreter);
-  arguments.SetReturn(SubtypeTestCache::Handle(zone, SubtypeTestCache::New()));
+  arguments.SetReturn(SubtypeTestCache::Handle(
+      zone, SubtypeTestCache::New(SubtypeTestCache::kMaxInputs)));
 }
 
 // Allocate a new context large enough to hold the given number of variables.
@@ -658,37 +659,16 @@ static void UpdateTypeTestCache(
          instance_parent_function_type_arguments.IsCanonical());
   ASSERT(instance_delayed_type_arguments.IsNull() ||
          instance_delayed_type_arguments.IsCanonical());
-  auto& last_instance_class_id_or_function = Object::Handle(zone);
-  auto& last_instance_type_arguments = TypeArguments::Handle(zone);
-  auto& last_instantiator_type_arguments = TypeArguments::Handle(zone);
-  auto& last_function_type_arguments = TypeArguments::Handle(zone);
-  auto& last_instance_parent_function_type_arguments =
-      TypeArguments::Handle(zone);
-  auto& last_instance_delayed_type_arguments = TypeArguments::Handle(zone);
-  Bool& last_result = Bool::Handle(zone);
-  for (intptr_t i = 0; i < len; ++i) {
-    new_cache.GetCheck(
-        i, &last_instance_class_id_or_function, &last_instance_type_arguments,
-        &last_instantiator_type_arguments, &last_function_type_arguments,
-        &last_instance_parent_function_type_arguments,
-        &last_instance_delayed_type_arguments, &last_result);
-    if ((last_instance_class_id_or_function.raw() ==
-         instance_class_id_or_function.raw()) &&
-        (last_instance_type_arguments.raw() == instance_type_arguments.raw()) &&
-        (last_instantiator_type_arguments.raw() ==
-         instantiator_type_arguments.raw()) &&
-        (last_function_type_arguments.raw() == function_type_arguments.raw()) &&
-        (last_instance_parent_function_type_arguments.raw() ==
-         instance_parent_function_type_arguments.raw()) &&
-        (last_instance_delayed_type_arguments.raw() ==
-         instance_delayed_type_arguments.raw())) {
-      OS::PrintErr("  Error in test cache %p ix: %" Pd ",", new_cache.raw(), i);
-      PrintTypeCheck(" duplicate cache entry", instance, type,
-                     instantiator_type_arguments, function_type_arguments,
-                     result);
-      UNREACHABLE();
-      return;
-    }
+  if (new_cache.HasCheck(instance_class_id_or_function, instance_type_arguments,
+                         instantiator_type_arguments, function_type_arguments,
+                         instance_parent_function_type_arguments,
+                         instance_delayed_type_arguments)) {
+    OS::PrintErr("  Error in test cache %p,", new_cache.raw());
+    PrintTypeCheck(" duplicate cache entry", instance, type,
+                   instantiator_type_arguments, function_type_arguments,
+                   result);
+    UNREACHABLE();
+    return;
   }
 #endif
   new_cache.AddCheck(instance_class_id_or_function, instance_type_arguments,
@@ -902,7 +882,9 @@ DEFINE_RUNTIME_ENTRY(TypeCheck, 7) {
 
       // The pool entry must be initialized to `null` when we patch it.
       ASSERT(pool.ObjectAt(stc_pool_idx) == Object::null());
-      cache = SubtypeTestCache::New();
+      // The cache is probed by the Subtype2TestCache and Subtype6TestCache
+      // stubs, which both compare the instance type arguments.
+      cache = SubtypeTestCache::New(SubtypeTestCache::kMaxInputs);
       pool.SetObjectAt(stc_pool_idx, cache);
 #else
       UNREACHABLE();
@@ -85,6 +85,7 @@ namespace dart {
     RawSmi*)                                                                   \
   V(RawBool*, CaseInsensitiveCompareUTF16, RawString*, RawSmi*, RawSmi*,       \
     RawSmi*)                                                                   \
+  V(RawSmi*, FindBitInTable, RawString*, RawSmi*, RawTypedData*, RawSmi*)      \
   V(void, EnterSafepoint)                                                      \
   V(void, ExitSafepoint)                                                       \
 
@@ -775,6 +775,97 @@ VM_UNIT_TEST_CASE(FullSnapshot) {
   free(isolate_snapshot_data_buffer);
 }
 
+// Full snapshots of the core libraries are large enough to be filled by
+// helper tasks, and the kernel data of each library is external typed data,
+// whose payload is aligned within the snapshot. They have dozens of clusters,
+// so most fill sections start well past the first bytes of the fill data and
+// are found through the offset table. The script adds objects of more kinds,
+// whose values are checked after reading the snapshot.
+VM_UNIT_TEST_CASE(FullSnapshotFilledConcurrently) {
+  const char* kScriptChars =
+      "class Point {\n"
+      "  final x, y;\n"
+      "  const Point(this.x, this.y);\n"
+      "}\n"
+      "const values = const [\n"
+      "  1.5, 0x7fffffffffff, 'snapshot', const Point(3, 4),\n"
+      "  const {'a': 1}, const <int>[5, 6], #symbol,\n"
+      "];\n"
+      "int fib(int n) => n < 2 ? n : fib(n - 1) + fib(n - 2);\n"
+      "String describe() => 'fib(20) = ${fib(20)}, $values';\n";
+  SetFlagScope<int> sfs(&FLAG_snapshot_fill_tasks, 4);
+  uint8_t* isolate_snapshot_data_buffer;
+  uint8_t* kernel_bytes;
+  intptr_t kernel_length;
+
+  {
+    TestIsolateScope __test_isolate__;
+    TestCase::LoadTestScript(kScriptChars, NULL);
+
+    Thread* thread = Thread::Current();
+    TransitionNativeToVM transition(thread);
+    StackZone zone(thread);
+    HandleScope scope(thread);
+
+    Dart_Handle result = Api::CheckAndFinalizePendingClasses(thread);
+    {
+      TransitionVMToNative to_native(thread);
+      EXPECT_VALID(result);
+    }
+    const Library& lib = Library::Handle(
+        Library::RawCast(Api::UnwrapHandle(TestCase::lib())));
+    const ExternalTypedData& kernel_data =
+        ExternalTypedData::Handle(lib.kernel_data());
+    EXPECT(!kernel_data.IsNull());
+    kernel_length = kernel_data.LengthInBytes();
+    kernel_bytes = reinterpret_cast<uint8_t*>(malloc(kernel_length));
+    memmove(kernel_bytes, kernel_data.DataAddr(0), kernel_length);
+
+    FullSnapshotWriter writer(Snapshot::kFull, NULL,
+                              &isolate_snapshot_data_buffer, &malloc_allocator,
+                              NULL, /*image_writer*/ nullptr);
+    writer.WriteFullSnapshot();
+    // Well above the size from which helper tasks fill clusters.
+    EXPECT(writer.IsolateSnapshotSize() > MB);
+  }
+
+  TestCase::CreateTestIsolateFromSnapshot(isolate_snapshot_data_buffer);
+  {
+    Dart_EnterScope();
+    {
+      Thread* thread = Thread::Current();
+      TransitionNativeToVM transition(thread);
+      StackZone zone(thread);
+      HandleScope scope(thread);
+      const Library& lib = Library::Handle(
+          Library::RawCast(Api::UnwrapHandle(TestCase::lib())));
+      const ExternalTypedData& kernel_data =
+          ExternalTypedData::Handle(lib.kernel_data());
+      EXPECT_EQ(kernel_length, kernel_data.LengthInBytes());
+      EXPECT(Utils::IsAligned(
+          reinterpret_cast<uword>(kernel_data.DataAddr(0)),
+          ExternalTypedData::kDataSerializationAlignment));
+      EXPECT_EQ(0, memcmp(kernel_bytes, kernel_data.DataAddr(0),
+                          kernel_length));
+    }
+
+    // The function bodies are compiled from the kernel data.
+    Dart_Handle result =
+        Dart_Invoke(TestCase::lib(), NewString("describe"), 0, NULL);
+    EXPECT_VALID(result);
+    const char* description;
+    EXPECT_VALID(Dart_StringToCString(result, &description));
+    EXPECT_STREQ(
+        "fib(20) = 6765, [1.5, 140737488355327, snapshot, "
+        "Instance of 'Point', {a: 1}, [5, 6], Symbol(\"symbol\")]",
+        description);
+    Dart_ExitScope();
+  }
+  Dart_ShutdownIsolate();
+  free(kernel_bytes);
+  free(isolate_snapshot_data_buffer);
+}
+
 // Helper function to call a top level Dart function and serialize the result.
 static std::unique_ptr<Message> GetSerialized(Dart_Handle lib,
                                               const char* dart_function) {
@@ -99,9 +99,11 @@ DEFINE_FLAG(charp,
 //
 
 static TimelineEventRecorder* CreateTimelineRecorder() {
-  // Some flags require that we use the endless recorder.
+  // Some flags require that we use the endless recorder. A startup timeline
+  // written to a directory keeps its bounded recorder.
   const bool use_endless_recorder =
-      (FLAG_timeline_dir != NULL) || FLAG_timing || FLAG_complete_timeline;
+      ((FLAG_timeline_dir != NULL) && !FLAG_startup_timeline) || FLAG_timing ||
+      FLAG_complete_timeline;
 
   const bool use_startup_recorder = FLAG_startup_timeline;
   const bool use_systrace_recorder = FLAG_systrace_timeline;
@@ -1069,28 +1071,31 @@ void TimelineEventRecorder::ThreadBlockCompleteEvent(TimelineEvent* event) {
 
 #ifndef PRODUCT
 void TimelineEventRecorder::WriteTo(const char* directory) {
+  intptr_t pid = OS::ProcessId();
+  char* filename =
+      OS::SCreate(NULL, "%s/dart-timeline-%" Pd ".json", directory, pid);
+  WriteToFile(filename);
+  free(filename);
+}
+
+bool TimelineEventRecorder::WriteToFile(const char* path) {
   if (!FLAG_support_service) {
-    return;
+    return false;
   }
   Dart_FileOpenCallback file_open = Dart::file_open_callback();
   Dart_FileWriteCallback file_write = Dart::file_write_callback();
   Dart_FileCloseCallback file_close = Dart::file_close_callback();
   if ((file_open == NULL) || (file_write == NULL) || (file_close == NULL)) {
-    return;
+    return false;
   }
 
   Timeline::ReclaimCachedBlocksFromThreads();
 
-  intptr_t pid = OS::ProcessId();
-  char* filename =
-      OS::SCreate(NULL, "%s/dart-timeline-%" Pd ".json", directory, pid);
-  void* file = (*file_open)(filename, true);
+  void* file = (*file_open)(path, true);
   if (file == NULL) {
-    OS::PrintErr("Failed to write timeline file: %s\n", filename);
-    free(filename);
-    return;
+    OS::PrintErr("Failed to write timeline file: %s\n", path);
+    return false;
   }
-  free(filename);
 
   JSONStream js;
   TimelineEventFilter filter;
@@ -1104,7 +1109,7 @@ void TimelineEventRecorder::WriteTo(const char* directory) {
   free(output);
   (*file_close)(file);
 
-  return;
+  return true;
 }
 #endif
 
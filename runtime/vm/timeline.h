@@ -719,6 +719,12 @@ class TimelineEventRecorder {
 
   void FinishBlock(TimelineEventBlock* block);
 
+#ifndef PRODUCT
+  // Writes the recorded events to [path] in the trace event format. Returns
+  // false if the file could not be written.
+  bool WriteToFile(const char* path);
+#endif
+
  protected:
 #ifndef PRODUCT
   void WriteTo(const char* directory);
@@ -68,50 +68,40 @@ intptr_t Utf8::Length(const String& str) {
 }
 
 intptr_t Utf8::Encode(const String& src, char* dst, intptr_t len) {
-  uintptr_t array_len = len;
   intptr_t pos = 0;
-  ASSERT(static_cast<intptr_t>(array_len) >= Length(src));
+  ASSERT(len >= Length(src));
   if (src.IsOneByteString() || src.IsExternalOneByteString()) {
     // For 1-byte strings, all code points < 0x80 have single-byte UTF-8
     // encodings and all >= 0x80 have two-byte encodings.
-    const uintptr_t* data;
+    const uint8_t* data;
     NoSafepointScope scope;
     if (src.IsOneByteString()) {
-      data = reinterpret_cast<const uintptr_t*>(OneByteString::DataStart(src));
+      data = OneByteString::DataStart(src);
     } else {
-      data = reinterpret_cast<const uintptr_t*>(
-          ExternalOneByteString::DataStart(src));
+      data = ExternalOneByteString::DataStart(src);
     }
-    uintptr_t char_length = src.Length();
-    uintptr_t pos = 0;
+    intptr_t char_length = src.Length();
     ASSERT(kMaxOneByteChar + 1 == 0x80);
-    for (uintptr_t i = 0; i < char_length; i += sizeof(uintptr_t)) {
-      // Read the input one word at a time and just write it verbatim if it is
-      // plain ASCII, as determined by the mask.
-      if (i + sizeof(uintptr_t) <= char_length &&
-          (*data & kAsciiWordMask) == 0 &&
-          pos + sizeof(uintptr_t) <= array_len) {
-        StoreUnaligned(reinterpret_cast<uintptr_t*>(dst + pos), *data);
-        pos += sizeof(uintptr_t);
-      } else {
-        // Process up to one word of input that contains non-ASCII Latin1
-        // characters.
-        const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
-        const uint8_t* limit =
-            Utils::Minimum(p + sizeof(uintptr_t), p + (char_length - i));
-        for (; p < limit; p++) {
-          uint8_t c = *p;
-          // These calls to Length and Encode get inlined and the cases for 3
-          // and 4 byte sequences are removed.
-          intptr_t bytes = Length(c);
-          if (pos + bytes > array_len) {
-            return pos;
-          }
-          Encode(c, reinterpret_cast<char*>(dst) + pos);
-          pos += bytes;
-        }
+    intptr_t i = 0;
+    while (i < char_length) {
+      // Runs of ASCII are copied verbatim.
+      intptr_t ascii_len = Utils::Minimum(
+          Utf8::AsciiPrefixLength(&data[i], char_length - i), len - pos);
+      memmove(&dst[pos], &data[i], ascii_len);
+      pos += ascii_len;
+      i += ascii_len;
+      if (i == char_length) {
+        break;
+      }
+      uint8_t c = data[i++];
+      // These calls to Length and Encode get inlined and the cases for 3
+      // and 4 byte sequences are removed.
+      intptr_t bytes = Length(c);
+      if (pos + bytes > len) {
+        return pos;
       }
-      data++;
+      Encode(c, &dst[pos]);
+      pos += bytes;
     }
   } else {
     // For two-byte strings, which can contain 3 and 4-byte UTF-8 encodings,
@@ -1090,4 +1090,58 @@ ISOLATE_UNIT_TEST_CASE(Utf8Decode) {
   }
 }
 
+ISOLATE_UNIT_TEST_CASE(Utf8AsciiPrefixLength) {
+  // Long enough to cover the vector, word and byte loops.
+  const intptr_t kLength = 100;
+  uint8_t array[kLength];
+  memset(array, 'a', kLength);
+  EXPECT_EQ(kLength, Utf8::AsciiPrefixLength(array, kLength));
+  EXPECT_EQ(0, Utf8::AsciiPrefixLength(array, 0));
+  for (intptr_t i = 0; i < kLength; i++) {
+    array[i] = 0x80;
+    EXPECT_EQ(i, Utf8::AsciiPrefixLength(array, kLength));
+    array[i] = 0xFF;
+    EXPECT_EQ(i, Utf8::AsciiPrefixLength(array, kLength));
+    array[i] = 0x7F;
+    EXPECT_EQ(kLength, Utf8::AsciiPrefixLength(array, kLength));
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(Utf8DecodeMostlyAscii) {
+  // "é" (c3 a9) and "𝄞" (f0 9d 84 9e) at either end of a run of ASCII that
+  // is longer than a vector.
+  const char* src =
+      "\xC3\xA9"
+      "0123456789abcdefghijklmnopqrstuvwxyz"
+      "\xF0\x9D\x84\x9E";
+  const uint8_t* array = reinterpret_cast<const uint8_t*>(src);
+  const intptr_t array_len = strlen(src);
+  EXPECT(Utf8::IsValid(array, array_len));
+  Utf8::Type type;
+  const intptr_t len = Utf8::CodeUnitCount(array, array_len, &type);
+  EXPECT_EQ(Utf8::kSupplementary, type);
+  EXPECT_EQ(1 + 36 + 2, len);
+  uint16_t dst[1 + 36 + 2];
+  EXPECT(Utf8::DecodeToUTF16(array, array_len, dst, len));
+  EXPECT_EQ(0xE9, dst[0]);
+  for (intptr_t i = 0; i < 36; i++) {
+    EXPECT_EQ(src[2 + i], dst[1 + i]);
+  }
+  EXPECT_EQ(0xD834, dst[37]);
+  EXPECT_EQ(0xDD1E, dst[38]);
+  // The output is too short for the whole run of ASCII.
+  EXPECT(!Utf8::DecodeToUTF16(array, array_len, dst, 20));
+
+  uint8_t latin1[1 + 36];
+  EXPECT(Utf8::DecodeToLatin1(array, array_len - 4, latin1, 1 + 36));
+  EXPECT_EQ(0xE9, latin1[0]);
+  EXPECT(!memcmp(&src[2], &latin1[1], 36));
+  EXPECT(!Utf8::DecodeToLatin1(array, array_len - 4, latin1, 20));
+
+  // Invalid after a run of ASCII.
+  const char* invalid = "0123456789abcdefghijklmnopqrstuvwxyz\xC3";
+  EXPECT(!Utf8::IsValid(reinterpret_cast<const uint8_t*>(invalid),
+                        strlen(invalid)));
+}
+
 }  // namespace dart
@@ -390,6 +390,22 @@ class _JsonDecoderSink extends _StringSinkConversionSink {
   }
 }
 
+@patch
+class JsonEncoder {
+  @patch
+  static String _convertIntercepted(Object object, toEncodable(o)) {
+    return null; // This call was not intercepted.
+  }
+}
+
+@patch
+class JsonUtf8Encoder {
+  @patch
+  static List<int> _convertIntercepted(Object object, toEncodable(o)) {
+    return null; // This call was not intercepted.
+  }
+}
+
 @patch
 class Utf8Decoder {
   @patch
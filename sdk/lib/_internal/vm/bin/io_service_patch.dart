@@ -51,8 +51,80 @@ class _IOService {
   static HashMap<int, Completer> _messageMap = new HashMap<int, Completer>();
   static int _id = 0;
 
+  // Requests that only do a short, non-blocking system call are not sent to
+  // the IO service one by one. Instead, the ones issued in the same
+  // microtask are collected and sent as batches of up to [maxBatchSize]
+  // requests, which the IO service processes back to back on one thread.
+  // Requests that may block, like reads, opens, locks, lookups and directory
+  // listings, are always sent on their own so they cannot hold up others.
+  static const int maxBatchSize = 64;
+  static List _batch;
+  static List<Completer> _batchCompleters;
+
+  static bool _isBatchable(int request) {
+    switch (request) {
+      case _IOService.fileExists:
+      case _IOService.fileResolveSymbolicLinks:
+      case _IOService.filePosition:
+      case _IOService.fileSetPosition:
+      case _IOService.fileLength:
+      case _IOService.fileLengthFromPath:
+      case _IOService.fileLastAccessed:
+      case _IOService.fileLastModified:
+      case _IOService.fileLinkTarget:
+      case _IOService.fileType:
+      case _IOService.fileIdentical:
+      case _IOService.fileStat:
+      case _IOService.directoryExists:
+        return true;
+      default:
+        return false;
+    }
+  }
+
   @patch
   static Future _dispatch(int request, List data) {
+    if (!_isBatchable(request)) return _dispatchOne(request, data);
+    if (_batch == null) {
+      _batch = [];
+      _batchCompleters = <Completer>[];
+      // The batch is shared by every zone, so do not let the zone of its
+      // first request delay or drop the flush.
+      Zone.root.scheduleMicrotask(_flushBatch);
+    }
+    final Completer completer = new Completer();
+    _batch..add(request)..add(data);
+    _batchCompleters.add(completer);
+    if (_batchCompleters.length == maxBatchSize) _flushBatch();
+    return completer.future;
+  }
+
+  static void _flushBatch() {
+    if (_batch == null) return;
+    final List batch = _batch;
+    final List<Completer> completers = _batchCompleters;
+    _batch = null;
+    _batchCompleters = null;
+    if (completers.length == 1) {
+      completers[0].complete(_dispatchOne(batch[0], batch[1]));
+      return;
+    }
+    _dispatchOne(_IOService.batch, batch).then((responses) {
+      if (responses is List) {
+        assert(responses.length == completers.length);
+        for (int i = 0; i < completers.length; i++) {
+          completers[i].complete(responses[i]);
+        }
+      } else {
+        // The batch as a whole failed, e.g. because it could not be sent.
+        for (final Completer completer in completers) {
+          completer.complete(responses);
+        }
+      }
+    });
+  }
+
+  static Future _dispatchOne(int request, List data) {
     int id;
     do {
       id = _getNextId();
@@ -732,6 +732,25 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     return result;
   }
 
+  int readInto(List<int> buffer, int start, int end) {
+    if (isClosing || isClosed) return 0;
+    int len = min(available, end - start);
+    if (len <= 0) return 0;
+    var result = nativeReadInto(buffer, start, start + len);
+    if (result is OSError) {
+      reportError(result, StackTrace.current, "Read failed");
+      return 0;
+    }
+    available -= result;
+    // TODO(ricow): Remove when we track internal and pipe uses.
+    assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
+    if (resourceInfo != null) {
+      resourceInfo.totalRead += result;
+      resourceInfo.didRead();
+    }
+    return result;
+  }
+
   Datagram receive() {
     if (isClosing || isClosed) return null;
     var result = nativeRecvFrom();
@@ -804,6 +823,32 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     return result;
   }
 
+  int sendFile(_RandomAccessFile file, int offset, int count) {
+    if (isClosing || isClosed) return 0;
+    if (count == 0) return 0;
+    var result = nativeSendFile(file._pointer(), offset, count);
+    if (result is OSError) {
+      OSError osError = result;
+      StackTrace st = StackTrace.current;
+      scheduleMicrotask(() => reportError(osError, st, "Write failed"));
+      result = 0;
+    }
+    if (result < 0) {
+      // The file ended before [count] bytes. The socket can still take more,
+      // so no write event would tell the caller to try again.
+      result = -result - 1;
+      if (result == 0) throw _sendFileEndOfFile(file, offset);
+    } else if (result < count) {
+      writeAvailable = false;
+    }
+    // TODO(ricow): Remove when we track internal and pipe uses.
+    assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
+    if (resourceInfo != null) {
+      resourceInfo.addWrite(result);
+    }
+    return result;
+  }
+
   int send(List<int> buffer, int offset, int bytes, InternetAddress address,
       int port) {
     _throwOnBadPort(port);
@@ -1215,9 +1260,13 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
   void nativeSetSocketId(int id, int typeFlags) native "Socket_SetSocketId";
   nativeAvailable() native "Socket_Available";
   nativeRead(int len) native "Socket_Read";
+  nativeReadInto(List<int> buffer, int start, int end)
+      native "Socket_ReadInto";
   nativeRecvFrom() native "Socket_RecvFrom";
   nativeWrite(List<int> buffer, int offset, int bytes)
       native "Socket_WriteList";
+  nativeSendFile(int filePointer, int offset, int count)
+      native "Socket_SendFile";
   nativeSendTo(List<int> buffer, int offset, int bytes, Uint8List address,
       int port) native "Socket_SendTo";
   nativeCreateConnect(Uint8List addr, int port, int scope_id)
@@ -1436,9 +1485,39 @@ class _RawSocket extends Stream<RawSocketEvent> implements RawSocket {
     }
   }
 
+  int readInto(List<int> buffer, [int start = 0, int end]) {
+    end = RangeError.checkValidRange(start, end, buffer.length);
+    if (_isMacOSTerminalInput) {
+      var available = this.available();
+      if (available == 0) return 0;
+      var bytesRead = _socket.readInto(buffer, start, end);
+      if (bytesRead < min(available, end - start)) {
+        // Reading less than available from a Mac OS terminal indicate Ctrl-D.
+        // This is interpreted as read closed.
+        scheduleMicrotask(() => _controller.add(RawSocketEvent.readClosed));
+      }
+      return bytesRead;
+    } else {
+      return _socket.readInto(buffer, start, end);
+    }
+  }
+
   int write(List<int> buffer, [int offset, int count]) =>
       _socket.write(buffer, offset, count);
 
+  static final bool _sendFileSupported =
+      Platform.isLinux || Platform.isAndroid || Platform.isMacOS;
+
+  int sendFile(RandomAccessFile file, int offset, [int count]) {
+    count = _checkSendFileArguments(file, offset, count);
+    if (!_sendFileSupported || file is! _RandomAccessFile) {
+      return _sendFileByCopy(this, file, offset, count);
+    }
+    _RandomAccessFile randomAccessFile = file;
+    randomAccessFile._checkAvailable();
+    return _socket.sendFile(randomAccessFile, offset, count);
+  }
+
   Future<RawSocket> close() => _socket.close().then<RawSocket>((_) => this);
 
   void shutdown(SocketDirection direction) => _socket.shutdown(direction);
@@ -94,6 +94,21 @@ class _BigIntImpl implements BigInt {
   static const int _minInt = -0x8000000000000000;
   static const int _maxInt = 0x7fffffffffffffff;
 
+  // Operands with at least this many digits are multiplied with Karatsuba's
+  // method.
+  static const int _minKaratsubaUsed = 80;
+
+  // Decimal strings longer than this are split in two when parsed.
+  static const int _minSplitDecimalLength = 800;
+
+  // Numbers with at least this many digits are split in two when converted
+  // to decimal strings.
+  static const int _minSplitDecimalUsed = 32;
+
+  // The powers (10^9)^(2^k), which are used to split numbers in halves when
+  // converting between decimal strings and bigints. Computed on demand.
+  static final List<_BigIntImpl> _decimalPowers = <_BigIntImpl>[_oneBillion];
+
   // Result cache for last _divRem call.
   // Result cache for last _divRem call.
   static Uint32List _lastDividendDigits;
@@ -166,6 +181,27 @@ class _BigIntImpl implements BigInt {
   ///
   /// The [source] must not contain leading or trailing whitespace.
   static _BigIntImpl _parseDecimal(String source, bool isNegative) {
+    var result = _parseDecimalDigits(source, 0, source.length);
+    if (isNegative) return -result;
+    return result;
+  }
+
+  /// Parses the decimal digits of [source] in the range [start] to [end-1].
+  ///
+  /// Ranges longer than [_minSplitDecimalLength] are split in two, so that
+  /// most of the work is done by a few multiplications of large operands,
+  /// instead of one multiplication by 10^9 for every 9 digits.
+  static _BigIntImpl _parseDecimalDigits(String source, int start, int end) {
+    int length = end - start;
+    if (length > _minSplitDecimalLength) {
+      // The low part has 9*2^k digits, and the high part at most as many.
+      int k = 0;
+      while ((9 << (k + 1)) < length) k++;
+      int split = end - (9 << k);
+      return _parseDecimalDigits(source, start, split) * _decimalPower(k) +
+          _parseDecimalDigits(source, split, end);
+    }
+
     const _0 = 48;
 
     int part = 0;
@@ -173,9 +209,9 @@ class _BigIntImpl implements BigInt {
     // Read in the source 9 digits at a time.
     // The first part may have a few leading virtual '0's to make the remaining
     // parts all have exactly 9 digits.
-    int digitInPartCount = 9 - source.length.remainder(9);
+    int digitInPartCount = 9 - length.remainder(9);
     if (digitInPartCount == 9) digitInPartCount = 0;
-    for (int i = 0; i < source.length; i++) {
+    for (int i = start; i < end; i++) {
       part = part * 10 + source.codeUnitAt(i) - _0;
       if (++digitInPartCount == 9) {
         result = result * _oneBillion + new _BigIntImpl._fromInt(part);
@@ -183,10 +219,18 @@ class _BigIntImpl implements BigInt {
         digitInPartCount = 0;
       }
     }
-    if (isNegative) return -result;
     return result;
   }
 
+  /// Returns (10^9)^(2^k), the number with 9*2^k decimal zeros after a one.
+  static _BigIntImpl _decimalPower(int k) {
+    while (_decimalPowers.length <= k) {
+      var last = _decimalPowers.last;
+      _decimalPowers.add(last * last);
+    }
+    return _decimalPowers[k];
+  }
+
   /// Returns the value of a given source digit.
   ///
   /// Source digits between "0" and "9" (inclusive) return their decimal value.
@@ -1202,6 +1246,10 @@ class _BigIntImpl implements BigInt {
     if (used == 0 || otherUsed == 0) {
       return zero;
     }
+    if (used >= _minKaratsubaUsed && otherUsed >= _minKaratsubaUsed) {
+      var result = _absMulKaratsuba(other);
+      return _isNegative != other._isNegative ? -result : result;
+    }
     var resultUsed = used + otherUsed;
     var digits = _digits;
     var otherDigits = other._digits;
@@ -1214,6 +1262,54 @@ class _BigIntImpl implements BigInt {
         _isNegative != other._isNegative, resultUsed, resultDigits);
   }
 
+  /// Returns `abs(this) * abs(other)`, computed with Karatsuba's method.
+  ///
+  /// Both operands are split at half the digits of the larger one, and the
+  /// product of the halves is assembled from three multiplications instead
+  /// of four. When the smaller operand fits in a half, only the larger
+  /// operand is split.
+  _BigIntImpl _absMulKaratsuba(_BigIntImpl other) {
+    var half = (_max(_used, other._used) + 1) >> 1;
+    if (_used <= half) return other._absMulKaratsuba(this);
+    var low = _lowDigits(half);
+    var high = _highDigits(half);
+    if (other._used <= half) {
+      var y = other.abs();
+      return (high * y)._dlShift(half) + low * y;
+    }
+    _BigIntImpl lowProduct, highProduct, middle;
+    if (identical(this, other)) {
+      lowProduct = low * low;
+      highProduct = high * high;
+      var sum = low + high;
+      middle = sum * sum;
+    } else {
+      var otherLow = other._lowDigits(half);
+      var otherHigh = other._highDigits(half);
+      lowProduct = low * otherLow;
+      highProduct = high * otherHigh;
+      middle = (low + high) * (otherLow + otherHigh);
+    }
+    middle = middle - lowProduct - highProduct;
+    return highProduct._dlShift(2 * half) + middle._dlShift(half) + lowProduct;
+  }
+
+  /// Returns the non-negative number made of the [n] least significant
+  /// digits of this number. Requires `n <= _used`.
+  _BigIntImpl _lowDigits(int n) {
+    assert(n <= _used);
+    return new _BigIntImpl._(false, n, _cloneDigits(_digits, 0, n, n));
+  }
+
+  /// Returns the non-negative number made of the digits of this number
+  /// above the [n] least significant ones. Requires `n <= _used`.
+  _BigIntImpl _highDigits(int n) {
+    assert(n <= _used);
+    var used = _used - n;
+    return new _BigIntImpl._(
+        false, used, _cloneDigits(_digits, n, _used, used));
+  }
+
   // resultDigits[0..resultUsed-1] =
   //     xDigits[0..xUsed-1]*otherDigits[0..otherUsed-1].
   // Returns resultUsed = xUsed + otherUsed.
@@ -2424,6 +2520,17 @@ class _BigIntImpl implements BigInt {
       return _digits[0].toString();
     }
 
+    if (_used >= _minSplitDecimalUsed) {
+      var parts = <String>[];
+      if (_isNegative) parts.add("-");
+      var x = abs();
+      // Find k such that x < (10^9)^(2^(k+1)) without computing that power.
+      int k = 0;
+      while (2 * _decimalPower(k)._used - 1 <= x._used) k++;
+      _addDecimalParts(x, k, 0, parts);
+      return parts.join();
+    }
+
     // Generate in chunks of 9 digits.
     // The chunks are in reversed order.
     var decimalDigitChunks = <String>[];
@@ -2454,6 +2561,31 @@ class _BigIntImpl implements BigInt {
     return decimalDigitChunks.reversed.join();
   }
 
+  /// Adds the decimal digits of [x] to [parts], most significant first.
+  ///
+  /// The non-negative [x] must be less than `_decimalPower(k + 1)`. It is
+  /// divided by `_decimalPower(k)` and both halves are converted recursively,
+  /// which takes much fewer divisions of large numbers than taking 9 digits
+  /// at a time. If [width] is not 0, the digits are padded with leading
+  /// zeros to [width] characters.
+  static void _addDecimalParts(
+      _BigIntImpl x, int k, int width, List<String> parts) {
+    if (x._used < _minSplitDecimalUsed) {
+      var digits = x.toString();
+      parts.add(width == 0 ? digits : digits.padLeft(width, "0"));
+      return;
+    }
+    var power = _decimalPower(k);
+    var high = x ~/ power;
+    var low = x.remainder(power);
+    if (width == 0 && high._isZero) {
+      _addDecimalParts(low, k - 1, 0, parts);
+      return;
+    }
+    _addDecimalParts(high, k - 1, width >> 1, parts);
+    _addDecimalParts(low, k - 1, 9 << k, parts);
+  }
+
   int _toRadixCodeUnit(int digit) {
     const int _0 = 48;
     const int _a = 97;
@@ -91,6 +91,11 @@ abstract class _StringBase implements String {
   // TODO(lrn): See if this limit can be tweaked.
   static const int _maxJoinReplaceOneByteStringLength = 500;
 
+  // When searching at least this many positions, calling into C++, which
+  // looks for the first code unit of the pattern many at a time, is faster
+  // than matching at each position.
+  static const int _minNativeIndexOfLength = 32;
+
   factory _StringBase._uninstantiable() {
     throw new UnsupportedError("_StringBase can't be instaniated");
   }
@@ -338,7 +343,9 @@ abstract class _StringBase implements String {
     if (pattern is String) {
       String other = pattern;
       int maxIndex = this.length - other.length;
-      // TODO: Use an efficient string search (e.g. BMH).
+      if (maxIndex - start >= _minNativeIndexOfLength) {
+        return _indexOfNative(other, start);
+      }
       for (int index = start; index <= maxIndex; index++) {
         if (_substringMatches(index, other)) {
           return index;
@@ -354,6 +361,8 @@ abstract class _StringBase implements String {
     return -1;
   }
 
+  int _indexOfNative(String other, int start) native "String_indexOf";
+
   int lastIndexOf(Pattern pattern, [int start = null]) {
     if (start == null) {
       start = this.length;
@@ -1019,6 +1028,9 @@ class _OneByteString extends _StringBase {
         if (patternCu0 > 0xFF) {
           return -1;
         }
+        if (len - start >= _StringBase._minNativeIndexOfLength) {
+          return _indexOfNative(patternAsString, start);
+        }
         for (int i = start; i < len; i++) {
           if (this.codeUnitAt(i) == patternCu0) {
             return i;
@@ -1042,6 +1054,9 @@ class _OneByteString extends _StringBase {
         if (patternCu0 > 0xFF) {
           return false;
         }
+        if (len - start >= _StringBase._minNativeIndexOfLength) {
+          return _indexOfNative(patternAsString, start) >= 0;
+        }
         for (int i = start; i < len; i++) {
           if (this.codeUnitAt(i) == patternCu0) {
             return true;
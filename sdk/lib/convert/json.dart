@@ -251,8 +251,14 @@ class JsonEncoder extends Converter<Object, String> {
   /// If an object is serialized more than once, [convert] may cache the text
   /// for it. In other words, if the content of an object changes after it is
   /// first serialized, the new values may not be reflected in the result.
-  String convert(Object object) =>
-      _JsonStringStringifier.stringify(object, _toEncodable, indent);
+  String convert(Object object) {
+    if (indent == null) {
+      // Allow the implementation to encode compact JSON natively.
+      var result = _convertIntercepted(object, _toEncodable);
+      if (result != null) return result;
+    }
+    return _JsonStringStringifier.stringify(object, _toEncodable, indent);
+  }
 
   /// Starts a chunked conversion.
   ///
@@ -288,6 +294,9 @@ class JsonEncoder extends Converter<Object, String> {
     }
     return super.fuse<T>(other);
   }
+
+  external static String _convertIntercepted(
+      Object object, Function(dynamic) toEncodable);
 }
 
 /// Encoder that encodes a single object as a UTF-8 encoded JSON string.
@@ -354,6 +363,11 @@ class JsonUtf8Encoder extends Converter<Object, List<int>> {
 
   /// Convert [object] into UTF-8 encoded JSON.
   List<int> convert(Object object) {
+    if (_indent == null) {
+      // Allow the implementation to encode compact JSON natively.
+      var result = _convertIntercepted(object, _toEncodable);
+      if (result != null) return result;
+    }
     var bytes = <List<int>>[];
     // The `stringify` function always converts into chunks.
     // Collect the chunks into the `bytes` list, then combine them afterwards.
@@ -403,6 +417,9 @@ class JsonUtf8Encoder extends Converter<Object, List<int>> {
   Stream<List<int>> bind(Stream<Object> stream) {
     return super.bind(stream);
   }
+
+  external static List<int> _convertIntercepted(
+      Object object, Function(dynamic) toEncodable);
 }
 
 /// Implements the chunked conversion from object to its JSON representation.
@@ -155,6 +155,15 @@ class ZLibCodec extends Codec<List<int>, List<int>> {
    */
   final List<int> dictionary;
 
+  /**
+   * The number of threads used to compress the data. With more than one
+   * thread the input is split into blocks that are compressed concurrently,
+   * which makes compressing large inputs faster at the cost of slightly larger
+   * output. At most as many threads as there are processors are used. The
+   * default value is `1`.
+   */
+  final int threads;
+
   ZLibCodec(
       {this.level: ZLibOption.defaultLevel,
       this.windowBits: ZLibOption.defaultWindowBits,
@@ -162,11 +171,13 @@ class ZLibCodec extends Codec<List<int>, List<int>> {
       this.strategy: ZLibOption.strategyDefault,
       this.dictionary,
       this.raw: false,
-      this.gzip: false}) {
+      this.gzip: false,
+      this.threads: 1}) {
     _validateZLibeLevel(level);
     _validateZLibMemLevel(memLevel);
     _validateZLibStrategy(strategy);
     _validateZLibWindowBits(windowBits);
+    _validateZLibThreads(threads);
   }
 
   const ZLibCodec._default()
@@ -176,7 +187,8 @@ class ZLibCodec extends Codec<List<int>, List<int>> {
         strategy = ZLibOption.strategyDefault,
         raw = false,
         gzip = false,
-        dictionary = null;
+        dictionary = null,
+        threads = 1;
 
   /**
    * Get a [ZLibEncoder] for encoding to `ZLib` compressed data.
@@ -188,7 +200,8 @@ class ZLibCodec extends Codec<List<int>, List<int>> {
       memLevel: memLevel,
       strategy: strategy,
       dictionary: dictionary,
-      raw: raw);
+      raw: raw,
+      threads: threads);
 
   /**
    * Get a [ZLibDecoder] for decoding `ZLib` compressed data.
@@ -272,6 +285,15 @@ class GZipCodec extends Codec<List<int>, List<int>> {
    */
   final bool raw;
 
+  /**
+   * The number of threads used to compress the data. With more than one
+   * thread the input is split into blocks that are compressed concurrently,
+   * which makes compressing large inputs faster at the cost of slightly larger
+   * output. At most as many threads as there are processors are used. The
+   * default value is `1`.
+   */
+  final int threads;
+
   GZipCodec(
       {this.level: ZLibOption.defaultLevel,
       this.windowBits: ZLibOption.defaultWindowBits,
@@ -279,11 +301,13 @@ class GZipCodec extends Codec<List<int>, List<int>> {
       this.strategy: ZLibOption.strategyDefault,
       this.dictionary,
       this.raw: false,
-      this.gzip: true}) {
+      this.gzip: true,
+      this.threads: 1}) {
     _validateZLibeLevel(level);
     _validateZLibMemLevel(memLevel);
     _validateZLibStrategy(strategy);
     _validateZLibWindowBits(windowBits);
+    _validateZLibThreads(threads);
   }
 
   const GZipCodec._default()
@@ -293,7 +317,8 @@ class GZipCodec extends Codec<List<int>, List<int>> {
         strategy = ZLibOption.strategyDefault,
         raw = false,
         gzip = true,
-        dictionary = null;
+        dictionary = null,
+        threads = 1;
 
   /**
    * Get a [ZLibEncoder] for encoding to `GZip` compressed data.
@@ -305,7 +330,8 @@ class GZipCodec extends Codec<List<int>, List<int>> {
       memLevel: memLevel,
       strategy: strategy,
       dictionary: dictionary,
-      raw: raw);
+      raw: raw,
+      threads: threads);
 
   /**
    * Get a [ZLibDecoder] for decoding `GZip` compressed data.
@@ -379,6 +405,15 @@ class ZLibEncoder extends Converter<List<int>, List<int>> {
    */
   final bool raw;
 
+  /**
+   * The number of threads used to compress the data. With more than one
+   * thread the input is split into blocks that are compressed concurrently,
+   * which makes compressing large inputs faster at the cost of slightly larger
+   * output. At most as many threads as there are processors are used. The
+   * default value is `1`.
+   */
+  final int threads;
+
   ZLibEncoder(
       {this.gzip: false,
       this.level: ZLibOption.defaultLevel,
@@ -386,11 +421,13 @@ class ZLibEncoder extends Converter<List<int>, List<int>> {
       this.memLevel: ZLibOption.defaultMemLevel,
       this.strategy: ZLibOption.strategyDefault,
       this.dictionary,
-      this.raw: false}) {
+      this.raw: false,
+      this.threads: 1}) {
     _validateZLibeLevel(level);
     _validateZLibMemLevel(memLevel);
     _validateZLibStrategy(strategy);
     _validateZLibWindowBits(windowBits);
+    _validateZLibThreads(threads);
   }
 
   /**
@@ -414,8 +451,8 @@ class ZLibEncoder extends Converter<List<int>, List<int>> {
     if (sink is! ByteConversionSink) {
       sink = new ByteConversionSink.from(sink);
     }
-    return new _ZLibEncoderSink._(
-        sink, gzip, level, windowBits, memLevel, strategy, dictionary, raw);
+    return new _ZLibEncoderSink._(sink, gzip, level, windowBits, memLevel,
+        strategy, dictionary, raw, threads);
   }
 }
 
@@ -487,6 +524,11 @@ abstract class RawZLibFilter {
   /**
    * Returns a a [RawZLibFilter] whose [process] and [processed] methods
    * compress data.
+   *
+   * With more than one [threads], the data is compressed in blocks on
+   * several threads and [processed] may return `null` before all data given
+   * to [process] is compressed. All output is returned once [processed] is
+   * called with [flush] or [end] set.
    */
   factory RawZLibFilter.deflateFilter({
     bool gzip: false,
@@ -496,9 +538,10 @@ abstract class RawZLibFilter {
     int strategy: ZLibOption.strategyDefault,
     List<int> dictionary,
     bool raw: false,
+    int threads: 1,
   }) {
     return _makeZLibDeflateFilter(
-        gzip, level, windowBits, memLevel, strategy, dictionary, raw);
+        gzip, level, windowBits, memLevel, strategy, dictionary, raw, threads);
   }
 
   /**
@@ -536,7 +579,8 @@ abstract class RawZLibFilter {
       int memLevel,
       int strategy,
       List<int> dictionary,
-      bool raw);
+      bool raw,
+      int threads);
 
   external static RawZLibFilter _makeZLibInflateFilter(
       int windowBits, List<int> dictionary, bool raw);
@@ -570,11 +614,12 @@ class _ZLibEncoderSink extends _FilterSink {
       int memLevel,
       int strategy,
       List<int> dictionary,
-      bool raw)
+      bool raw,
+      int threads)
       : super(
             sink,
-            RawZLibFilter._makeZLibDeflateFilter(
-                gzip, level, windowBits, memLevel, strategy, dictionary, raw));
+            RawZLibFilter._makeZLibDeflateFilter(gzip, level, windowBits,
+                memLevel, strategy, dictionary, raw, threads));
 }
 
 class _ZLibDecoderSink extends _FilterSink {
@@ -659,6 +704,12 @@ void _validateZLibMemLevel(int memLevel) {
   }
 }
 
+void _validateZLibThreads(int threads) {
+  if (threads < 1) {
+    throw new RangeError.range(threads, 1, null, "threads");
+  }
+}
+
 void _validateZLibStrategy(int strategy) {
   const strategies = const <int>[
     ZLibOption.strategyFiltered,
@@ -437,6 +437,11 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
   static const int writeEncryptedId = 3;
   static const int bufferCount = 4;
 
+  // Filter passes with at most this many bytes of pending input are run
+  // synchronously on the isolate thread instead of on the IO service, as the
+  // round trip to the IO service costs more than filtering a small record.
+  static const int syncFilterThreshold = 4 * 1024;
+
   // Is a buffer identifier for an encrypted buffer?
   static bool _isBufferEncrypted(int identifier) =>
       identifier >= readEncryptedId;
@@ -704,6 +709,26 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
     return result;
   }
 
+  int readInto(List<int> buffer, [int start = 0, int end]) {
+    end = RangeError.checkValidRange(start, end, buffer.length);
+    if (_closedRead) {
+      throw new SocketException("Reading from a closed socket");
+    }
+    if (_status != connectedStatus) {
+      return 0;
+    }
+    var result =
+        _secureFilter.buffers[readPlaintextId].readInto(buffer, start, end);
+    _scheduleFilter();
+    return result;
+  }
+
+  int sendFile(RandomAccessFile file, int offset, [int count]) {
+    count = _checkSendFileArguments(file, offset, count);
+    // The data has to be encrypted, so it cannot bypass the filter.
+    return _sendFileByCopy(this, file, offset, count);
+  }
+
   // Write the data to the socket, and schedule the filter to encrypt it.
   int write(List<int> data, [int offset, int bytes]) {
     if (bytes != null && (bytes is! int || bytes < 0)) {
@@ -1032,17 +1057,30 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
 
   Future<_FilterStatus> _pushAllFilterStages() {
     bool wasInHandshake = _status != connectedStatus;
-    List args = new List(2 + bufferCount * 2);
-    args[0] = _secureFilter._pointer();
-    args[1] = wasInHandshake;
     var bufs = _secureFilter.buffers;
-    for (var i = 0; i < bufferCount; ++i) {
-      args[2 * i + 2] = bufs[i].start;
-      args[2 * i + 3] = bufs[i].end;
+    Future<List> filtered;
+    if (bufs[readEncryptedId].length + bufs[writePlaintextId].length <=
+        syncFilterThreshold) {
+      List<int> positions = new List<int>(bufferCount * 2);
+      for (var i = 0; i < bufferCount; ++i) {
+        positions[2 * i] = bufs[i].start;
+        positions[2 * i + 1] = bufs[i].end;
+      }
+      filtered = new Future<List>.value(
+          _secureFilter.processAllBuffers(wasInHandshake, positions));
+    } else {
+      List args = new List(2 + bufferCount * 2);
+      args[0] = _secureFilter._pointer();
+      args[1] = wasInHandshake;
+      for (var i = 0; i < bufferCount; ++i) {
+        args[2 * i + 2] = bufs[i].start;
+        args[2 * i + 3] = bufs[i].end;
+      }
+      filtered = _IOService._dispatch(_IOService.sslProcessFilter, args)
+          .then((response) => response as List);
     }
 
-    return _IOService._dispatch(_IOService.sslProcessFilter, args)
-        .then((response) {
+    return filtered.then((response) {
       if (response.length == 2) {
         if (wasInHandshake) {
           // If we're in handshake, throw a handshake error.
@@ -1188,6 +1226,20 @@ class _ExternalBuffer {
     return result;
   }
 
+  int readInto(List<int> buffer, int offset, int end) {
+    int bytes = min(end - offset, length);
+    int bytesRead = 0;
+    // Loop over zero, one, or two linear data ranges.
+    while (bytesRead < bytes) {
+      int toRead = min(bytes - bytesRead, linearLength);
+      buffer.setRange(
+          offset + bytesRead, offset + bytesRead + toRead, data, start);
+      advanceStart(toRead);
+      bytesRead += toRead;
+    }
+    return bytesRead;
+  }
+
   int write(List<int> inputData, int offset, int bytes) {
     if (bytes > free) {
       bytes = free;
@@ -1256,6 +1308,11 @@ abstract class _SecureFilter {
   void init();
   X509Certificate get peerCertificate;
   int processBuffer(int bufferIndex);
+
+  // Filters the buffers synchronously. [positions] holds the start and end
+  // of each buffer and is updated in place and returned on success. On
+  // failure a list of the error code and message is returned.
+  List processAllBuffers(bool inHandshake, List<int> positions);
   void registerBadCertificateCallback(Function callback);
   void registerHandshakeCompleteCallback(Function handshakeCompleteHandler);
 
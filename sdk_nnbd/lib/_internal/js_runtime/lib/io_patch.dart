@@ -602,7 +602,8 @@ class RawZLibFilter {
       int memLevel,
       int strategy,
       List<int> dictionary,
-      bool raw) {
+      bool raw,
+      int threads) {
     throw new UnsupportedError("_newZLibDeflateFilter");
   }
 
@@ -77,6 +77,7 @@ class _RandomAccessFileOpsImpl extends NativeFieldWrapperClass1
   readByte() native "File_ReadByte";
   read(int bytes) native "File_Read";
   readInto(List<int> buffer, int start, int end) native "File_ReadInto";
+  map(int offset, int length, int advice) native "File_Map";
   writeByte(int value) native "File_WriteByte";
   writeFrom(List<int> buffer, int start, int end) native "File_WriteFrom";
   position() native "File_Position";
@@ -207,11 +208,12 @@ class _FileSystemWatcher {
       var events = [];
       var pair = {};
       if (event == RawSocketEvent.read) {
-        String getPath(event) {
+        String getPath(event, [int nameIndex = 2]) {
           var path = _pathFromPathId(event[4]).path;
-          if (event[2] != null && event[2].isNotEmpty) {
+          var name = event[nameIndex];
+          if (name != null && name.isNotEmpty) {
             path += Platform.pathSeparator;
-            path += event[2];
+            path += name;
           }
           return path;
         }
@@ -250,6 +252,16 @@ class _FileSystemWatcher {
               // Path is no longer being wathed.
               continue;
             }
+            if ((event[0] & FileSystemEvent._overflow) != 0) {
+              events.add([
+                pathId,
+                new FileSystemException(
+                    "Events were lost, as more changes happened than could "
+                    "be queued",
+                    _pathFromPathId(pathId).path)
+              ]);
+              continue;
+            }
             bool isDir = getIsDir(event);
             var path = getPath(event);
             if ((event[0] & FileSystemEvent.create) != 0) {
@@ -263,7 +275,11 @@ class _FileSystemWatcher {
             }
             if ((event[0] & FileSystemEvent.move) != 0) {
               int link = event[1];
-              if (link > 0) {
+              if (event.length > 5 && event[5] != null) {
+                // The native side already paired the rename.
+                add(event[4],
+                    new FileSystemMoveEvent._(path, isDir, getPath(event, 5)));
+              } else if (link > 0) {
                 pair.putIfAbsent(pathId, () => {});
                 if (pair[pathId].containsKey(link)) {
                   add(
@@ -347,7 +363,9 @@ class _InotifyFileSystemWatcher extends _FileSystemWatcher {
     _subscription =
         _FileSystemWatcher._listenOnSocket(id, id, 0).listen((event) {
       if (_idMap.containsKey(event[0])) {
-        if (event[1] != null) {
+        if (event[1] is FileSystemException) {
+          _idMap[event[0]].addError(event[1]);
+        } else if (event[1] != null) {
           _idMap[event[0]].add(event[1]);
         } else {
           _idMap[event[0]].close();
@@ -23,11 +23,13 @@ class _ZLibInflateFilter extends _FilterImpl {
 
 class _ZLibDeflateFilter extends _FilterImpl {
   _ZLibDeflateFilter(bool gzip, int level, int windowBits, int memLevel,
-      int strategy, List<int> dictionary, bool raw) {
-    _init(gzip, level, windowBits, memLevel, strategy, dictionary, raw);
+      int strategy, List<int> dictionary, bool raw, int threads) {
+    _init(
+        gzip, level, windowBits, memLevel, strategy, dictionary, raw, threads);
   }
   void _init(bool gzip, int level, int windowBits, int memLevel, int strategy,
-      List<int> dictionary, bool raw) native "Filter_CreateZLibDeflate";
+      List<int> dictionary, bool raw, int threads)
+      native "Filter_CreateZLibDeflate";
 }
 
 @patch
@@ -40,9 +42,10 @@ class RawZLibFilter {
           int memLevel,
           int strategy,
           List<int> dictionary,
-          bool raw) =>
-      new _ZLibDeflateFilter(
-          gzip, level, windowBits, memLevel, strategy, dictionary, raw);
+          bool raw,
+          int threads) =>
+      new _ZLibDeflateFilter(gzip, level, windowBits, memLevel, strategy,
+          dictionary, raw, threads);
   @patch
   static RawZLibFilter _makeZLibInflateFilter(
           int windowBits, List<int> dictionary, bool raw) =>
@@ -106,6 +106,9 @@ class _SecureFilterImpl extends NativeFieldWrapperClass1
 
   int processBuffer(int bufferIndex) => throw new UnimplementedError();
 
+  List processAllBuffers(bool inHandshake, List<int> positions)
+      native "SecureSocket_ProcessAllBuffers";
+
   String selectedProtocol() native "SecureSocket_GetSelectedProtocol";
 
   void renegotiate(bool useSessionCache, bool requestClientCertificate,
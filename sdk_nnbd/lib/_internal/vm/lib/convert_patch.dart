@@ -21,6 +21,8 @@ import "dart:typed_data" show Uint8List, Uint16List;
 _parseJson(String source, reviver(key, value)) {
   _BuildJsonListener listener;
   if (reviver == null) {
+    var result = _decodeJson(source);
+    if (result != null) return result;
     listener = new _BuildJsonListener();
   } else {
     listener = new _ReviverJsonListener(reviver);
@@ -61,6 +63,10 @@ class _JsonUtf8Decoder extends Converter<List<int>, Object> {
   _JsonUtf8Decoder(this._reviver, this._allowMalformed);
 
   Object convert(List<int> input) {
+    if (_reviver == null && input is Uint8List) {
+      var result = _decodeJson(input);
+      if (result != null) return result;
+    }
     var parser = _JsonUtf8DecoderSink._createParser(_reviver, _allowMalformed);
     parser.chunk = input;
     parser.chunkEnd = input.length;
@@ -74,6 +80,95 @@ class _JsonUtf8Decoder extends Converter<List<int>, Object> {
   }
 }
 
+@patch
+class JsonEncoder {
+  @patch
+  static String _convertIntercepted(Object object, toEncodable(o)) {
+    var replacements =
+        new _JsonReplacements(toEncodable ?? _defaultToEncodable);
+    String result = _encodeJson(object, replacements.replace, false);
+    if (result != null) return result;
+    return _JsonStringStringifier.stringify(object, replacements.replay, null);
+  }
+}
+
+@patch
+class JsonUtf8Encoder {
+  @patch
+  static List<int> _convertIntercepted(Object object, toEncodable(o)) {
+    var replacements =
+        new _JsonReplacements(toEncodable ?? _defaultToEncodable);
+    List<int> result = _encodeJson(object, replacements.replace, true);
+    if (result != null) return result;
+    var sink = new ByteConversionSink.withCallback((bytes) {
+      result = bytes;
+    });
+    _JsonUtf8Stringifier.stringify(
+        object,
+        null,
+        replacements.replay,
+        JsonUtf8Encoder._defaultBufferSize,
+        (chunk, start, end) => sink.addSlice(chunk, start, end, false));
+    sink.close();
+    return result;
+  }
+}
+
+/// Calls `toEncodable` for the VM's JSON encoder, and keeps what it returned
+/// or threw.
+///
+/// When the VM leaves an object to the Dart stringifiers, they visit the
+/// objects the VM visited in the same order, and are given the kept results
+/// rather than calling `toEncodable` a second time.
+class _JsonReplacements {
+  final Function _toEncodable;
+  final List _objects = [];
+  final List _results = [];
+  final List<bool> _threw = <bool>[];
+  int _replayed = 0;
+
+  _JsonReplacements(this._toEncodable);
+
+  replace(object) {
+    // The VM writes its own lists and maps, and gives up on objects that
+    // are not replaced by JSON values. The Dart stringifiers write other
+    // lists and maps without calling `toEncodable`.
+    if (object is List || object is Map) return object;
+    _objects.add(object);
+    try {
+      var result = _toEncodable(object);
+      _results.add(result);
+      _threw.add(false);
+      return result;
+    } catch (e) {
+      _results.add(e);
+      _threw.add(true);
+      rethrow;
+    }
+  }
+
+  replay(object) {
+    if (_replayed < _objects.length && identical(object, _objects[_replayed])) {
+      final i = _replayed++;
+      if (_threw[i]) throw _results[i];
+      return _results[i];
+    }
+    return _toEncodable(object);
+  }
+}
+
+// Encodes [object] as compact JSON, to a [String] or, if [asUtf8], to an
+// external [Uint8List] of UTF-8, calling [replace] where the Dart
+// stringifiers would call `toEncodable`. Returns null if the VM leaves
+// [object] to the Dart stringifiers, which is also how it reports errors.
+_encodeJson(Object object, replace(o), bool asUtf8) native "Json_encode";
+
+// Decodes a [String], or a [Uint8List] of UTF-8, to the values a
+// [_BuildJsonListener] would build, without going through the listener.
+// Returns null if the VM leaves [source] to the Dart parser, which is also how
+// it reports errors, so the document "null" is parsed twice.
+_decodeJson(source) native "Json_decode";
+
 //// Implementation ///////////////////////////////////////////////////////////
 
 // Simple API for JSON parsing.
@@ -1810,6 +1905,10 @@ class _JsonUtf8Parser extends _ChunkedJsonParser<List<int>> {
 
 double _parseDouble(String source, int start, int end) native "Double_parse";
 
+// Returns null if [units] is not one of the VM's typed data lists.
+int _scanOneByteCharactersNative(Uint8List units, int from, int to)
+    native "Utf8_scanOneByteCharacters";
+
 /**
  * Implements the chunked conversion from a UTF-8 encoding of JSON
  * to its corresponding object.
@@ -1854,6 +1953,10 @@ class _JsonUtf8DecoderSink extends ByteConversionSinkBase {
   }
 }
 
+// Ranges at least this long are scanned by the VM, which checks many bytes at
+// a time. Shorter ones do not make up for the cost of the native call.
+const int _nativeScanThreshold = 64;
+
 @patch
 int _scanOneByteCharacters(List<int> units, int from, int endIndex) {
   final to = endIndex;
@@ -1861,6 +1964,10 @@ int _scanOneByteCharacters(List<int> units, int from, int endIndex) {
   // Special case for _Uint8ArrayView.
   if (units is Uint8List) {
     if (from >= 0 && to >= 0 && to <= units.length) {
+      if (to - from >= _nativeScanThreshold) {
+        final length = _scanOneByteCharactersNative(units, from, to);
+        if (length != null) return length;
+      }
       for (int i = from; i < to; i++) {
         final unit = units[i];
         if ((unit & _ONE_BYTE_LIMIT) != unit) return i - from;
@@ -157,6 +157,15 @@ class ZLibCodec extends Codec<List<int>, List<int>> {
    */
   final List<int> dictionary;
 
+  /**
+   * The number of threads used to compress the data. With more than one
+   * thread the input is split into blocks that are compressed concurrently,
+   * which makes compressing large inputs faster at the cost of slightly larger
+   * output. At most as many threads as there are processors are used. The
+   * default value is `1`.
+   */
+  final int threads;
+
   ZLibCodec(
       {this.level: ZLibOption.defaultLevel,
       this.windowBits: ZLibOption.defaultWindowBits,
@@ -164,11 +173,13 @@ class ZLibCodec extends Codec<List<int>, List<int>> {
       this.strategy: ZLibOption.strategyDefault,
       this.dictionary,
       this.raw: false,
-      this.gzip: false}) {
+      this.gzip: false,
+      this.threads: 1}) {
     _validateZLibeLevel(level);
     _validateZLibMemLevel(memLevel);
     _validateZLibStrategy(strategy);
     _validateZLibWindowBits(windowBits);
+    _validateZLibThreads(threads);
   }
 
   const ZLibCodec._default()
@@ -178,7 +189,8 @@ class ZLibCodec extends Codec<List<int>, List<int>> {
         strategy = ZLibOption.strategyDefault,
         raw = false,
         gzip = false,
-        dictionary = null;
+        dictionary = null,
+        threads = 1;
 
   /**
    * Get a [ZLibEncoder] for encoding to `ZLib` compressed data.
@@ -190,7 +202,8 @@ class ZLibCodec extends Codec<List<int>, List<int>> {
       memLevel: memLevel,
       strategy: strategy,
       dictionary: dictionary,
-      raw: raw);
+      raw: raw,
+      threads: threads);
 
   /**
    * Get a [ZLibDecoder] for decoding `ZLib` compressed data.
@@ -274,6 +287,15 @@ class GZipCodec extends Codec<List<int>, List<int>> {
    */
   final bool raw;
 
+  /**
+   * The number of threads used to compress the data. With more than one
+   * thread the input is split into blocks that are compressed concurrently,
+   * which makes compressing large inputs faster at the cost of slightly larger
+   * output. At most as many threads as there are processors are used. The
+   * default value is `1`.
+   */
+  final int threads;
+
   GZipCodec(
       {this.level: ZLibOption.defaultLevel,
       this.windowBits: ZLibOption.defaultWindowBits,
@@ -281,11 +303,13 @@ class GZipCodec extends Codec<List<int>, List<int>> {
       this.strategy: ZLibOption.strategyDefault,
       this.dictionary,
       this.raw: false,
-      this.gzip: true}) {
+      this.gzip: true,
+      this.threads: 1}) {
     _validateZLibeLevel(level);
     _validateZLibMemLevel(memLevel);
     _validateZLibStrategy(strategy);
     _validateZLibWindowBits(windowBits);
+    _validateZLibThreads(threads);
   }
 
   const GZipCodec._default()
@@ -295,7 +319,8 @@ class GZipCodec extends Codec<List<int>, List<int>> {
         strategy = ZLibOption.strategyDefault,
         raw = false,
         gzip = true,
-        dictionary = null;
+        dictionary = null,
+        threads = 1;
 
   /**
    * Get a [ZLibEncoder] for encoding to `GZip` compressed data.
@@ -307,7 +332,8 @@ class GZipCodec extends Codec<List<int>, List<int>> {
       memLevel: memLevel,
       strategy: strategy,
       dictionary: dictionary,
-      raw: raw);
+      raw: raw,
+      threads: threads);
 
   /**
    * Get a [ZLibDecoder] for decoding `GZip` compressed data.
@@ -381,6 +407,15 @@ class ZLibEncoder extends Converter<List<int>, List<int>> {
    */
   final bool raw;
 
+  /**
+   * The number of threads used to compress the data. With more than one
+   * thread the input is split into blocks that are compressed concurrently,
+   * which makes compressing large inputs faster at the cost of slightly larger
+   * output. At most as many threads as there are processors are used. The
+   * default value is `1`.
+   */
+  final int threads;
+
   ZLibEncoder(
       {this.gzip: false,
       this.level: ZLibOption.defaultLevel,
@@ -388,11 +423,13 @@ class ZLibEncoder extends Converter<List<int>, List<int>> {
       this.memLevel: ZLibOption.defaultMemLevel,
       this.strategy: ZLibOption.strategyDefault,
       this.dictionary,
-      this.raw: false}) {
+      this.raw: false,
+      this.threads: 1}) {
     _validateZLibeLevel(level);
     _validateZLibMemLevel(memLevel);
     _validateZLibStrategy(strategy);
     _validateZLibWindowBits(windowBits);
+    _validateZLibThreads(threads);
   }
 
   /**
@@ -416,8 +453,8 @@ class ZLibEncoder extends Converter<List<int>, List<int>> {
     if (sink is! ByteConversionSink) {
       sink = new ByteConversionSink.from(sink);
     }
-    return new _ZLibEncoderSink._(
-        sink, gzip, level, windowBits, memLevel, strategy, dictionary, raw);
+    return new _ZLibEncoderSink._(sink, gzip, level, windowBits, memLevel,
+        strategy, dictionary, raw, threads);
   }
 }
 
@@ -489,6 +526,11 @@ abstract class RawZLibFilter {
   /**
    * Returns a a [RawZLibFilter] whose [process] and [processed] methods
    * compress data.
+   *
+   * With more than one [threads], the data is compressed in blocks on
+   * several threads and [processed] may return `null` before all data given
+   * to [process] is compressed. All output is returned once [processed] is
+   * called with [flush] or [end] set.
    */
   factory RawZLibFilter.deflateFilter({
     bool gzip: false,
@@ -498,9 +540,10 @@ abstract class RawZLibFilter {
     int strategy: ZLibOption.strategyDefault,
     List<int> dictionary,
     bool raw: false,
+    int threads: 1,
   }) {
     return _makeZLibDeflateFilter(
-        gzip, level, windowBits, memLevel, strategy, dictionary, raw);
+        gzip, level, windowBits, memLevel, strategy, dictionary, raw, threads);
   }
 
   /**
@@ -538,7 +581,8 @@ abstract class RawZLibFilter {
       int memLevel,
       int strategy,
       List<int> dictionary,
-      bool raw);
+      bool raw,
+      int threads);
 
   external static RawZLibFilter _makeZLibInflateFilter(
       int windowBits, List<int> dictionary, bool raw);
@@ -572,11 +616,12 @@ class _ZLibEncoderSink extends _FilterSink {
       int memLevel,
       int strategy,
       List<int> dictionary,
-      bool raw)
+      bool raw,
+      int threads)
       : super(
             sink,
-            RawZLibFilter._makeZLibDeflateFilter(
-                gzip, level, windowBits, memLevel, strategy, dictionary, raw));
+            RawZLibFilter._makeZLibDeflateFilter(gzip, level, windowBits,
+                memLevel, strategy, dictionary, raw, threads));
 }
 
 class _ZLibDecoderSink extends _FilterSink {
@@ -661,6 +706,12 @@ void _validateZLibMemLevel(int memLevel) {
   }
 }
 
+void _validateZLibThreads(int threads) {
+  if (threads < 1) {
+    throw new RangeError.range(threads, 1, null, "threads");
+  }
+}
+
 void _validateZLibStrategy(int strategy) {
   const strategies = const <int>[
     ZLibOption.strategyFiltered,
@@ -99,6 +99,30 @@ class FileLock {
   const FileLock._internal(this._type);
 }
 
+/// Hint for the expected access pattern of a memory mapped file region.
+///
+/// See [RandomAccessFile.mapSync].
+class FileMapAdvice {
+  /// No particular access pattern.
+  static const normal = const FileMapAdvice._internal(0);
+
+  /// The region will be read sequentially, so it can be read ahead
+  /// aggressively and pages can be dropped soon after they were read.
+  static const sequential = const FileMapAdvice._internal(1);
+
+  /// The region will be accessed in random order, so read ahead is of
+  /// little use.
+  static const random = const FileMapAdvice._internal(2);
+
+  /// The whole region will be needed soon, so it should be read in ahead of
+  /// time.
+  static const willNeed = const FileMapAdvice._internal(3);
+
+  final int _value;
+
+  const FileMapAdvice._internal(this._value);
+}
+
 /**
  * A reference to a file on the file system.
  *
@@ -718,6 +742,30 @@ abstract class RandomAccessFile {
    */
   int readIntoSync(List<int> buffer, [int start = 0, int end]);
 
+  /**
+   * Maps [length] bytes of the file, starting at byte [offset], into memory
+   * and returns them as a [Uint8List] backed by the mapping.
+   *
+   * On most platforms the file contents are not copied. The operating system
+   * loads them as they are accessed and shares them with other processes
+   * mapping the same file. On Windows the range is instead read into memory
+   * when it is mapped, so it is not shared and later changes to the file are
+   * not seen. [advice] hints the expected access pattern to the operating
+   * system; it is ignored on Windows and Fuchsia.
+   *
+   * Writes to the returned list are private to this process and are not
+   * written back to the file. The mapping stays valid after the file is
+   * closed and is removed when the list is garbage collected. The file must
+   * not be truncated while it is mapped.
+   *
+   * The range [offset] to [offset] + [length] must be within the file and
+   * [length] must be positive.
+   *
+   * Throws a [FileSystemException] if the operation fails.
+   */
+  Uint8List mapSync(int offset, int length,
+      {FileMapAdvice advice: FileMapAdvice.normal});
+
   /**
    * Writes a single byte to the file. Returns a
    * `Future<RandomAccessFile>` that completes with this
@@ -663,6 +663,7 @@ abstract class _RandomAccessFileOps {
   length();
   flush();
   lock(int lock, int start, int end);
+  map(int offset, int length, int advice);
 }
 
 class _RandomAccessFile implements RandomAccessFile {
@@ -808,6 +809,28 @@ class _RandomAccessFile implements RandomAccessFile {
     return result;
   }
 
+  Uint8List mapSync(int offset, int length,
+      {FileMapAdvice advice: FileMapAdvice.normal}) {
+    _checkAvailable();
+    ArgumentError.checkNotNull(advice, 'advice');
+    RangeError.checkNotNegative(offset, 'offset');
+    if (length is! int || length <= 0) {
+      throw new ArgumentError.value(length, 'length', 'Must be positive');
+    }
+    // Accessing a mapping beyond the end of the file faults, so only allow
+    // mapping existing file contents.
+    int fileLength = lengthSync();
+    if (offset + length > fileLength) {
+      throw new RangeError.range(
+          offset + length, 0, fileLength, 'offset + length');
+    }
+    var result = _ops.map(offset, length, advice._value);
+    if (result is OSError) {
+      throw new FileSystemException("map failed", path, result);
+    }
+    return result;
+  }
+
   Future<RandomAccessFile> writeByte(int value) {
     ArgumentError.checkNotNull(value, 'value');
     return _dispatch(_IOService.fileWriteByte, [null, value]).then((response) {
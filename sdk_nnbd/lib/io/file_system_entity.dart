@@ -474,7 +474,8 @@ abstract class FileSystemEntity {
    *   * `Windows`: Uses `ReadDirectoryChangesW`. The implementation only
    *     supports watching directories. Recursive watching is supported.
    *   * `Linux`: Uses `inotify`. The implementation supports watching both
-   *     files and directories. Recursive watching is not supported.
+   *     files and directories. Recursive watching is supported, with a watch
+   *     added for every directory below the watched one.
    *     Note: When watching files directly, delete events might not happen
    *     as expected.
    *   * `OS X`: Uses `FSEvents`. The implementation supports watching both
@@ -492,6 +493,11 @@ abstract class FileSystemEntity {
    *   * System Watcher exits unexpectedly. e.g. On `Windows` this happens when
    *     buffer that receive events from `ReadDirectoryChangesW` overflows.
    *
+   * On `Linux`, when more changes happen than the kernel can queue, the
+   * events of the overflow are lost and the [Stream] gets a
+   * [FileSystemException] error. It keeps delivering later events, but
+   * the watched entity should be scanned again to find the lost changes.
+   *
    * Use `events` to specify what events to listen for. The constants in
    * [FileSystemEvent] can be or'ed together to mix events. Default is
    * [FileSystemEvent.ALL].
@@ -914,6 +920,7 @@ class FileSystemEvent {
   static const int _modifyAttributes = 1 << 4;
   static const int _deleteSelf = 1 << 5;
   static const int _isDir = 1 << 6;
+  static const int _overflow = 1 << 7;
 
   /**
    * The type of event. See [FileSystemEvent] for a list of events.
@@ -638,6 +638,21 @@ abstract class RawSocket implements Stream<RawSocketEvent> {
    */
   Uint8List read([int len]);
 
+  /**
+   * Reads up to `end - start` bytes from the socket into an existing
+   * [buffer] and returns the number of bytes read. This function is
+   * non-blocking and will only read data if data is available.
+   *
+   * If [start] is present, the bytes will be filled into [buffer] from at
+   * index [start], otherwise index 0. If [end] is present, at most
+   * [end] - [start] bytes will be read into [buffer], otherwise up to
+   * [buffer.length]. If no data is available 0 is returned.
+   *
+   * Unlike [read], this does not allocate a new list for every read, so a
+   * single buffer can be reused across reads.
+   */
+  int readInto(List<int> buffer, [int start = 0, int end]);
+
   /**
    * Writes up to [count] bytes of the buffer from [offset] buffer offset to
    * the socket. The number of successfully written bytes is returned. This
@@ -649,6 +664,26 @@ abstract class RawSocket implements Stream<RawSocketEvent> {
    */
   int write(List<int> buffer, [int offset, int count]);
 
+  /**
+   * Writes up to [count] bytes of [file], starting at byte [offset] of the
+   * file, to the socket. The number of successfully written bytes is
+   * returned. This function is non-blocking and will only write data if
+   * buffer space is available in the socket.
+   *
+   * Where the platform supports it (`sendfile` on Linux, Android and macOS)
+   * the file data is transferred by the operating system and never copied
+   * into Dart memory. Elsewhere the data is read from the file and written
+   * as by [write].
+   *
+   * The default value for [count] is the rest of the file from [offset].
+   * A given [count] is not checked against the length of the file, so that
+   * sending does not query it every time: only the bytes before the end of
+   * the file are written. If [offset] is at or past the end of the file and
+   * [count] is not zero, a [FileSystemException] is thrown. The file position
+   * of [file] is not changed.
+   */
+  int sendFile(RandomAccessFile file, int offset, [int count]);
+
   /**
    * Returns the port used by this socket.
    */
@@ -1023,3 +1058,43 @@ class SocketException implements IOException {
     return sb.toString();
   }
 }
+
+// Checks the arguments to [RawSocket.sendFile], and returns the number of
+// bytes to send.
+int _checkSendFileArguments(RandomAccessFile file, int offset, int count) {
+  ArgumentError.checkNotNull(file, 'file');
+  RangeError.checkNotNegative(offset, 'offset');
+  if (count != null) {
+    RangeError.checkNotNegative(count, 'count');
+    return count;
+  }
+  int length = file.lengthSync();
+  RangeError.checkValueInInterval(offset, 0, length, 'offset');
+  return length - offset;
+}
+
+// The error thrown by [RawSocket.sendFile] when there is nothing left to send
+// before the end of [file].
+FileSystemException _sendFileEndOfFile(RandomAccessFile file, int offset) =>
+    new FileSystemException(
+        "Cannot send from offset $offset at or past the end of the file",
+        file.path);
+
+// Implements [RawSocket.sendFile] by reading the file data into memory and
+// writing it to [socket]. Used where the file cannot be handed to the
+// socket directly.
+int _sendFileByCopy(
+    RawSocket socket, RandomAccessFile file, int offset, int count) {
+  const int maxChunkSize = 64 * 1024;
+  if (count == 0) return 0;
+  int position = file.positionSync();
+  List<int> data;
+  try {
+    file.setPositionSync(offset);
+    data = file.readSync(min(count, maxChunkSize));
+  } finally {
+    file.setPositionSync(position);
+  }
+  if (data.isEmpty) throw _sendFileEndOfFile(file, offset);
+  return socket.write(data);
+}
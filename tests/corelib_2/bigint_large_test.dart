@@ -0,0 +1,83 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Multiplies, parses and prints bigints that are large enough for the VM to
+// split them in halves.
+// VMOptions=--intrinsify --enable-asserts
+// VMOptions=--no-intrinsify --enable-asserts
+
+import "package:expect/expect.dart";
+
+// A number with [digits] decimal digits that cycle through "1234567890".
+BigInt cyclic(int digits) {
+  var buffer = new StringBuffer();
+  for (int i = 0; i < digits; i++) {
+    buffer.write((i + 1) % 10);
+  }
+  return BigInt.parse(buffer.toString());
+}
+
+testMultiply(BigInt a, BigInt b) {
+  var product = a * b;
+  Expect.equals(product, b * a);
+  Expect.equals(a, product ~/ b);
+  Expect.equals(BigInt.zero, product % b);
+  Expect.equals(product + b, (a + BigInt.one) * b);
+  Expect.equals(-product, -a * b);
+  Expect.equals(product, -a * -b);
+  // Compare with multiplying the low and high halves of a separately.
+  var shift = a.bitLength ~/ 2;
+  var low = a & ((BigInt.one << shift) - BigInt.one);
+  var high = a >> shift;
+  Expect.equals(product, ((high * b) << shift) + low * b);
+  for (var m in [1000000007, 4294967291]) {
+    var modulus = new BigInt.from(m);
+    Expect.equals(product % modulus, (a % modulus) * (b % modulus) % modulus);
+  }
+}
+
+testSquare(BigInt a) {
+  var square = a * a;
+  Expect.equals(square, a * (a + BigInt.zero));
+  Expect.equals(a, square ~/ a);
+}
+
+testDecimal(BigInt a) {
+  var string = a.toString();
+  Expect.equals(a, BigInt.parse(string));
+  Expect.equals(a, BigInt.parse(a.toRadixString(16), radix: 16));
+  Expect.equals("-$string", (-a).toString());
+  Expect.equals(-a, BigInt.parse("-$string"));
+}
+
+main() {
+  var sizes = [1, 100, 700, 800, 1000, 1500, 3000, 10000];
+  for (var x in sizes) {
+    for (var y in sizes) {
+      testMultiply(cyclic(x), cyclic(y) + BigInt.one);
+    }
+    testSquare(cyclic(x));
+    testDecimal(cyclic(x));
+  }
+
+  for (var digits in [9, 300, 1152, 2305, 9216, 20000]) {
+    var power = BigInt.from(10).pow(digits);
+    Expect.equals("1" + "0" * digits, power.toString());
+    Expect.equals("9" * digits, (power - BigInt.one).toString());
+    Expect.equals(power, BigInt.parse("1" + "0" * digits));
+    Expect.equals(power, BigInt.parse("0" * 1000 + "1" + "0" * digits));
+    testDecimal(power + BigInt.one);
+    testDecimal(power * power - BigInt.one);
+  }
+
+  // Powers of two have long runs of one-bits and zero-bits in the halves.
+  for (var bits in [2560, 2561, 8192, 30000]) {
+    var power = BigInt.one << bits;
+    testMultiply(power - BigInt.one, power - BigInt.one);
+    testMultiply(power + BigInt.one, power - BigInt.one);
+    testSquare(power - BigInt.one);
+    Expect.equals(BigInt.one << (2 * bits), power * power);
+    testDecimal(power);
+  }
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=
+// VMOptions=--linear_regexp
+// VMOptions=--linear_regexp --interpret_irregexp
+
+// Patterns without back references or lookarounds, which the VM can match in
+// linear time, must find the same matches and captures as a backtracking
+// matcher.
+
+import 'v8_regexp_utils.dart';
+import 'package:expect/expect.dart';
+
+void main() {
+  // Leftmost match, then the first alternative and greedy quantifiers.
+  shouldBe(new RegExp(r"a|ab").firstMatch("xabc"), ["a"]);
+  shouldBe(new RegExp(r"(a|ab)(c|bcd)").firstMatch("abcd"),
+      ["abcd", "a", "bcd"]);
+  shouldBe(new RegExp(r"(a+)(a*)").firstMatch("baaa"), ["aaa", "aaa", ""]);
+  shouldBe(new RegExp(r"(a+?)(a*)").firstMatch("baaa"), ["aaa", "a", "aa"]);
+  shouldBe(new RegExp(r"<(.+?)>").firstMatch("<a><b>"), ["<a>", "a"]);
+  shouldBe(new RegExp(r"(x{2,3})(x*)").firstMatch("xxxxx"),
+      ["xxxxx", "xxx", "xx"]);
+  shouldBe(new RegExp(r"(x{2,3}?)(x*)").firstMatch("xxxxx"),
+      ["xxxxx", "xx", "xxx"]);
+  shouldBe(new RegExp(r"a{3}").firstMatch("aa aaaa"), ["aaa"]);
+
+  // Captures in a quantified expression are reset on every iteration.
+  shouldBe(new RegExp(r"(?:(a)|(b)|(c))+").firstMatch("abc"),
+      ["abc", null, null, "c"]);
+  shouldBe(new RegExp(r"(?:(a)|b)+").firstMatch("ab"), ["ab", null]);
+  shouldBe(new RegExp(r"((a)|b)+").firstMatch("ba"), ["ba", "a", "a"]);
+
+  // Anchors and word boundaries.
+  shouldBe(new RegExp(r"^\w+$").firstMatch("abc\ndef"), null);
+  shouldBe(new RegExp(r"^\w+$", multiLine: true).firstMatch("a b\ndef"),
+      ["def"]);
+  shouldBe(new RegExp(r"\bfoo\b").firstMatch("foobar foo"), ["foo"]);
+  Expect.equals(7, new RegExp(r"\bfoo\b").firstMatch("foobar foo").start);
+  shouldBe(new RegExp(r"\Boo").firstMatch("oo foo"), ["oo"]);
+  Expect.equals(4, new RegExp(r"\Boo").firstMatch("oo foo").start);
+
+  // Character classes, case and dots.
+  shouldBe(new RegExp(r"[^a-c]+").firstMatch("abcdefabc"), ["def"]);
+  shouldBe(new RegExp(r"[a-c]+", caseSensitive: false).firstMatch("xAbCx"),
+      ["AbC"]);
+  shouldBe(new RegExp(r"hello", caseSensitive: false).firstMatch("Say HeLLo"),
+      ["HeLLo"]);
+  shouldBe(new RegExp(r"a.b").firstMatch("a\nb a-b"), ["a-b"]);
+  shouldBe(new RegExp(r"a.b", dotAll: true).firstMatch("a\nb"), ["a\nb"]);
+  shouldBe(new RegExp(r"[\d.]+").firstMatch("v1.25"), ["1.25"]);
+  shouldBe(new RegExp(r"é+€").firstMatch("aéé€"), ["éé€"]);
+
+  // Matches from a start index, and at it.
+  var pattern = new RegExp(r"\d+");
+  Expect.listEquals(["12", "345", "6"],
+      pattern.allMatches("a12b345c6").map((m) => m.group(0)).toList());
+  Expect.isNull(pattern.matchAsPrefix("a12", 0));
+  Expect.equals("12", pattern.matchAsPrefix("a12", 1).group(0));
+  Expect.equals("", new RegExp(r"x*").firstMatch("abc").group(0));
+  Expect.listEquals(["a", "b", "c"], "a,b,,c".split(new RegExp(r",+")));
+
+  // A typical log line.
+  var line = "2019-11-05 12:34:56.789 WARNING [main] Disk usage at 91%";
+  shouldBe(
+      new RegExp(r"^(\d{4})-(\d\d)-(\d\d) ([\d:.]+) (INFO|WARNING|ERROR) "
+              r"\[(\w+)\] (.*)$")
+          .firstMatch(line),
+      [
+        line,
+        "2019",
+        "11",
+        "05",
+        "12:34:56.789",
+        "WARNING",
+        "main",
+        "Disk usage at 91%"
+      ]);
+
+  // Patterns that backtrack a lot.
+  var as = "a" * 20;
+  Expect.isNull(new RegExp(r"(a+)+b").firstMatch(as));
+  Expect.isNull(new RegExp(r"(a|aa)+c").firstMatch(as));
+  shouldBe(new RegExp(r"(a|aa)+$").firstMatch(as), [as, "a"]);
+
+  // Patterns that need backtracking still work.
+  shouldBe(new RegExp(r"(a)\1").firstMatch("xaa"), ["aa", "a"]);
+  shouldBe(new RegExp(r"a(?=b)").firstMatch("acab"), ["a"]);
+  shouldBe(new RegExp(r"(a*)*b").firstMatch("aab"), ["aab", "aa"]);
+  shouldBe(new RegExp(r"(a|)+b").firstMatch("aab"), ["aab", "a"]);
+}
@@ -0,0 +1,66 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=
+// VMOptions=--interpret_irregexp
+
+// Unanchored searches skip ahead to the characters a match must contain,
+// scanning long subjects many characters at a time. They must find the same
+// matches as trying every position in turn.
+
+import 'package:expect/expect.dart';
+
+// The starts of the matches of [pattern] in [string], found by trying the
+// pattern at every position in turn.
+List<int> slowMatchStarts(RegExp pattern, String string) {
+  var starts = <int>[];
+  var i = 0;
+  while (i <= string.length) {
+    var match = pattern.matchAsPrefix(string, i);
+    if (match == null) {
+      i++;
+    } else {
+      starts.add(i);
+      i = match.end > i ? match.end : i + 1;
+    }
+  }
+  return starts;
+}
+
+void test(String source, String filler, List<String> needles,
+    {bool caseSensitive: true}) {
+  var pattern = new RegExp(source, caseSensitive: caseSensitive);
+  var string = filler * (200 ~/ filler.length);
+  for (var needle in needles) {
+    for (var i = 0; i + needle.length <= string.length; i += 13) {
+      var haystack = string.replaceRange(i, i + needle.length, needle);
+      Expect.listEquals(slowMatchStarts(pattern, haystack),
+          pattern.allMatches(haystack).map((m) => m.start).toList(),
+          "'$source' in '$haystack'");
+    }
+  }
+}
+
+main() {
+  // Literals, with characters that are equal modulo 128.
+  test(r"xyz", "abcdefgh", ["xyz", "xy", "øyz", "xyú", "xyzxyz"]);
+  test(r"xyz", "ab€defgh", ["xyz", "Ǹyz", "øùz"]);
+  test(r"needle", "haystack", ["needle", "needl", "eneedle"]);
+  test(r"foo\d+", "foobar 1", ["foo12", "foo", "fïo1"]);
+
+  // Small character classes and case-insensitive literals.
+  test(r"[xy]z", "abcdefgh", ["xz", "yz", "zz", "xyz"]);
+  test(r"hello", "the world ", ["hello", "HeLLo", "hell"],
+      caseSensitive: false);
+  test(r"abc|abd", "xyzxyz", ["abc", "abd", "abe", "ab"]);
+
+  // Larger classes, and patterns with many characters at each position.
+  test(r"[0-9a-f]{4}-", "ghijklmn", ["12ab-", "12ab", "12abc-"]);
+  test(r"(?:err|warn|info)ing", "........", ["erring", "warning", "infos"]);
+
+  // Matches at the end of the subject.
+  Expect.equals(97, ("." * 97 + "xyz").indexOf(new RegExp(r"xyz")));
+  Expect.equals(-1, ("." * 98 + "xy").indexOf(new RegExp(r"xyz")));
+  Expect.equals(-1, ("." * 98 + "€").indexOf(new RegExp(r"¬yz")));
+}
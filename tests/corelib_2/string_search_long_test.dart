@@ -0,0 +1,76 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Searches, compares and splits strings that are long enough for the VM to
+// use its native implementations, in one-byte and two-byte combinations.
+
+import "package:expect/expect.dart";
+
+const length = 100;
+
+// The index of [pattern] in [string] from [start], found one position at a
+// time.
+int slowIndexOf(String string, String pattern, int start) {
+  for (int i = start; i + pattern.length <= string.length; i++) {
+    if (string.substring(i, i + pattern.length) == pattern) return i;
+  }
+  return -1;
+}
+
+void testIndexOf(String filler, String pattern) {
+  var string = filler * (length ~/ filler.length);
+  for (int i = 0; i + pattern.length <= string.length; i += 7) {
+    var haystack = string.replaceRange(i, i + pattern.length, pattern);
+    for (var start in [0, i ~/ 2, i, i + 1, haystack.length]) {
+      var expected = slowIndexOf(haystack, pattern, start);
+      Expect.equals(expected, haystack.indexOf(pattern, start),
+          "'$pattern' in '$haystack' from $start");
+      Expect.equals(expected >= 0, haystack.contains(pattern, start));
+    }
+  }
+  Expect.equals(0, string.indexOf(""));
+  Expect.equals(10, string.indexOf("", 10));
+  Expect.equals(string.length, string.indexOf("", string.length));
+}
+
+void testEquality(String filler) {
+  var string = filler * (length ~/ filler.length);
+  for (int i = 0; i < string.length; i++) {
+    var copy = new String.fromCharCodes(string.codeUnits);
+    Expect.isTrue(string == copy);
+    var changed = string.replaceRange(i, i + 1, "#");
+    Expect.isFalse(string == changed, "at $i");
+    Expect.isFalse(changed == string, "at $i");
+    Expect.isFalse(string == string.substring(0, i));
+  }
+}
+
+void testSplit() {
+  var fields = new List<String>.generate(20, (i) => "field" * i);
+  Expect.listEquals(fields, fields.join(",").split(","));
+  Expect.listEquals(["", ""], ",".split(","));
+  var noSeparator = "a" * length;
+  Expect.listEquals([noSeparator], noSeparator.split(","));
+}
+
+main() {
+  // One-byte and two-byte strings and patterns, with patterns that start with
+  // a frequent code unit.
+  testIndexOf("abcdefgh", "xyz");
+  testIndexOf("abcdefgh", "abx");
+  testIndexOf("abcdefgh", "x");
+  testIndexOf("abcdefgh", "€");
+  testIndexOf("abcdefgh", "a€");
+  testIndexOf("ab€defgh", "xyz");
+  testIndexOf("ab€defgh", "€x");
+  testIndexOf("ab€defgh", "€");
+  testIndexOf("ab€defgh", "é");
+  testIndexOf("aaaaaaaa", "aaab");
+  testIndexOf("€€€", "€€x");
+
+  testEquality("abcdefgh");
+  testEquality("ab€defgh");
+
+  testSplit();
+}
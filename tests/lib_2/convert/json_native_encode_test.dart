@@ -0,0 +1,219 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Objects encoded to compact JSON, which the VM encodes natively, must give
+// the same text as the Dart stringifiers, which encode them in chunks.
+
+import "dart:collection";
+import "dart:convert";
+import "dart:typed_data";
+
+import "package:expect/expect.dart";
+
+class ToJson {
+  final value;
+  ToJson(this.value);
+  toJson() => value;
+}
+
+class Custom {
+  final value;
+  Custom(this.value);
+}
+
+var toJsonCalls = 0;
+
+// Counts calls to toJson, which throws exceptions it is given.
+class Counted {
+  final value;
+  Counted(this.value);
+  toJson() {
+    toJsonCalls++;
+    if (value is Exception) throw value;
+    return value;
+  }
+}
+
+String dartEncode(object, toEncodable(o)) {
+  String result;
+  var sink = new JsonEncoder(toEncodable).startChunkedConversion(
+      new StringConversionSink.withCallback((text) => result = text));
+  sink.add(object);
+  sink.close();
+  return result;
+}
+
+List<int> dartEncodeUtf8(object, toEncodable(o)) {
+  List<int> result;
+  var sink = new JsonUtf8Encoder(null, toEncodable).startChunkedConversion(
+      new ByteConversionSink.withCallback((bytes) => result = bytes));
+  sink.add(object);
+  sink.close();
+  return result;
+}
+
+void test(object, [toEncodable(o)]) {
+  Expect.equals(dartEncode(object, toEncodable),
+      new JsonEncoder(toEncodable).convert(object));
+  Expect.listEquals(dartEncodeUtf8(object, toEncodable),
+      new JsonUtf8Encoder(null, toEncodable).convert(object));
+}
+
+// Objects the VM leaves to the Dart stringifiers after calling toJson must
+// not have toJson called again.
+void testCalls(object, int expected) {
+  for (var encode in [
+    (o) => dartEncode(o, null),
+    (o) => dartEncodeUtf8(o, null),
+    json.encode,
+    new JsonUtf8Encoder().convert,
+  ]) {
+    toJsonCalls = 0;
+    try {
+      encode(object);
+    } on JsonUnsupportedObjectError {
+      // Calls before the error count too.
+    }
+    Expect.equals(expected, toJsonCalls, "$object");
+  }
+}
+
+void testError(object, [toEncodable(o)]) {
+  var expected;
+  try {
+    dartEncode(object, toEncodable);
+    Expect.fail("Encoded $object");
+  } on JsonUnsupportedObjectError catch (e) {
+    expected = e;
+  }
+  matches(e) =>
+      e.runtimeType == expected.runtimeType &&
+      e.cause?.runtimeType == expected.cause?.runtimeType;
+  Expect.throws(() => new JsonEncoder(toEncodable).convert(object), matches);
+  Expect.throws(
+      () => new JsonUtf8Encoder(null, toEncodable).convert(object), matches);
+}
+
+main() {
+  // Values.
+  for (var value in [
+    null, true, false, 0, 1, -1, 42, 9007199254740991, -9007199254740991,
+    0.0, -0.0, 0.5, -12.75, 0.1, 1e21, 1e-7, 123456789.125, 1.0,
+    double.maxFinite, double.minPositive, [], {}, [[]], [{}],
+  ]) {
+    test(value);
+  }
+
+  // Strings.
+  var controls = new String.fromCharCodes(new List.generate(0x21, (i) => i));
+  for (var value in [
+    "", "abc", controls, '"\\/\x7F', "é€😀", "ÿ", "\ud800", "a\udc00b",
+    "􏿿", "\udc00\ud800", "x" * 100 + "é" + "y" * 33 + '"z',
+    "€" * 40 + "\n" + "x" * 40, "a" * 15 + "\\", "a" * 16 + "\x00",
+  ]) {
+    test(value);
+    test([value, value]);
+    test({value: value});
+  }
+
+  // Lists and maps of every kind.
+  var growable = [1, "a", null];
+  growable.add(2.5);
+  var removed = {"a": 1, "b": 2, "c": 3};
+  removed.remove("b");
+  var many = {};
+  for (var i = 0; i < 100; i++) {
+    many["k$i"] = i;
+  }
+  for (var i = 0; i < 100; i += 3) {
+    many.remove("k$i");
+  }
+  for (var value in [
+    growable, new List(3), new List.filled(2, true), const [1, 2],
+    new List.unmodifiable([1]), new UnmodifiableListView([1, [2]]),
+    new Uint8List(3), new Float64List(1), removed, many, const {"a": 1},
+    new SplayTreeMap.from({"b": 1, "a": 2}), new HashMap.from({"a": 1}),
+    new Map.unmodifiable({"a": [1]}), {"a": new Int32List(2)},
+  ]) {
+    test(value);
+    test([value]);
+  }
+
+  // Deep nesting.
+  var deep = [];
+  for (var i = 0; i < 1000; i++) {
+    deep = [deep, i];
+  }
+  test(deep);
+  var deepMap = {};
+  for (var i = 0; i < 1000; i++) {
+    deepMap = {"a": deepMap};
+  }
+  test(deepMap);
+
+  // Objects are replaced by toEncodable, or with toJson.
+  var replaced = [
+    new ToJson(1),
+    new ToJson([new ToJson("a"), new ToJson({"b": new ToJson(null)})]),
+    new ToJson(new UnmodifiableListView([1])),
+  ];
+  test(replaced);
+  test({"x": new Custom(1), "y": [new Custom("a")]}, (o) => o.value);
+  test([new Custom(2), new Custom([3])],
+      (o) => o is Custom ? o.value : throw "not custom");
+  test(new Custom(1.5), (o) => {"value": o.value});
+
+  // Errors, and objects the Dart stringifiers pass to toEncodable.
+  testError(new Custom(1));
+  testError(double.nan);
+  testError([1, double.infinity]);
+  testError({1: 2});
+  testError({"a": 1, 2: "b"});
+  testError(new ToJson(double.negativeInfinity));
+  testError(new ToJson(new ToJson(1)));
+  testError([new Custom(1)], (o) => throw "failed");
+  var cyclic = [];
+  cyclic.add([cyclic]);
+  testError(cyclic);
+  var cyclicMap = {};
+  cyclicMap["a"] = cyclicMap;
+  testError(cyclicMap);
+  var toSelf;
+  toSelf = new ToJson([1]);
+  toSelf.value.add(toSelf);
+  testError(toSelf);
+  test({1: 2}, (o) => o.map((k, v) => new MapEntry("$k", v)));
+  test(double.nan, (o) => "NaN");
+
+  // Every way of giving up after toJson has been called.
+  testCalls([new Counted(1), new Counted(2), "\ud800"], 2);
+  testCalls([new Counted(1), new Counted("\ud800"), new Counted(2)], 3);
+  testCalls([new Counted(1), double.nan, new Counted(2)], 1);
+  testCalls([new Counted(1), new Counted(double.nan), new Counted(2)], 2);
+  testCalls([new Counted(1), {1: new Counted(2)}, new Counted(3)], 1);
+  testCalls([
+    new Counted(1),
+    new Counted(new FormatException("toJson")),
+    new Counted(2)
+  ], 2);
+  testCalls([new Counted(1), cyclic, new Counted(2)], 1);
+  testCalls([
+    new Counted(1),
+    new UnmodifiableListView([new Counted(2)]),
+    new Counted(3)
+  ], 3);
+  var deepCounted = [new Counted(0)];
+  for (var i = 0; i < 300; i++) {
+    deepCounted = [new Counted(i), deepCounted, new Counted(i)];
+  }
+  testCalls(deepCounted, 601);
+  var toSelfCounted = new Counted([]);
+  toSelfCounted.value.add(toSelfCounted);
+  testCalls([new Counted(1), toSelfCounted, new Counted(2)], 2);
+
+  // The UTF-8 encoding is a list of bytes.
+  Expect.isTrue(json.fuse(utf8).encode([1]) is List<int>);
+  Expect.listEquals([0x5B, 0x22, 0xC3, 0xA9, 0x22, 0x5D],
+      new JsonUtf8Encoder().convert(["é"]));
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Documents decoded without a reviver, which the VM decodes natively, must
+// give the same values as the Dart parser, which decodes them with a reviver.
+
+import "dart:convert";
+import "dart:typed_data";
+
+import "package:expect/expect.dart";
+
+final utf8Json = utf8.decoder.fuse(json.decoder);
+
+void compare(expected, actual, String path) {
+  if (expected is List) {
+    Expect.isTrue(actual is List<dynamic>, path);
+    Expect.equals(expected.length, actual.length, "$path: length");
+    for (var i = 0; i < expected.length; i++) {
+      compare(expected[i], actual[i], "$path[$i]");
+    }
+  } else if (expected is Map) {
+    Expect.isTrue(actual is Map<String, dynamic>, path);
+    // Keys keep the order they were first seen in.
+    Expect.listEquals(expected.keys.toList(), actual.keys.toList(), path);
+    for (var key in expected.keys) {
+      Expect.isTrue(actual.containsKey(key), "$path: $key");
+      compare(expected[key], actual[key], "$path[$key]");
+    }
+  } else if (expected is num) {
+    Expect.equals(expected is int, actual is int, "$path: $actual");
+    Expect.identical(expected, actual, path);
+  } else {
+    Expect.equals(expected, actual, path);
+  }
+}
+
+void test(String text) {
+  var expected = json.decode(text, reviver: (key, value) => value);
+  compare(expected, json.decode(text), text);
+  var bytes = new Uint8List.fromList(utf8.encode(text));
+  compare(expected, utf8Json.convert(bytes), text);
+}
+
+void testError(String text) {
+  var expected;
+  try {
+    json.decode(text, reviver: (key, value) => value);
+    Expect.fail("Accepted $text");
+  } on FormatException catch (e) {
+    expected = e;
+  }
+  Expect.throws(() => json.decode(text), (e) {
+    return e is FormatException &&
+        e.message == expected.message &&
+        e.offset == expected.offset;
+  }, text);
+  Expect.throws(
+      () => utf8Json.convert(new Uint8List.fromList(utf8.encode(text))),
+      (e) => e is FormatException,
+      text);
+}
+
+main() {
+  // Values.
+  for (var text in [
+    'null', 'true', 'false', '""', '"abc"', '[]', '{}', ' \t\r\n[ ] \n',
+    '[1, "a", null, true, false, [], {}]', '{"a": {"b": [{"c": []}]}}',
+  ]) {
+    test(text);
+  }
+
+  // Numbers.
+  for (var text in [
+    '0', '-0', '0.0', '-0.0', '1', '-1', '123456789', '0.5', '-12.75',
+    '1e3', '1E+3', '1e-3', '2.5e-7', '4.35', '0.1', '123.456e22',
+    '9007199254740992', '9007199254740993.0', '9223372036854775807',
+    '-9223372036854775808', '9223372036854775808', '-9223372036854775809',
+    '12345678901234567890', '1.7976931348623157e308', '1.8e308', '5e-324',
+    '2e-324', '1e400', '-1e400', '1e401', '0e401', '1e-401', '-0e-401',
+    '0.000000000000000000000000001', '1234567890123456789012.5',
+  ]) {
+    test(text);
+  }
+
+  // Strings.
+  for (var text in [
+    r'"\"\\\/\b\f\n\r\t"', r'"Aé€😀"', r'"\ud800"',
+    '"é€😀"', '"ÿĀ"', '"${"x" * 100}é${"y" * 100}"',
+    '{"é": "€", "key": "${"v" * 40}\\n"}',
+  ]) {
+    test(text);
+  }
+
+  // Maps with many keys, and repeated keys.
+  var keys = new List.generate(300, (i) => '"k$i": $i');
+  test('{${keys.join(", ")}}');
+  test('{"a": 1, "b": 2, "a": 3}');
+  test('{"a": 1, "b": 2, "a": {"x": 1, "x": 2}, "c": 4, "b": 5}');
+  test('[${new List.generate(1000, (i) => '{"id": $i}').join(",")}]');
+
+  // Decoded maps and lists are growable, and maps rehash as usual.
+  var value = json.decode('{"list": [1, 2], "a": 1, "b": 2}');
+  value["list"].add(3);
+  Expect.listEquals([1, 2, 3], value["list"]);
+  for (var i = 0; i < 100; i++) {
+    value["x$i"] = i;
+  }
+  value.remove("a");
+  Expect.equals(2, value["b"]);
+  Expect.equals(99, value["x99"]);
+  Expect.equals(102, value.length);
+
+  // Deep nesting.
+  test("[" * 1000 + "]" * 1000);
+  test('{"a":' * 1000 + "0" + "}" * 1000);
+
+  // A byte order mark starts UTF-8 documents, not strings.
+  var bom = [0xEF, 0xBB, 0xBF];
+  Expect.listEquals([1],
+      utf8Json.convert(new Uint8List.fromList(bom + utf8.encode("[1]"))));
+  Expect.throws(() => json.decode("\uFEFF[1]"), (e) => e is FormatException);
+
+  // Errors.
+  for (var text in [
+    '', ' ', '[', ']', '[1,]', '[1 2]', '{"a"}', '{"a":}', '{"a":1,}', '{1:2}',
+    "{'a':1}", '01', '-', '1.', '.5', '1e', '1e+', '+1', 'tru', 'nul', 'NaN',
+    '"abc', '"\t"', r'"\x"', r'"\u12"', r'"\u12g4"', '[1]]', '1 2', '"a" x',
+  ]) {
+    testError(text);
+  }
+
+  // Malformed UTF-8 is left to the Dart parser.
+  for (var allowMalformed in [false, true]) {
+    var utf8Decoder = new Utf8Decoder(allowMalformed: allowMalformed);
+    var nativeDecoder = utf8Decoder.fuse(json.decoder);
+    var dartDecoder = utf8Decoder.fuse(new JsonDecoder((key, value) => value));
+    for (var bytes in [
+      [0x22, 0xC0, 0x80, 0x22],
+      [0x22, 0xE0, 0x80, 0x80, 0x22],
+      [0x22, 0xED, 0xA0, 0x80, 0x22],
+      [0x22, 0xF4, 0x90, 0x80, 0x80, 0x22],
+      [0x22, 0xC3, 0x22],
+      [0x22, 0xFF, 0x22],
+    ]) {
+      var input = new Uint8List.fromList(bytes);
+      var expected;
+      try {
+        expected = dartDecoder.convert(input);
+      } on FormatException {
+        Expect.throws(
+            () => nativeDecoder.convert(input), (e) => e is FormatException);
+        continue;
+      }
+      compare(expected, nativeDecoder.convert(input), "$bytes");
+    }
+  }
+}
@@ -0,0 +1,51 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Decodes long runs of ASCII with a single non-ASCII character at every
+// position, from Uint8Lists, views of them, unmodifiable views and plain
+// lists.
+
+import 'dart:convert';
+import 'dart:typed_data';
+
+import "package:expect/expect.dart";
+
+const length = 200;
+
+void check(String expected, List<int> bytes) {
+  Expect.equals(expected, utf8.decode(bytes));
+  Expect.equals(expected, utf8.decode(bytes, allowMalformed: true));
+}
+
+main() {
+  var ascii = new String.fromCharCodes(
+      new List<int>.generate(length, (i) => 0x20 + i % 0x5f));
+  var bytes = new Uint8List.fromList(utf8.encode(ascii));
+  check(ascii, bytes);
+  check(ascii, new Uint8List.view(bytes.buffer, 0, length));
+  // Uint8Lists that are not the VM's own typed data are scanned in Dart.
+  check(ascii, new UnmodifiableUint8ListView(bytes));
+
+  for (int i = 0; i < length; i++) {
+    for (var char in ["é", "€", "\u{1d11e}"]) {
+      var string = ascii.replaceRange(i, i + 1, char);
+      var encoded = new Uint8List.fromList(utf8.encode(string));
+      check(string, encoded);
+      check(string, encoded.toList());
+      check(string, new UnmodifiableUint8ListView(encoded));
+      // A view that starts in the middle of a buffer.
+      var padded = new Uint8List(encoded.length + 3);
+      padded.setRange(3, padded.length, encoded);
+      check(string, new Uint8List.view(padded.buffer, 3, encoded.length));
+      // A range that starts with the non-ASCII character.
+      Expect.equals(string.substring(i), utf8.decoder.convert(encoded, i));
+    }
+    // Malformed input is still found after a run of ASCII.
+    var malformed = new Uint8List.fromList(bytes);
+    malformed[i] = 0xff;
+    Expect.throws(() => utf8.decode(malformed), (e) => e is FormatException);
+    Expect.equals(ascii.replaceRange(i, i + 1, "\ufffd"),
+        utf8.decode(malformed, allowMalformed: true));
+  }
+}
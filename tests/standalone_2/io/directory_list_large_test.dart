@@ -0,0 +1,58 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Lists directories with more entries than fit in one response from the IO
+// service, or in one read of the directory.
+
+import 'dart:io';
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int directoryCount = 5;
+const int filesPerDirectory = 1500;
+
+Set<String> createTree(Directory root) {
+  var expected = new Set<String>();
+  for (int i = 0; i < directoryCount; i++) {
+    var dir = new Directory('${root.path}/dir$i')..createSync();
+    expected.add(dir.path);
+    for (int j = 0; j < filesPerDirectory; j++) {
+      // Long names so the entries do not fit in one getdents64 buffer.
+      var file = new File('${dir.path}/file_${'x' * 40}_$j')..createSync();
+      expected.add(file.path);
+    }
+  }
+  var link = new Link('${root.path}/link')..createSync('${root.path}/dir0');
+  expected.add(link.path);
+  return expected;
+}
+
+main() async {
+  asyncStart();
+  var root = Directory.systemTemp.createTempSync('dart_directory_list_large');
+  try {
+    var expected = createTree(root);
+
+    var listed = await root
+        .list(recursive: true, followLinks: false)
+        .map((e) => e.path)
+        .toList();
+    Expect.equals(expected.length, listed.length);
+    Expect.setEquals(expected, listed);
+
+    listed = root
+        .listSync(recursive: true, followLinks: false)
+        .map((e) => e.path)
+        .toList();
+    Expect.equals(expected.length, listed.length);
+    Expect.setEquals(expected, listed);
+
+    var files = await new Directory('${root.path}/dir1').list().length;
+    Expect.equals(filesPerDirectory, files);
+  } finally {
+    root.deleteSync(recursive: true);
+  }
+  asyncEnd();
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Test RandomAccessFile.mapSync.
+
+import "dart:io";
+import "dart:typed_data";
+
+import "package:expect/expect.dart";
+
+// Larger than the 64 KB mapping alignment so unaligned offsets are covered.
+const fileSize = 200 * 1024 + 3;
+
+Uint8List createContents() {
+  var contents = new Uint8List(fileSize);
+  for (int i = 0; i < fileSize; i++) {
+    contents[i] = (i * 7 + (i >> 8)) & 0xff;
+  }
+  return contents;
+}
+
+void testMap(RandomAccessFile file, Uint8List contents) {
+  void check(int offset, int length, [FileMapAdvice advice]) {
+    var mapped = advice == null
+        ? file.mapSync(offset, length)
+        : file.mapSync(offset, length, advice: advice);
+    Expect.equals(length, mapped.length);
+    Expect.listEquals(contents.sublist(offset, offset + length), mapped);
+  }
+
+  check(0, fileSize);
+  check(0, 1);
+  check(fileSize - 1, 1);
+  check(1, fileSize - 1, FileMapAdvice.sequential);
+  check(64 * 1024 - 5, 10, FileMapAdvice.random);
+  check(100000, 50000, FileMapAdvice.willNeed);
+  check(12345, 54321, FileMapAdvice.normal);
+}
+
+void testWritesArePrivate(RandomAccessFile file, Uint8List contents) {
+  var mapped = file.mapSync(0, 10);
+  mapped[0] = contents[0] ^ 0xff;
+  Expect.equals(contents[0] ^ 0xff, mapped[0]);
+  Expect.equals(contents[0], file.mapSync(0, 10)[0]);
+  file.setPositionSync(0);
+  Expect.equals(contents[0], file.readByteSync());
+}
+
+void testOutlivesFile(String path, Uint8List contents) {
+  var file = new File(path).openSync();
+  var mapped = file.mapSync(1000, 2000);
+  file.closeSync();
+  Expect.listEquals(contents.sublist(1000, 3000), mapped);
+  Expect.throws(() => file.mapSync(0, 1), (e) => e is FileSystemException);
+}
+
+void testArguments(RandomAccessFile file) {
+  Expect.throws(() => file.mapSync(-1, 1));
+  Expect.throws(() => file.mapSync(0, 0));
+  Expect.throws(() => file.mapSync(0, -1));
+  Expect.throws(() => file.mapSync(0, fileSize + 1));
+  Expect.throws(() => file.mapSync(fileSize, 1));
+  Expect.throws(() => file.mapSync(0, 1, advice: null));
+}
+
+main() {
+  var tempDir = Directory.systemTemp.createTempSync('dart_file_map');
+  var contents = createContents();
+  var path = '${tempDir.path}${Platform.pathSeparator}data';
+  new File(path).writeAsBytesSync(contents);
+  var file = new File(path).openSync();
+  try {
+    testMap(file, contents);
+    testWritesArePrivate(file, contents);
+    testArguments(file);
+    testOutlivesFile(path, contents);
+  } finally {
+    file.closeSync();
+    tempDir.deleteSync(recursive: true);
+  }
+}
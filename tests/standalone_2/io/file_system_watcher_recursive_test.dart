@@ -0,0 +1,107 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Tests recursive watching on Linux, where the watches for subdirectories,
+// the pairing of renames and the coalescing of repeated events are done
+// natively.
+
+import "dart:async";
+import "dart:io";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+import "package:path/path.dart";
+
+// Collects events until one matching [done] arrives.
+Future<List<FileSystemEvent>> collect(
+    Stream<FileSystemEvent> watcher, bool done(FileSystemEvent event)) {
+  var events = <FileSystemEvent>[];
+  var completer = new Completer<List<FileSystemEvent>>();
+  StreamSubscription sub;
+  sub = watcher.listen((event) {
+    events.add(event);
+    if (done(event)) {
+      sub.cancel();
+      completer.complete(events);
+    }
+  }, onError: completer.completeError);
+  return completer.future;
+}
+
+Future testNested() async {
+  var dir = Directory.systemTemp.createTempSync('dart_watcher_recursive');
+  try {
+    new Directory(join(dir.path, 'a', 'b')).createSync(recursive: true);
+    var watcher = dir.watch(recursive: true);
+    var events = collect(watcher, (e) => e.path.endsWith('done'));
+    // Give the watcher a chance to install its watches.
+    await new Future.delayed(const Duration(milliseconds: 100));
+    new File(join(dir.path, 'a', 'b', 'file')).createSync();
+    // A directory created after the watch started, with contents created
+    // before its own watch could be installed.
+    new Directory(join(dir.path, 'c', 'd')).createSync(recursive: true);
+    new File(join(dir.path, 'c', 'd', 'file')).createSync();
+    new File(join(dir.path, 'c', 'd', 'done')).createSync();
+    var paths = (await events)
+        .where((e) => e is FileSystemCreateEvent)
+        .map((e) => e.path)
+        .toSet();
+    Expect.isTrue(paths.contains(join(dir.path, 'a', 'b', 'file')));
+    Expect.isTrue(paths.contains(join(dir.path, 'c')));
+    Expect.isTrue(paths.contains(join(dir.path, 'c', 'd', 'done')));
+  } finally {
+    dir.deleteSync(recursive: true);
+  }
+}
+
+Future testRenameBetweenSubdirectories() async {
+  var dir = Directory.systemTemp.createTempSync('dart_watcher_recursive');
+  try {
+    new Directory(join(dir.path, 'a')).createSync();
+    new Directory(join(dir.path, 'b')).createSync();
+    var file = new File(join(dir.path, 'a', 'file'));
+    file.createSync();
+    var watcher = dir.watch(recursive: true, events: FileSystemEvent.move);
+    var events = collect(watcher, (e) => e is FileSystemMoveEvent);
+    await new Future.delayed(const Duration(milliseconds: 100));
+    file.renameSync(join(dir.path, 'b', 'file'));
+    var move = (await events).last as FileSystemMoveEvent;
+    Expect.equals(join(dir.path, 'a', 'file'), move.path);
+    Expect.equals(join(dir.path, 'b', 'file'), move.destination);
+  } finally {
+    dir.deleteSync(recursive: true);
+  }
+}
+
+Future testRepeatedModify() async {
+  var dir = Directory.systemTemp.createTempSync('dart_watcher_recursive');
+  try {
+    var file = new File(join(dir.path, 'file'));
+    file.createSync();
+    var watcher = dir.watch(recursive: true);
+    var events = collect(watcher, (e) => e.path.endsWith('done'));
+    await new Future.delayed(const Duration(milliseconds: 100));
+    for (int i = 0; i < 100; i++) {
+      file.writeAsStringSync('$i');
+    }
+    new File(join(dir.path, 'done')).createSync();
+    var modifies = (await events)
+        .where((e) => e is FileSystemModifyEvent && e.path == file.path)
+        .length;
+    // Repeated modifications read in one batch are reported once.
+    Expect.isTrue(modifies >= 1);
+    Expect.isTrue(modifies < 100);
+  } finally {
+    dir.deleteSync(recursive: true);
+  }
+}
+
+main() async {
+  if (!Platform.isLinux) return;
+  asyncStart();
+  await testNested();
+  await testRenameBetweenSubdirectories();
+  await testRepeatedModify();
+  asyncEnd();
+}
@@ -221,10 +221,6 @@ void testMultipleEvents() {
 
 void testWatchRecursive() {
   var dir = Directory.systemTemp.createTempSync('dart_file_system_watcher');
-  if (Platform.isLinux) {
-    Expect.throws(() => dir.watch(recursive: true));
-    return;
-  }
   var dir2 = new Directory(join(dir.path, 'dir'));
   dir2.createSync();
   var file = new File(join(dir.path, 'dir/file'));
@@ -447,6 +443,32 @@ testWatchOverflow() async {
   isolate.kill();
 }
 
+void testWatchQueueOverflow() {
+  // When more changes happen than inotify can queue, the stream gets an error
+  // and keeps watching.
+  var maxQueuedEvents = int.tryParse(
+      new File('/proc/sys/fs/inotify/max_queued_events')
+          .readAsStringSync()
+          .trim());
+  if (maxQueuedEvents == null || maxQueuedEvents > 100000) return;
+  var dir = Directory.systemTemp.createTempSync('dart_file_system_watcher');
+
+  asyncStart();
+  var sub;
+  sub = dir.watch().listen((event) {}, onError: (e) {
+    Expect.isTrue(e is FileSystemException);
+    Expect.equals(dir.path, e.path);
+    sub.cancel();
+    dir.deleteSync(recursive: true);
+    asyncEnd();
+  });
+
+  // The events are not read before this loop ends.
+  for (int i = 0; i <= maxQueuedEvents; i++) {
+    new File(join(dir.path, 'file$i')).createSync();
+  }
+}
+
 void watcher(SendPort sendPort) async {
   runZoned(() {
     var watcher = Directory.systemTemp.watch(recursive: true);
@@ -473,4 +495,5 @@ void main() {
   testWatchMoveSelf();
   testWatchConsistentModifiedFile();
   if (Platform.isWindows) testWatchOverflow();
+  if (Platform.isLinux) testWatchQueueOverflow();
 }
@@ -0,0 +1,79 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Issues many short file system requests at once, so they are sent to the IO
+// service in batches, and checks that each gets its own response.
+
+import "dart:async";
+import "dart:io";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const fileCount = 200;
+
+main() async {
+  asyncStart();
+  var tempDir = Directory.systemTemp.createTempSync('dart_io_service_batch');
+  try {
+    var files = <File>[];
+    for (int i = 0; i < fileCount; i++) {
+      var file = new File('${tempDir.path}${Platform.pathSeparator}file$i');
+      // Every other file is created, with a length matching its index.
+      if (i.isEven) file.writeAsBytesSync(new List<int>.filled(i, 0));
+      files.add(file);
+    }
+
+    var exists = await Future.wait(files.map((f) => f.exists()));
+    var types = await Future.wait(
+        files.map((f) => FileSystemEntity.type(f.path, followLinks: false)));
+    var stats = await Future.wait(files.map((f) => f.stat()));
+    for (int i = 0; i < fileCount; i++) {
+      Expect.equals(i.isEven, exists[i]);
+      Expect.equals(
+          i.isEven ? FileSystemEntityType.file : FileSystemEntityType.notFound,
+          types[i]);
+      if (i.isEven) {
+        Expect.equals(i, stats[i].size);
+      } else {
+        Expect.equals(FileSystemEntityType.notFound, stats[i].type);
+      }
+    }
+
+    // A mix of batched and unbatched requests.
+    var futures = <Future>[];
+    for (int i = 0; i < fileCount; i += 2) {
+      futures.add(files[i].length());
+      futures.add(files[i].readAsBytes());
+    }
+    var lengths = await Future.wait(futures);
+    for (int i = 0; i < fileCount ~/ 2; i++) {
+      Expect.equals(2 * i, lengths[2 * i]);
+      Expect.equals(2 * i, (lengths[2 * i + 1] as List).length);
+    }
+
+    // Errors are reported per request.
+    futures = <Future>[];
+    for (int i = 0; i < 10; i++) {
+      futures.add(files[i].length().then((l) => l, onError: (e) => e));
+    }
+    var results = await Future.wait(futures);
+    for (int i = 0; i < 10; i++) {
+      if (i.isEven) {
+        Expect.equals(i, results[i]);
+      } else {
+        Expect.isTrue(results[i] is FileSystemException);
+      }
+    }
+
+    // A zone that drops its microtasks does not hold up the batch it starts.
+    runZoned(() => files[0].exists(),
+        zoneSpecification: new ZoneSpecification(
+            scheduleMicrotask: (self, parent, zone, f) {}));
+    Expect.isTrue(await files[2].exists());
+  } finally {
+    tempDir.deleteSync(recursive: true);
+  }
+  asyncEnd();
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--short_socket_read
+// VMOptions=--short_socket_write
+// VMOptions=--short_socket_read --short_socket_write
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const messageSize = 10000;
+
+List<int> createTestData() =>
+    new List<int>.generate(messageSize, (index) => index & 0xff);
+
+// Reads everything the server sends into [buffer] using readInto, in chunks
+// of at most [chunkSize] bytes.
+void testReadInto(List<int> buffer, int chunkSize) {
+  asyncStart();
+  RawServerSocket.bind(InternetAddress.loopbackIPv4, 0).then((server) {
+    server.listen((client) {
+      int bytesWritten = 0;
+      var data = createTestData();
+      client.listen((event) {
+        switch (event) {
+          case RawSocketEvent.write:
+            bytesWritten +=
+                client.write(data, bytesWritten, messageSize - bytesWritten);
+            if (bytesWritten < messageSize) {
+              client.writeEventsEnabled = true;
+            } else {
+              client.shutdown(SocketDirection.send);
+            }
+            break;
+          case RawSocketEvent.read:
+          case RawSocketEvent.readClosed:
+          case RawSocketEvent.closed:
+            break;
+          default:
+            throw "Unexpected event $event";
+        }
+      });
+    });
+
+    RawSocket.connect("127.0.0.1", server.port).then((socket) {
+      int bytesRead = 0;
+      socket.writeEventsEnabled = false;
+      socket.listen((event) {
+        switch (event) {
+          case RawSocketEvent.read:
+            while (socket.available() > 0) {
+              int end = bytesRead + chunkSize;
+              if (end > buffer.length) end = buffer.length;
+              int count = socket.readInto(buffer, bytesRead, end);
+              Expect.isTrue(count >= 0 && count <= end - bytesRead);
+              if (count == 0) break;
+              bytesRead += count;
+            }
+            break;
+          case RawSocketEvent.readClosed:
+            Expect.equals(messageSize, bytesRead);
+            Expect.listEquals(createTestData(), buffer.sublist(0, bytesRead));
+            socket.close();
+            server.close();
+            break;
+          case RawSocketEvent.closed:
+            asyncEnd();
+            break;
+          default:
+            throw "Unexpected event $event";
+        }
+      });
+    });
+  });
+}
+
+void testArguments() {
+  asyncStart();
+  RawServerSocket.bind(InternetAddress.loopbackIPv4, 0).then((server) {
+    server.listen((client) => client.close());
+    RawSocket.connect("127.0.0.1", server.port).then((socket) {
+      var buffer = new Uint8List(10);
+      Expect.throws(() => socket.readInto(buffer, -1, 5));
+      Expect.throws(() => socket.readInto(buffer, 5, 11));
+      Expect.throws(() => socket.readInto(buffer, 6, 5));
+      socket.close();
+      server.close();
+      asyncEnd();
+    });
+  });
+}
+
+main() {
+  testArguments();
+  testReadInto(new Uint8List(messageSize), 1000);
+  testReadInto(new Uint8List(messageSize), messageSize);
+  testReadInto(new List<int>(messageSize), 777);
+  testReadInto(new Uint8List.view(new Uint8List(messageSize + 4).buffer, 4),
+      1024);
+}
@@ -0,0 +1,159 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--short_socket_read
+// VMOptions=--short_socket_write
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const fileSize = 1024 * 1024 + 17;
+
+// Sends [count] bytes starting at [offset] of [file] over a socket with
+// RawSocket.sendFile and checks that the right bytes arrive.
+Future testSendFile(RandomAccessFile file, Uint8List contents, int offset,
+    int count) async {
+  var server = await RawServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  var received = new BytesBuilder(copy: false);
+  var done = new Completer();
+  server.listen((client) {
+    client.listen((event) {
+      switch (event) {
+        case RawSocketEvent.read:
+          var data = client.read();
+          if (data != null) received.add(data);
+          break;
+        case RawSocketEvent.readClosed:
+          client.close();
+          server.close();
+          done.complete();
+          break;
+        default:
+          break;
+      }
+    });
+  });
+
+  var socket =
+      await RawSocket.connect(InternetAddress.loopbackIPv4, server.port);
+  int sent = 0;
+  int position = file.positionSync();
+  socket.listen((event) {
+    switch (event) {
+      case RawSocketEvent.write:
+        // Ranges that end with the file are sent without a count.
+        sent += (offset + count == fileSize)
+            ? socket.sendFile(file, offset + sent)
+            : socket.sendFile(file, offset + sent, count - sent);
+        if (sent < count) {
+          socket.writeEventsEnabled = true;
+        } else {
+          socket.shutdown(SocketDirection.send);
+        }
+        break;
+      case RawSocketEvent.readClosed:
+        socket.close();
+        break;
+      default:
+        break;
+    }
+  });
+  await done.future;
+  Expect.equals(position, file.positionSync());
+  Expect.equals(count, sent);
+  Expect.listEquals(
+      contents.sublist(offset, offset + count), received.takeBytes());
+}
+
+// Sends with a count past the end of [file] until sendFile reports the end.
+Future testSendPastEnd(RandomAccessFile file, Uint8List contents) async {
+  const offset = fileSize - 10;
+  var server = await RawServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  var received = new BytesBuilder(copy: false);
+  var done = new Completer();
+  server.listen((client) {
+    client.listen((event) {
+      if (event == RawSocketEvent.read) {
+        var data = client.read();
+        if (data != null) received.add(data);
+      } else if (event == RawSocketEvent.readClosed) {
+        client.close();
+        server.close();
+        done.complete();
+      }
+    });
+  });
+
+  var socket =
+      await RawSocket.connect(InternetAddress.loopbackIPv4, server.port);
+  int sent = 0;
+  int calls = 0;
+  socket.listen((event) {
+    if (event == RawSocketEvent.write) {
+      calls++;
+      try {
+        sent += socket.sendFile(file, offset + sent, 100 - sent);
+        socket.writeEventsEnabled = true;
+      } on FileSystemException {
+        socket.shutdown(SocketDirection.send);
+      }
+    } else if (event == RawSocketEvent.readClosed) {
+      socket.close();
+    }
+  });
+  await done.future;
+  Expect.equals(10, sent);
+  // Stopped by the end of the file, instead of retrying while the socket
+  // can take more.
+  Expect.isTrue(calls < 100, "$calls");
+  Expect.listEquals(contents.sublist(offset), received.takeBytes());
+}
+
+Future testArguments(RandomAccessFile file) async {
+  var server = await RawServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((client) => client.close());
+  var socket =
+      await RawSocket.connect(InternetAddress.loopbackIPv4, server.port);
+  Expect.throws(() => socket.sendFile(null, 0, 1));
+  Expect.throws(() => socket.sendFile(file, -1, 1));
+  Expect.throws(() => socket.sendFile(file, 0, -1));
+  Expect.throws(() => socket.sendFile(file, fileSize + 1));
+  Expect.equals(0, socket.sendFile(file, fileSize, 0));
+  Expect.equals(0, socket.sendFile(file, fileSize));
+  // A given count is not checked against the length of the file, but nothing
+  // can be sent from its end.
+  Expect.throws(() => socket.sendFile(file, fileSize, 1),
+      (e) => e is FileSystemException);
+  await socket.close();
+  await server.close();
+}
+
+main() async {
+  asyncStart();
+  var tempDir = Directory.systemTemp.createTempSync('dart_send_file');
+  var contents = new Uint8List(fileSize);
+  for (int i = 0; i < fileSize; i++) {
+    contents[i] = (i * 31) & 0xff;
+  }
+  var path = '${tempDir.path}${Platform.pathSeparator}data';
+  new File(path).writeAsBytesSync(contents);
+  var file = new File(path).openSync();
+  try {
+    await testArguments(file);
+    await testSendFile(file, contents, 0, fileSize);
+    await testSendFile(file, contents, 12345, 100000);
+    file.setPositionSync(42);
+    await testSendFile(file, contents, fileSize - 10, 10);
+    await testSendPastEnd(file, contents);
+  } finally {
+    file.closeSync();
+    tempDir.deleteSync(recursive: true);
+  }
+  asyncEnd();
+}
@@ -244,6 +244,45 @@ void testZlibWithDictionary() {
   });
 }
 
+void testZLibDeflateThreads() {
+  // Several blocks of compressible data, not a multiple of the block size.
+  var data = new Uint8List(1024 * 1024 + 1234);
+  for (int i = 0; i < data.length; i++) {
+    data[i] = (i * i) % 251 & (i >> 10);
+  }
+  [true, false].forEach((gzip) {
+    [1, 6, 9].forEach((level) {
+      var encoded =
+          new ZLibEncoder(gzip: gzip, level: level, threads: 4).convert(data);
+      Expect.listEquals(data, new ZLibDecoder().convert(encoded));
+    });
+  });
+
+  // Raw output, and a zlib stream primed with a dictionary.
+  var raw = new ZLibEncoder(raw: true, threads: 3).convert(data);
+  Expect.listEquals(data, new ZLibDecoder(raw: true).convert(raw));
+  var dict = [1, 2, 3, 4, 5];
+  var encoded = new ZLibEncoder(dictionary: dict, threads: 2).convert(data);
+  Expect.listEquals(data, new ZLibDecoder(dictionary: dict).convert(encoded));
+
+  // Empty and small inputs, and output requested with flush.
+  Expect.listEquals([], gzip.decode(new GZipCodec(threads: 2).encode([])));
+  Expect.listEquals(
+      [1, 2, 3], gzip.decode(new GZipCodec(threads: 2).encode([1, 2, 3])));
+  var filter = new RawZLibFilter.deflateFilter(gzip: true, threads: 2);
+  var output = <int>[];
+  for (int i = 0; i < 4; i++) {
+    filter.process(data, i * 1000, (i + 1) * 1000);
+    List<int> chunk;
+    while ((chunk = filter.processed()) != null) output.addAll(chunk);
+  }
+  List<int> chunk;
+  while ((chunk = filter.processed(end: true)) != null) output.addAll(chunk);
+  Expect.listEquals(data.sublist(0, 4000), gzip.decode(output));
+
+  Expect.throwsRangeError(() => new ZLibEncoder(threads: 0));
+}
+
 var generateListTypes = [
   (list) => list,
   (list) => new Uint8List.fromList(list),
@@ -286,5 +325,6 @@ void main() {
   testZlibInflateThrowsWithSmallerWindow();
   testZlibInflateWithLargerWindow();
   testZlibWithDictionary();
+  testZLibDeflateThreads();
   asyncEnd();
 }
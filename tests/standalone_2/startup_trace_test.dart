@@ -0,0 +1,66 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// This test runs itself in a second vm process with --startup-trace and
+// checks that the trace file is valid trace event JSON that includes the
+// startup phases of the embedder.
+
+import "dart:convert";
+import "dart:io";
+
+import "package:expect/expect.dart";
+
+// Phases timed by the embedder before the VM is initialized.
+const embedderPhases = const [
+  "ParseArguments",
+  "LoadAppSnapshot",
+  "Dart_Initialize",
+];
+
+void checkTrace(String path) {
+  var trace = json.decode(new File(path).readAsStringSync());
+  Expect.isTrue(trace is List, "$trace");
+  Expect.isTrue(trace.isNotEmpty);
+  for (var event in trace) {
+    Expect.isTrue(event is Map, "$event");
+    Expect.isTrue(event["name"] is String, "$event");
+    Expect.isTrue(event["ph"] is String, "$event");
+  }
+  for (var phase in embedderPhases) {
+    var event = trace.firstWhere((event) => event["name"] == phase,
+        orElse: () => Expect.fail("No $phase event in $path"));
+    Expect.equals("X", event["ph"], "$event");
+    Expect.isTrue(event["ts"] is int, "$event");
+    Expect.isTrue(event["dur"] is int && event["dur"] >= 0, "$event");
+  }
+}
+
+void runChild(Directory tempDir, String mode) {
+  var path = "${tempDir.path}/trace_$mode.json";
+  var arguments = <String>[]
+    ..addAll(Platform.executableArguments)
+    ..add("--startup-trace=$path")
+    ..add(Platform.script.toFilePath())
+    ..add(mode);
+  var result = Process.runSync(Platform.executable, arguments);
+  Expect.equals(0, result.exitCode,
+      "stdout:\n${result.stdout}\nstderr:\n${result.stderr}");
+  checkTrace(path);
+}
+
+void main(List<String> args) {
+  if (args.isNotEmpty) {
+    // Calling exit skips Dart_Cleanup, so the trace is then written by the
+    // exit hook.
+    if (args[0] == "exit") exit(0);
+    return;
+  }
+  var tempDir = Directory.systemTemp.createTempSync("startup_trace_test");
+  try {
+    runChild(tempDir, "return");
+    runChild(tempDir, "exit");
+  } finally {
+    tempDir.deleteSync(recursive: true);
+  }
+}